@@ -247,6 +247,28 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid);
  */
 int msg_send_to_self(msg_t *m);
 
+/**
+ * @brief Send multiple messages to a thread (non-blocking).
+ *
+ * Delivers the messages in @p m in order. If the target is waiting in
+ * msg_receive(), the first message is handed over directly, the others are
+ * put into the target's message queue. All messages are handled with
+ * interrupts disabled once and at most one context switch, which is cheaper
+ * than calling msg_try_send() @p num times.
+ *
+ * This function never blocks and can be called from an ISR.
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] num           Number of messages in @p m
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return number of messages delivered, less than @p num if the target's
+ *         message queue is full
+ * @return -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 /**
  * Value of msg_t::sender_pid if the sender was an interrupt service routine.
  */
@@ -309,6 +331,21 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive multiple messages.
+ *
+ * This function blocks until at least one message was received. It then
+ * takes as many messages as are available, up to @p num, from the message
+ * queue and from threads waiting to send, with interrupts disabled once.
+ *
+ * @param[out] m    Array of @p num preallocated ``msg_t`` structures, must
+ *                  not be NULL.
+ * @param[in] num   Number of messages that fit into @p m, must be > 0
+ *
+ * @return  number of messages received, at least 1
+ */
+int msg_receive_bulk(msg_t *m, unsigned num);
+
 /**
  * @brief Send a message, block until reply received.
  *
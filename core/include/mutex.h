@@ -11,6 +11,28 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * Priority inheritance
+ * ====================
+ *
+ * With the `core_mutex_priority_inheritance` module, a thread blocking on a
+ * mutex lends its priority to the owner of the mutex for as long as the
+ * owner holds it. If the owner is itself blocked on a mutex, the owner of
+ * that mutex is boosted as well, and so on. This bounds the time a high
+ * priority thread waits for a mutex to the time the mutex is held, instead
+ * of also including the time any medium priority thread runs.
+ *
+ * Each thread keeps its base priority and the list of mutexes it holds.
+ * Whenever a mutex is unlocked or a waiter gives up waiting (e.g. in
+ * xtimer_mutex_lock_timeout()), the owner's priority is recalculated as the
+ * highest of its base priority and the priorities of the first waiters of
+ * all mutexes it still holds, so nested mutexes may be unlocked in any order.
+ * When a mutex is unlocked from an ISR or by a thread other than its owner
+ * (i.e. it is used as a signal, as in xtimer_usleep()), the woken waiter gets
+ * the mutex without becoming its owner, so nothing is inherited through it.
+ * The module applies to all mutexes, including @ref rmutex_t and the pthread
+ * mutexes built on top of them.
+ *
  * @{
  *
  * @file
@@ -23,8 +45,10 @@
 #define MUTEX_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "list.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -40,18 +64,38 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(DOXYGEN) || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+    /**
+     * @brief   The current owner of the mutex, or `KERNEL_PID_UNDEF`
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Entry in the list of mutexes held by the owner
+     * @internal
+     */
+    list_node_t held;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +116,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->held.next = NULL;
+#endif
 }
 
 /**
@@ -89,6 +137,25 @@ static inline void mutex_init(mutex_t *mutex)
  */
 int _mutex_lock(mutex_t *mutex, int blocking);
 
+struct _thread;
+
+/**
+ * @brief   Removes a thread from the wait queue of a mutex without handing
+ *          the mutex over to it
+ *
+ * @details Used to implement mutex locking with timeout. The caller is
+ *          responsible for making the thread runnable again. With
+ *          `core_mutex_priority_inheritance`, the priority the owner
+ *          inherited from @p thread is given up.
+ *
+ * @param[in] mutex     Mutex @p thread is waiting for.
+ * @param[in] thread    The waiting thread.
+ *
+ * @return 1 if @p thread was waiting for @p mutex
+ * @return 0 otherwise
+ */
+int _mutex_remove_waiter(mutex_t *mutex, struct _thread *thread);
+
 /**
  * @brief Tries to get a mutex, non-blocking.
  *
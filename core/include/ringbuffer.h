@@ -18,7 +18,7 @@
  *
  * @details The ringbuffer is useful for buffering data in the same
  * thread context but it is not thread-safe.  For a thread-safe ring
- * buffer, see @ref sys_tsrb in the System library.
+ * buffer, see @ref sys_tsrb or @ref sys_lfrb in the System library.
  * @}
  */
 
@@ -119,6 +119,19 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief       Change the priority of a thread
+ *
+ * If the thread is on a runqueue, it is moved to the tail of the runqueue of
+ * its new priority. This function does not yield, the caller has to call
+ * sched_switch() or thread_yield_higher() if the change requires a context
+ * switch.
+ *
+ * @param[in]   thread      The thread to change the priority of
+ * @param[in]   priority    The new priority
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -133,6 +146,16 @@ void sched_set_status(thread_t *process, unsigned int status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Check whether yielding would keep the active thread running
+ *
+ * This is the case if the active thread is the only runnable thread of the
+ * highest runnable priority. Must be called with interrupts disabled.
+ *
+ * @return  1 if a context switch can be skipped, 0 otherwise
+ */
+int sched_yield_is_noop(void);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -169,6 +192,19 @@ extern volatile kernel_pid_t sched_active_pid;
  */
 extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 
+/**
+ * @brief   Advance a runqueue by one thread (round-robin)
+ *
+ * The thread at the head of the runqueue is moved to its tail. Must be called
+ * with interrupts disabled.
+ *
+ * @param[in]   prio    The priority of the runqueue to advance
+ */
+static inline void sched_runq_advance(uint8_t prio)
+{
+    clist_lpoprpush(&sched_runqueues[prio]);
+}
+
 /**
  * @brief  Removes thread from scheduler and set status to #STATUS_STOPPED
  */
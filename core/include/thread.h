@@ -121,6 +121,7 @@
 
 #include "clist.h"
 #include "cib.h"
+#include "list.h"
 #include "msg.h"
 #include "cpu_conf.h"
 #include "sched.h"
@@ -188,9 +189,14 @@ struct _thread {
     clist_node_t rq_entry;          /**< run queue entry                */
 
 #if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) \
-    || defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
-    void *wait_data;                /**< used by msg, mbox and thread
-                                         flags                          */
+    || defined(MODULE_CORE_MBOX) \
+    || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    void *wait_data;                /**< used by msg, mbox, thread flags
+                                         and mutex priority inheritance */
+#endif
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inherited ones */
+    list_node_t mutexes_held;       /**< mutexes owned by this thread   */
 #endif
 #if defined(MODULE_CORE_MSG) || defined(DOXYGEN)
     list_node_t msg_waiters;        /**< threads waiting for their message
@@ -202,9 +208,14 @@ struct _thread {
                                          to this thread's message queue */
 #endif
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
-    || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
+    || defined(MODULE_MPU_STACK_GUARD) \
+    || defined(MODULE_CORE_STACK_WATERMARK) || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
 #endif
+#if defined(MODULE_CORE_STACK_WATERMARK) || defined(DOXYGEN)
+    char *sp_min;                   /**< lowest stack pointer the thread
+                                         was resumed with               */
+#endif
 #if defined(DEVELHELP) || defined(DOXYGEN)
     const char *name;               /**< thread's name                  */
     int stack_size;                 /**< thread's stack size            */
@@ -346,6 +357,24 @@ struct _thread {
 #define THREAD_CREATE_STACKTEST         (8)
 /** @} */
 
+/**
+ * @brief   Paint the stacks of threads created with @ref THREAD_CREATE_STACKTEST
+ *
+ * Painting is what thread_measure_stack_free() relies on, but it writes the
+ * whole stack on thread creation. Set this to 0 to turn it off entirely and
+ * use the stack watermarks of the `core_stack_watermark` module instead. The
+ * stack guard checked with `SCHED_TEST_STACK` is written either way.
+ */
+#ifndef THREAD_STACK_PAINTING
+#define THREAD_STACK_PAINTING           (1)
+#endif
+
+/**
+ * @brief   Returned by thread_measure_stack_free(), if the free stack space
+ *          can't be measured
+ */
+#define THREAD_STACK_FREE_UNKNOWN       (UINTPTR_MAX)
+
 /**
  * @brief Creates a new thread.
  *
@@ -498,10 +527,53 @@ const char *thread_getname(kernel_pid_t pid);
  * @param[in] stack the stack you want to measure. try `sched_active_thread->stack_start`
  *
  * @return          the amount of unused space of the thread's stack
+ * @return          @ref THREAD_STACK_FREE_UNKNOWN, if stacks are not painted
+ *                  (@ref THREAD_STACK_PAINTING is 0)
  */
 uintptr_t thread_measure_stack_free(char *stack);
 #endif /* DEVELHELP */
 
+#if defined(HAVE_THREAD_SAVED_SP) || defined(DOXYGEN)
+/**
+ * @brief   Get the stack pointer a suspended thread will resume with
+ *
+ * CPUs where thread_t::sp does not point to the lowest used address of the
+ * stack define `HAVE_THREAD_SAVED_SP` and implement this function.
+ *
+ * @param[in] thread    a thread that is not running
+ *
+ * @return  the saved stack pointer of @p thread
+ */
+char *thread_saved_sp(const thread_t *thread);
+#else
+static inline char *thread_saved_sp(const thread_t *thread)
+{
+    return thread->sp;
+}
+#endif
+
+#if defined(MODULE_CORE_STACK_WATERMARK) || defined(DOXYGEN)
+/**
+ * @brief   Get the stack space a thread has never used, according to its
+ *          stack watermark
+ *
+ * The scheduler records the lowest stack pointer each thread is resumed with,
+ * which costs a compare per context switch instead of painting and scanning
+ * the stack. As only the stack depths at which a thread was suspended are
+ * seen, deeper excursions in between are missed, so the value returned is an
+ * upper bound of the free space. The watermark of the running thread is
+ * updated only when it is resumed the next time.
+ *
+ * @param[in] thread    the thread to get the free stack space of
+ *
+ * @return  number of bytes below the lowest recorded stack pointer
+ */
+static inline uintptr_t thread_stack_watermark_free(const thread_t *thread)
+{
+    return (uintptr_t)thread->sp_min - (uintptr_t)thread->stack_start;
+}
+#endif
+
 /**
  * @brief   Get the number of bytes used on the ISR stack
  */
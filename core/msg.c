@@ -32,6 +32,9 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#ifdef MODULE_KTRACE
+#include "ktrace.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -39,6 +42,25 @@
 static int _msg_receive(msg_t *m, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
+static inline void _trace_send(const msg_t *m, kernel_pid_t target_pid)
+{
+#ifdef MODULE_KTRACE
+    ktrace_record(KTRACE_MSG_SEND, target_pid, m->type);
+#else
+    (void)m;
+    (void)target_pid;
+#endif
+}
+
+static inline void _trace_recv(const msg_t *m)
+{
+#ifdef MODULE_KTRACE
+    ktrace_record(KTRACE_MSG_RECV, m->sender_pid, m->type);
+#else
+    (void)m;
+#endif
+}
+
 static int queue_msg(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
@@ -99,6 +121,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
 
     thread_t *me = (thread_t *) sched_active_thread;
 
+    _trace_send(m, target_pid);
+
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
           ". block=%i src->state=%i target->state=%i\n", RIOT_FILE_RELATIVE,
           __LINE__, sched_active_pid, target_pid,
@@ -182,6 +206,70 @@ int msg_send_to_self(msg_t *m)
     return res;
 }
 
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    int was_blocked = (target->status < STATUS_ON_RUNQUEUE);
+    unsigned n = 0;
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_bulk: Direct msg copy to %" PRIkernel_pid ".\n",
+              target_pid);
+        m[0].sender_pid = sender_pid;
+        *((msg_t *) target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        n++;
+    }
+
+    for (; n < num; n++) {
+        m[n].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[n])) {
+            break;
+        }
+    }
+
+    for (unsigned i = 0; i < n; i++) {
+        _trace_send(&m[i], target_pid);
+    }
+
+    DEBUG("msg_send_bulk: %u of %u messages sent to %" PRIkernel_pid ".\n",
+          n, num, target_pid);
+
+    /* a single scheduling decision for all messages */
+    if (was_blocked && (target->status >= STATUS_ON_RUNQUEUE)) {
+        uint16_t target_prio = target->priority;
+
+        if (irq_is_in()) {
+            sched_context_switch_request = 1;
+            irq_restore(state);
+        }
+        else {
+            irq_restore(state);
+            sched_switch(target_prio);
+        }
+    }
+    else {
+        irq_restore(state);
+    }
+
+    return n;
+}
+
 int msg_send_int(msg_t *m, kernel_pid_t target_pid)
 {
 #ifdef DEVELHELP
@@ -198,6 +286,7 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
+    _trace_send(m, target_pid);
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
@@ -248,6 +337,7 @@ int msg_reply(msg_t *m, msg_t *reply)
 
     DEBUG("msg_reply(): %" PRIkernel_pid ": Direct msg copy.\n",
           sched_active_thread->pid);
+    _trace_send(reply, target->pid);
     /* copy msg to target */
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
@@ -269,6 +359,7 @@ int msg_reply_int(msg_t *m, msg_t *reply)
         return -1;
     }
 
+    _trace_send(reply, target->pid);
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
     sched_set_status(target, STATUS_PENDING);
@@ -286,6 +377,63 @@ int msg_receive(msg_t *m)
     return _msg_receive(m, 1);
 }
 
+int msg_receive_bulk(msg_t *m, unsigned num)
+{
+    assert(num > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t *) sched_active_thread;
+    uint16_t wake_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    while (n < num) {
+        int queue_index = -1;
+
+        /* queued messages are older than those of waiting senders */
+        if (me->msg_array) {
+            queue_index = cib_get(&(me->msg_queue));
+        }
+
+        if (queue_index >= 0) {
+            m[n] = me->msg_array[queue_index];
+            _trace_recv(&m[n++]);
+            continue;
+        }
+
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+
+        if (next == NULL) {
+            break;
+        }
+
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        m[n] = *((msg_t *) sender->wait_data);
+        _trace_recv(&m[n++]);
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < wake_prio) {
+                wake_prio = sender->priority;
+            }
+        }
+    }
+
+    irq_restore(state);
+
+    if (n == 0) {
+        DEBUG("msg_receive_bulk: %" PRIkernel_pid ": nothing available, "
+              "blocking.\n", me->pid);
+        return _msg_receive(m, 1);
+    }
+
+    if (wake_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(wake_prio);
+    }
+
+    return n;
+}
+
 static int _msg_receive(msg_t *m, int block)
 {
     unsigned state = irq_disable();
@@ -335,6 +483,7 @@ static int _msg_receive(msg_t *m, int block)
             irq_restore(state);
         }
 
+        _trace_recv(m);
         return 1;
     }
     else {
@@ -343,6 +492,9 @@ static int _msg_receive(msg_t *m, int block)
 
         thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
 
+        /* the caller gets the queued message if there was one */
+        _trace_recv((queue_index >= 0) ? m : (msg_t *) sender->wait_data);
+
         if (queue_index >= 0) {
             /* We've already got a message from the queue. As there is a
              * waiter, take it's message into the just freed queue space.
@@ -28,10 +28,100 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#ifdef MODULE_KTRACE
+#include "ktrace.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    mutex->owner = owner->pid;
+    list_add(&owner->mutexes_held, &mutex->held);
+}
+
+static thread_t *_clear_owner(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    if (owner != NULL) {
+        list_remove(&owner->mutexes_held, &mutex->held);
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+
+    return owner;
+}
+
+/* Ownership is only passed on to a waiter if the owner itself unlocks the
+ * mutex. A mutex unlocked from an ISR or by another thread is used as a signal
+ * (e.g. by xtimer_usleep()) and may live on the stack of the woken thread,
+ * which never unlocks it. */
+static inline int _hands_off(thread_t *owner)
+{
+    return (owner == sched_active_thread) && !irq_is_in();
+}
+
+/* the highest of the base priority and the priorities of the first waiters
+ * (the wait queues are sorted) of all mutexes the thread holds */
+static uint8_t _inherited_priority(thread_t *thread)
+{
+    uint8_t priority = thread->base_priority;
+
+    for (list_node_t *node = thread->mutexes_held.next; node != NULL;
+         node = node->next) {
+        mutex_t *mutex = container_of(node, mutex_t, held);
+        list_node_t *head = mutex->queue.next;
+
+        if ((head != NULL) && (head != MUTEX_LOCKED)) {
+            thread_t *waiter = container_of((clist_node_t *)head, thread_t,
+                                            rq_entry);
+            /* a thread may wait for a mutex it holds itself (e.g. in
+             * xtimer_usleep()) */
+            if ((waiter != thread) && (waiter->priority < priority)) {
+                priority = waiter->priority;
+            }
+        }
+    }
+
+    return priority;
+}
+
+/* Recalculates the priority of the thread. If it changed and the thread is
+ * itself blocked on a mutex, the owner of that mutex is updated as well, and
+ * so on. Returns 1 if the priority of the thread changed. */
+static int _update_priority(thread_t *thread)
+{
+    int changed = 0;
+
+    while (thread != NULL) {
+        uint8_t priority = _inherited_priority(thread);
+
+        if (priority == thread->priority) {
+            break;
+        }
+        DEBUG("PID[%" PRIkernel_pid "]: prio of %" PRIkernel_pid " -> %"
+              PRIu8 "\n", sched_active_pid, thread->pid, priority);
+        sched_change_priority(thread, priority);
+        changed = 1;
+
+        if (thread->status != STATUS_MUTEX_BLOCKED) {
+            break;
+        }
+
+        /* keep the wait queue the thread is on sorted by priority */
+        mutex_t *mutex = thread->wait_data;
+        list_remove(&mutex->queue, (list_node_t *)&thread->rq_entry);
+        thread_add_to_list(&mutex->queue, thread);
+
+        thread = (thread_t *)thread_get(mutex->owner);
+    }
+
+    return changed;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +131,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _set_owner(mutex, (thread_t *)sched_active_thread);
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -50,6 +143,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         thread_t *me = (thread_t*)sched_active_thread;
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
+#ifdef MODULE_KTRACE
+        ktrace_record(KTRACE_MUTEX_BLOCK, 0, (uint32_t)(uintptr_t)mutex);
+#endif
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t*)&me->rq_entry;
@@ -58,6 +154,10 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        me->wait_data = mutex;
+        _update_priority((thread_t *)thread_get(mutex->owner));
+#endif
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -83,10 +183,22 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    thread_t *owner = _clear_owner(mutex);
+#endif
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        int restored = _update_priority(owner);
         irq_restore(irqstate);
+        if (restored) {
+            thread_yield_higher();
+        }
+#else
+        irq_restore(irqstate);
+#endif
         return;
     }
 
@@ -96,12 +208,30 @@ void mutex_unlock(mutex_t *mutex)
 
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
+#ifdef MODULE_KTRACE
+    ktrace_record(KTRACE_MUTEX_UNBLOCK, process->pid,
+                  (uint32_t)(uintptr_t)mutex);
+#endif
     sched_set_status(process, STATUS_PENDING);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    /* the new owner inherits from the remaining waiters, the old one loses
+     * what it inherited from them */
+    if (_hands_off(owner)) {
+        _set_owner(mutex, process);
+        _update_priority(process);
+    }
+    if (_update_priority(owner)) {
+        irq_restore(irqstate);
+        thread_yield_higher();
+        return;
+    }
+#endif
+
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
     sched_switch(process_priority);
@@ -114,6 +244,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        thread_t *owner = _clear_owner(mutex);
+#endif
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -122,11 +255,24 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             thread_t *process = container_of((clist_node_t*)next, thread_t,
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
+#ifdef MODULE_KTRACE
+            ktrace_record(KTRACE_MUTEX_UNBLOCK, process->pid,
+                          (uint32_t)(uintptr_t)mutex);
+#endif
             sched_set_status(process, STATUS_PENDING);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+            if (_hands_off(owner)) {
+                _set_owner(mutex, process);
+                _update_priority(process);
+            }
+#endif
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _update_priority(owner);
+#endif
     }
 
     DEBUG("PID[%" PRIkernel_pid "]: going to sleep.\n", sched_active_pid);
@@ -134,3 +280,25 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     irq_restore(irqstate);
     thread_yield_higher();
 }
+
+int _mutex_remove_waiter(mutex_t *mutex, thread_t *thread)
+{
+    unsigned irqstate = irq_disable();
+    list_node_t *node = NULL;
+
+    if (mutex->queue.next != MUTEX_LOCKED) {
+        node = list_remove(&mutex->queue, (list_node_t *)&thread->rq_entry);
+    }
+    if ((node != NULL) && (mutex->queue.next == NULL)) {
+        mutex->queue.next = MUTEX_LOCKED;
+    }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    if (node != NULL) {
+        /* the owner may have inherited the priority of the thread */
+        _update_priority((thread_t *)thread_get(mutex->owner));
+    }
+#endif
+    irq_restore(irqstate);
+
+    return (node != NULL);
+}
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -37,6 +38,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_KTRACE
+#include "ktrace.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -132,6 +137,17 @@ int __attribute__((used)) sched_run(void)
     }
 #endif
 
+#ifdef MODULE_KTRACE
+    ktrace_record(KTRACE_SWITCH, next_thread->pid, 0);
+#endif
+
+#ifdef MODULE_CORE_STACK_WATERMARK
+    char *next_sp = thread_saved_sp(next_thread);
+    if (next_sp < next_thread->sp_min) {
+        next_thread->sp_min = next_sp;
+    }
+#endif
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
@@ -158,31 +174,85 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 }
 #endif
 
+static void _runqueue_push(thread_t *thread)
+{
+    DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu8 ".\n",
+          thread->pid, thread->priority);
+    clist_rpush(&sched_runqueues[thread->priority], &(thread->rq_entry));
+    runqueue_bitcache |= 1 << thread->priority;
+}
+
+static void _runqueue_pop(thread_t *thread)
+{
+    DEBUG("sched_set_status: removing thread %" PRIkernel_pid " to runqueue %" PRIu8 ".\n",
+          thread->pid, thread->priority);
+    clist_node_t *runqueue = &sched_runqueues[thread->priority];
+
+    /* usually, the active thread (which is the runqueue's head)
+     * leaves the runqueue, anything else needs a list walk */
+    if (clist_lpeek(runqueue) == &thread->rq_entry) {
+        clist_lpop(runqueue);
+    }
+    else {
+        clist_remove(runqueue, &thread->rq_entry);
+    }
+
+    if (!sched_runqueues[thread->priority].next) {
+        runqueue_bitcache &= ~(1 << thread->priority);
+    }
+}
+
 void sched_set_status(thread_t *process, unsigned int status)
 {
     if (status >= STATUS_ON_RUNQUEUE) {
         if (!(process->status >= STATUS_ON_RUNQUEUE)) {
-            DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu8 ".\n",
-                  process->pid, process->priority);
-            clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
-            runqueue_bitcache |= 1 << process->priority;
+            _runqueue_push(process);
         }
     }
     else {
         if (process->status >= STATUS_ON_RUNQUEUE) {
-            DEBUG("sched_set_status: removing thread %" PRIkernel_pid " to runqueue %" PRIu8 ".\n",
-                  process->pid, process->priority);
-            clist_lpop(&sched_runqueues[process->priority]);
-
-            if (!sched_runqueues[process->priority].next) {
-                runqueue_bitcache &= ~(1 << process->priority);
-            }
+            _runqueue_pop(process);
         }
     }
 
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(priority < SCHED_PRIO_LEVELS);
+
+    unsigned state = irq_disable();
+
+    if (thread->priority != priority) {
+        DEBUG("sched_change_priority: %" PRIkernel_pid ": %" PRIu8 " -> %" PRIu8
+              "\n", thread->pid, thread->priority, priority);
+        if (thread->status >= STATUS_ON_RUNQUEUE) {
+            _runqueue_pop(thread);
+            thread->priority = priority;
+            _runqueue_push(thread);
+        }
+        else {
+            thread->priority = priority;
+        }
+    }
+
+    irq_restore(state);
+}
+
+int sched_yield_is_noop(void)
+{
+    thread_t *active_thread = (thread_t *)sched_active_thread;
+    uint8_t prio = active_thread->priority;
+
+    /* nothing changes if no thread of higher priority is runnable and the
+     * active thread is the only one on its runqueue */
+    return (active_thread->status == STATUS_RUNNING) &&
+           !(runqueue_bitcache & ((1 << prio) - 1)) &&
+           (sched_runqueues[prio].next == &active_thread->rq_entry) &&
+           (active_thread->rq_entry.next == &active_thread->rq_entry);
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
@@ -100,8 +100,13 @@ void thread_yield(void)
 {
     unsigned old_state = irq_disable();
     thread_t *me = (thread_t *)sched_active_thread;
+    if (sched_yield_is_noop()) {
+        /* no other thread could be scheduled, skip the context switch */
+        irq_restore(old_state);
+        return;
+    }
     if (me->status >= STATUS_ON_RUNQUEUE) {
-        clist_lpoprpush(&sched_runqueues[me->priority]);
+        sched_runq_advance(me->priority);
     }
     irq_restore(old_state);
 
@@ -132,6 +137,11 @@ uintptr_t thread_measure_stack_free(char *stack)
 {
     uintptr_t *stackp = (uintptr_t *)stack;
 
+    if (!THREAD_STACK_PAINTING) {
+        /* nothing to scan for */
+        return THREAD_STACK_FREE_UNKNOWN;
+    }
+
     /* assume that the comparison fails before or after end of stack */
     /* assume that the stack grows "downwards" */
     while (*stackp == (uintptr_t) stackp) {
@@ -176,7 +186,7 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     thread_t *cb = (thread_t *) (stack + stacksize);
 
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK)
-    if (flags & THREAD_CREATE_STACKTEST) {
+    if (THREAD_STACK_PAINTING && (flags & THREAD_CREATE_STACKTEST)) {
         /* assign each int of the stack the value of it's address */
         uintptr_t *stackmax = (uintptr_t *) (stack + stacksize);
         uintptr_t *stackp = (uintptr_t *) stack;
@@ -214,10 +224,15 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->pid = pid;
     cb->sp = thread_stack_init(function, arg, stack, stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_CORE_STACK_WATERMARK)
     cb->stack_start = stack;
 #endif
 
+#ifdef MODULE_CORE_STACK_WATERMARK
+    cb->sp_min = thread_saved_sp(cb);
+#endif
+
 #ifdef DEVELHELP
     cb->stack_size = total_stacksize;
     cb->name = name;
@@ -225,6 +240,10 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
 
     cb->priority = priority;
     cb->status = 0;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    cb->base_priority = priority;
+    cb->mutexes_held.next = NULL;
+#endif
 
     cb->rq_entry.next = NULL;
 
@@ -22,6 +22,9 @@
 #include "thread_flags.h"
 #include "irq.h"
 #include "thread.h"
+#ifdef MODULE_KTRACE
+#include "ktrace.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -124,6 +127,9 @@ void thread_flags_set(thread_t *thread, thread_flags_t mask)
 {
     DEBUG("thread_flags_set(): setting 0x%08x for pid %"PRIkernel_pid"\n", mask, thread->pid);
     unsigned state = irq_disable();
+#ifdef MODULE_KTRACE
+    ktrace_record(KTRACE_FLAGS_SET, thread->pid, mask);
+#endif
     thread->flags |= mask;
     if (thread_flags_wake(thread)) {
         irq_restore(state);
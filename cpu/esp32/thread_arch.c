@@ -304,8 +304,12 @@ void thread_isr_stack_init(void)
 
 int thread_isr_stack_usage(void)
 {
-    return &port_IntStackTop - &port_IntStack -
-           thread_measure_stack_free((char*)&port_IntStack);
+    uintptr_t stackfree = thread_measure_stack_free((char*)&port_IntStack);
+
+    if (stackfree == THREAD_STACK_FREE_UNKNOWN) {
+        return -1;
+    }
+    return &port_IntStackTop - &port_IntStack - stackfree;
 }
 
 void *thread_isr_stack_pointer(void)
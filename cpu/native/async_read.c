@@ -62,6 +62,27 @@ static void _async_io_isr(void) {
     }
 }
 
+int native_async_read_wait(uint32_t timeout_us) {
+    fd_set rfds;
+    int max_fd = -1;
+    struct timeval timeout = { .tv_sec = timeout_us / 1000000U,
+                               .tv_usec = timeout_us % 1000000U };
+
+    FD_ZERO(&rfds);
+    for (int i = 0; i < _next_index; i++) {
+        FD_SET(_fds[i], &rfds);
+
+        if (max_fd < _fds[i]) {
+            max_fd = _fds[i];
+        }
+    }
+
+    if (max_fd < 0) {
+        return 0;
+    }
+    return real_select(max_fd + 1, &rfds, NULL, NULL, &timeout) > 0;
+}
+
 void native_async_read_setup(void) {
     register_interrupt(SIGIO, _async_io_isr);
 }
@@ -18,6 +18,8 @@
 #ifndef ASYNC_READ_H
 #define ASYNC_READ_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -57,6 +59,16 @@ void native_async_read_cleanup(void);
  */
 void native_async_read_continue(int fd);
 
+/**
+ * @brief   wait for one of the monitored file descriptors to become readable
+ *
+ * @param[in] timeout_us  Maximum time to wait in microseconds, 0 to only poll
+ *
+ * @return  1 if a monitored file descriptor is readable
+ * @return  0 otherwise
+ */
+int native_async_read_wait(uint32_t timeout_us);
+
 /**
  * @brief   start monitoring of file descriptor
  *
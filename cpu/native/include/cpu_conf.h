@@ -50,6 +50,12 @@ extern "C" {
 #endif /* OS */
 /** @} */
 
+/**
+ * @brief   thread_t::sp points to the thread's ucontext_t, the stack pointer
+ *          is saved in there
+ */
+#define HAVE_THREAD_SAVED_SP
+
 /**
  * @brief   Native internal Ethernet protocol number
  */
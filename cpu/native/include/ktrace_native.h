@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ktrace
+ * @{
+ *
+ * @file
+ * @brief       Host file sink for kernel event traces (only under native)
+ */
+#ifndef KTRACE_NATIVE_H
+#define KTRACE_NATIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Write the trace buffer in the binary format to a file on the host
+ *
+ * @param[in] path  path of the file, it is created or truncated
+ *
+ * @return  0 on success
+ * @return  -1 if the file could not be opened or written
+ */
+int ktrace_native_save(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KTRACE_NATIVE_H */
+/** @} */
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Fast user space context switching for native
+ *
+ * With the `native_fast_ctx` module, native switches between ucontexts
+ * without glibc's swapcontext()/setcontext(). Those save and restore the
+ * signal mask, which costs a system call on every context switch. The
+ * replacement in ctx_switch.S only saves the callee-saved registers and the
+ * stack and instruction pointers into the glibc ucontext_t layout, so
+ * contexts stay compatible with getcontext()/makecontext().
+ *
+ * As the signal mask is not switched, this requires `native_lazy_irq`,
+ * which keeps the process signal mask constant.
+ */
+
+#ifndef NATIVE_CTX_H
+#define NATIVE_CTX_H
+
+#if !defined(__linux__) || !defined(__i386__)
+#error "native_fast_ctx is only available on Linux/i386"
+#endif
+
+/**
+ * @name    Offsets of the saved registers in glibc's i386 ucontext_t
+ * @{
+ */
+#define NATIVE_CTX_EDI_OFFSET   36
+#define NATIVE_CTX_ESI_OFFSET   40
+#define NATIVE_CTX_EBP_OFFSET   44
+#define NATIVE_CTX_ESP_OFFSET   48
+#define NATIVE_CTX_EBX_OFFSET   52
+#define NATIVE_CTX_EIP_OFFSET   76
+/** @} */
+
+#ifndef __ASSEMBLER__
+
+#include <ucontext.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Save the current context to @p oucp and activate @p ucp
+ *
+ * @param[out] oucp context to save the current state to
+ * @param[in]  ucp  context to switch to
+ *
+ * @return  0 when @p oucp is resumed
+ */
+int _native_ctx_swap(ucontext_t *oucp, const ucontext_t *ucp);
+
+/**
+ * @brief   Activate @p ucp
+ *
+ * @param[in]  ucp  context to switch to
+ *
+ * @return  does not return
+ */
+int _native_ctx_set(const ucontext_t *ucp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* NATIVE_CTX_H */
+/** @} */
@@ -68,6 +68,10 @@ void native_cpu_init(void);
 void native_interrupt_init(void);
 
 void native_irq_handler(void);
+void native_irq_handle_pending(void);
+#ifdef MODULE_NATIVE_LAZY_IRQ
+void native_thread_sigmask(ucontext_t *ctx);
+#endif
 extern void _native_sig_leave_tramp(void);
 extern void _native_sig_leave_handler(void);
 
@@ -75,6 +79,55 @@ void _native_syscall_leave(void);
 void _native_syscall_enter(void);
 void _native_init_syscalls(void);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/**
+ * virtual time in microseconds since start-up
+ */
+uint64_t native_vtime_now(void);
+/**
+ * advance virtual time to the next timer deadline, called when all threads
+ * are idle with all signals blocked. @p mask is the signal mask to wait with.
+ * Returns -1 if there is no deadline to advance to.
+ */
+int native_vtime_idle(const sigset_t *mask);
+/**
+ * advance virtual time in lock-step with the ZEP hub at @p addr, @p port
+ * instead of independently. @p zep_port is the local port of the node's
+ * socket_zep, which identifies the node at the hub.
+ */
+void native_vtime_sync_setup(const char *addr, const char *port,
+                             uint16_t zep_port);
+/**
+ * count a frame sent to the ZEP hub
+ */
+void native_vtime_frame_sent(void);
+/**
+ * count a frame received from the ZEP hub
+ */
+void native_vtime_frame_received(void);
+/**
+ * mark the start of a host call that may block
+ */
+void native_vtime_block_enter(void);
+/**
+ * mark the end of a host call that may block. If it blocked for at least
+ * NATIVE_VTIME_BLOCK_MIN, virtual time advances by the real time it took.
+ */
+void native_vtime_block_leave(void);
+#endif
+
+/**
+ * context switching backend
+ */
+#ifdef MODULE_NATIVE_FAST_CTX
+#include "native_ctx.h"
+#define _native_swapcontext _native_ctx_swap
+#define _native_setcontext  _native_ctx_set
+#else
+#define _native_swapcontext swapcontext
+#define _native_setcontext  setcontext
+#endif
+
 /**
  * external functions regularly wrapped in native for direct use
  */
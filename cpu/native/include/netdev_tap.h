@@ -44,6 +44,11 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    /**
+     * @brief   result of the last read from the TAP during an interrupt,
+     *          -EAGAIN once no frame is pending anymore
+     */
+    int rx_res;
 } netdev_tap_t;
 
 /**
@@ -27,6 +27,42 @@
 #define NATIVE_TIMER_MIN_RES 200
 /** @} */
 
+/**
+ * @name    Virtual time configuration (module `native_virtual_time`)
+ * @{
+ */
+/**
+ * @brief   Microseconds of virtual time passing with each timer_read()
+ *
+ * Must not be 0, or code polling the timer would never see time advance.
+ */
+#ifndef NATIVE_VTIME_READ_STEP
+#define NATIVE_VTIME_READ_STEP  (1U)
+#endif
+
+/**
+ * @brief   Microseconds of real time to wait for I/O (netdev_tap, socket_zep,
+ *          UART, ...) before jumping to the next timer deadline
+ *
+ * With the default of 0 an idle node only handles I/O that is already
+ * pending. Nodes simulated together over the network should wait a little
+ * longer for frames their peers are about to send.
+ */
+#ifndef NATIVE_VTIME_IO_WAIT
+#define NATIVE_VTIME_IO_WAIT    (0U)
+#endif
+
+/**
+ * @brief   Real time in microseconds a host call (read(), write(), ...) may
+ *          block before virtual time advances by the time it took
+ *
+ * Short calls do not affect virtual time to keep runs repeatable.
+ */
+#ifndef NATIVE_VTIME_BLOCK_MIN
+#define NATIVE_VTIME_BLOCK_MIN  (10000U)
+#endif
+/** @} */
+
 /**
  * @name Random Number Generator configuration
  * @{
@@ -40,6 +40,10 @@
 
 #include "native_internal.h"
 
+#ifdef MODULE_KTRACE
+#include "ktrace.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -143,6 +147,84 @@ void native_print_signals(void)
     }
 }
 
+#ifdef MODULE_NATIVE_LAZY_IRQ
+/**
+ * Compiler barrier, keeps memory accesses inside the critical section
+ */
+#define _native_irq_barrier()   __asm__ volatile ("" : : : "memory")
+
+/**
+ * update the signal mask of all saved thread contexts
+ *
+ * With lazy interrupt masking the process signal mask is only changed when
+ * signal handlers are (un)registered, so contexts saved before that would
+ * restore a stale mask when being switched to.
+ */
+static void _native_sync_sigmask(void)
+{
+    if (sigprocmask(SIG_SETMASK, &_native_sig_set, NULL) == -1) {
+        err(EXIT_FAILURE, "_native_sync_sigmask: sigprocmask");
+    }
+
+    for (int i = 0; i < MAXTHREADS; i++) {
+        if ((sched_threads[i] != NULL) &&
+            (sched_threads[i] != sched_active_thread)) {
+            ((ucontext_t *)sched_threads[i]->sp)->uc_sigmask = _native_sig_set;
+        }
+    }
+    native_isr_context.uc_sigmask = _native_sig_set;
+    end_context.uc_sigmask = _native_sig_set;
+}
+
+void native_thread_sigmask(ucontext_t *ctx)
+{
+    ctx->uc_sigmask = _native_sig_set;
+}
+
+/**
+ * mask interrupts without touching the process signal mask
+ *
+ * Signals arriving while masked are queued by native_isr_entry() and
+ * replayed by irq_enable().
+ */
+unsigned irq_disable(void)
+{
+    unsigned int prev_state = native_interrupts_enabled;
+
+    native_interrupts_enabled = 0;
+    _native_irq_barrier();
+
+    return prev_state;
+}
+
+/**
+ * unmask interrupts and handle signals that arrived in the meantime
+ */
+unsigned irq_enable(void)
+{
+    unsigned int prev_state;
+
+    if (_native_in_isr == 1) {
+#ifdef DEVELHELP
+        real_write(STDERR_FILENO, "irq_enable + _native_in_isr\n", 27);
+#else
+        DEBUG("irq_enable + _native_in_isr\n");
+#endif
+    }
+
+    _native_irq_barrier();
+    prev_state = native_interrupts_enabled;
+    native_interrupts_enabled = 1;
+
+    if (_native_sigpend > 0) {
+        /* _native_syscall_leave() switches to native_irq_handler() */
+        _native_syscall_enter();
+        _native_syscall_leave();
+    }
+
+    return prev_state;
+}
+#else /* MODULE_NATIVE_LAZY_IRQ */
 /**
  * block signals
  */
@@ -205,6 +287,7 @@ unsigned irq_enable(void)
 
     return prev_state;
 }
+#endif /* MODULE_NATIVE_LAZY_IRQ */
 
 void irq_restore(unsigned state)
 {
@@ -247,20 +330,23 @@ int _native_popsig(void)
 }
 
 /**
- * call signal handlers,
- * restore user context
+ * call signal handlers of all pending signals
  */
-void native_irq_handler(void)
+void native_irq_handle_pending(void)
 {
-    DEBUG("\n\n\t\tnative_irq_handler\n\n");
-
     while (_native_sigpend > 0) {
         int sig = _native_popsig();
         _native_sigpend--;
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+#ifdef MODULE_KTRACE
+            ktrace_record(KTRACE_ISR_ENTER, 0, sig);
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_KTRACE
+            ktrace_record(KTRACE_ISR_EXIT, 0, sig);
+#endif
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
@@ -269,6 +355,17 @@ void native_irq_handler(void)
             errx(EXIT_FAILURE, "XXX: no handler for signal %i\nXXX: this should not have happened!\n", sig);
         }
     }
+}
+
+/**
+ * call signal handlers,
+ * restore user context
+ */
+void native_irq_handler(void)
+{
+    DEBUG("\n\n\t\tnative_irq_handler\n\n");
+
+    native_irq_handle_pending();
 
     DEBUG("native_irq_handler: return\n");
     cpu_switch_context_exit();
@@ -276,7 +373,12 @@ void native_irq_handler(void)
 
 void isr_set_sigmask(ucontext_t *ctx)
 {
+#ifdef MODULE_NATIVE_LAZY_IRQ
+    /* signals stay deliverable, native_isr_entry() defers them */
+    ctx->uc_sigmask = _native_sig_set;
+#else
     ctx->uc_sigmask = _native_sig_set_dint;
+#endif
     native_interrupts_enabled = 0;
 }
 
@@ -380,6 +482,12 @@ void set_signal_handler(int sig, bool add)
         err(EXIT_FAILURE, "set_signal_handler: sigdelset");
     }
 
+#ifdef MODULE_NATIVE_LAZY_IRQ
+    _native_syscall_enter();
+    _native_sync_sigmask();
+    _native_syscall_leave();
+#endif
+
     memset(&sa, 0, sizeof(sa));
 
     /* Disable other signal during execution of the handler for this signal. */
@@ -541,6 +649,10 @@ void native_interrupt_init(void)
         err(EXIT_FAILURE, "native_interrupt_init: sigaction");
     }
 
+#ifdef MODULE_NATIVE_LAZY_IRQ
+    /* irq_enable() won't touch the signal mask, so apply it once here */
+    _native_sync_sigmask();
+#endif
 
     puts("RIOT native interrupts/signals initialized.");
 }
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Host file sink for kernel event traces
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+
+#include "ktrace.h"
+#include "ktrace_native.h"
+#include "native_internal.h"
+
+typedef struct {
+    int fd;
+    int res;
+} _sink_t;
+
+static void _write(const void *data, size_t len, void *arg)
+{
+    _sink_t *sink = arg;
+    const uint8_t *p = data;
+
+    while ((sink->res == 0) && (len > 0)) {
+        _native_syscall_enter();
+        ssize_t res = real_write(sink->fd, p, len);
+        _native_syscall_leave();
+        if (res <= 0) {
+            sink->res = -1;
+            break;
+        }
+        p += res;
+        len -= res;
+    }
+}
+
+int ktrace_native_save(const char *path)
+{
+    _sink_t sink = { .res = 0 };
+
+    _native_syscall_enter();
+    sink.fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    _native_syscall_leave();
+    if (sink.fd < 0) {
+        return -1;
+    }
+
+    ktrace_export(_write, &sink);
+
+    _native_syscall_enter();
+    real_close(sink.fd);
+    _native_syscall_leave();
+
+    return sink.res;
+}
+
+/** @} */
@@ -65,6 +65,30 @@ extern netdev_tap_t netdev_tap;
 ucontext_t end_context;
 char __end_stack[SIGSTKSZ];
 
+#ifdef MODULE_NATIVE_FAST_CTX
+#include <stddef.h>
+
+#define CHECK_OFFSET(reg) \
+    __extension__ _Static_assert( \
+        offsetof(ucontext_t, uc_mcontext.gregs[REG_ ## reg]) == \
+        NATIVE_CTX_ ## reg ## _OFFSET, "ucontext_t offset mismatch for " #reg);
+
+static void check_native_ctx_offsets(void) __attribute__ ((unused));
+
+/**
+ * @brief   Check the register offsets used by ctx_switch.S at compile time
+ */
+static void check_native_ctx_offsets(void)
+{
+    CHECK_OFFSET(EDI);
+    CHECK_OFFSET(ESI);
+    CHECK_OFFSET(EBP);
+    CHECK_OFFSET(ESP);
+    CHECK_OFFSET(EBX);
+    CHECK_OFFSET(EIP);
+}
+#endif
+
 /**
  * make the new context assign `_native_in_isr = 0` before resuming
  */
@@ -87,6 +111,23 @@ static void _native_mod_ctx_leave_sigh(ucontext_t *ctx)
 #endif
 }
 
+char *thread_saved_sp(const thread_t *thread)
+{
+    ucontext_t *ctx = (ucontext_t *)thread->sp;
+
+#ifdef __MACH__
+    return (char *)ctx->uc_mcontext->__ss.__esp;
+#elif defined(__FreeBSD__)
+    return (char *)((struct sigcontext *)ctx)->sc_esp;
+#else /* Linux */
+#if defined(__arm__)
+    return (char *)ctx->uc_mcontext.arm_sp;
+#else /* Linux/x86 */
+    return (char *)ctx->uc_mcontext.gregs[REG_ESP];
+#endif
+#endif
+}
+
 /**
  * TODO: implement
  */
@@ -128,9 +169,14 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
     p->uc_stack.ss_flags = 0;
     p->uc_link = &end_context;
 
+#ifdef MODULE_NATIVE_LAZY_IRQ
+    /* the process signal mask keeps signals without handler blocked */
+    native_thread_sigmask(p);
+#else
     if (sigemptyset(&(p->uc_sigmask)) == -1) {
         err(EXIT_FAILURE, "thread_stack_init: sigemptyset");
     }
+#endif
 
     makecontext(p, (void (*)(void)) task_func, 1, arg);
 
@@ -142,6 +188,11 @@ void isr_cpu_switch_context_exit(void)
     ucontext_t *ctx;
 
     DEBUG("isr_cpu_switch_context_exit\n");
+    /* native_isr_entry() only queues signals while _native_in_isr is set, so
+     * handle the ones that arrived since the handlers were called */
+    if (sched_active_thread != NULL) {
+        native_irq_handle_pending();
+    }
     if ((sched_context_switch_request == 1) || (sched_active_thread == NULL)) {
         sched_run();
     }
@@ -152,7 +203,7 @@ void isr_cpu_switch_context_exit(void)
     native_interrupts_enabled = 1;
     _native_mod_ctx_leave_sigh(ctx);
 
-    if (setcontext(ctx) == -1) {
+    if (_native_setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_cpu_switch_context_exit: setcontext");
     }
     errx(EXIT_FAILURE, "2 this should have never been reached!!");
@@ -174,7 +225,7 @@ void cpu_switch_context_exit(void)
         native_isr_context.uc_stack.ss_size = sizeof(__isr_stack);
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, isr_cpu_switch_context_exit, 0);
-        if (setcontext(&native_isr_context) == -1) {
+        if (_native_setcontext(&native_isr_context) == -1) {
             err(EXIT_FAILURE, "cpu_switch_context_exit: setcontext");
         }
         errx(EXIT_FAILURE, "1 this should have never been reached!!");
@@ -201,7 +252,7 @@ void isr_thread_yield(void)
     native_interrupts_enabled = 1;
     _native_mod_ctx_leave_sigh(ctx);
 
-    if (setcontext(ctx) == -1) {
+    if (_native_setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_thread_yield: setcontext");
     }
 }
@@ -219,7 +270,7 @@ void thread_yield_higher(void)
         native_isr_context.uc_stack.ss_size = SIGSTKSZ;
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, isr_thread_yield, 0);
-        if (swapcontext(ctx, &native_isr_context) == -1) {
+        if (_native_swapcontext(ctx, &native_isr_context) == -1) {
             err(EXIT_FAILURE, "thread_yield_higher: swapcontext");
         }
         irq_enable();
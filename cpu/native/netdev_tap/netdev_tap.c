@@ -68,6 +68,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static void _isr(netdev_t *netdev);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -94,18 +95,6 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
-static inline void _isr(netdev_t *netdev)
-{
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-    }
-#if DEVELHELP
-    else {
-        puts("netdev_tap: _isr(): no event_callback set.");
-    }
-#endif
-}
-
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
 {
     int res = 0;
@@ -177,104 +166,118 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev_tap_t *dev)
+static bool _is_for_me(netdev_tap_t *dev, uint8_t *frame, ssize_t len)
 {
-    /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->tap_fd, &rfds);
-
-    _native_in_syscall++; /* no switching here */
-
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-        int sig = SIGIO;
-        extern int _sig_pipefd[2];
-        extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
-        real_write(_sig_pipefd[1], &sig, sizeof(int));
-        _native_sigpend++;
-        DEBUG("netdev_tap: sigpend++\n");
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)frame;
+
+    if (len < (ssize_t)sizeof(ethernet_hdr_t)) {
+        return false;
     }
-    else {
-        DEBUG("netdev_tap: native_async_read_continue\n");
-        native_async_read_continue(dev->tap_fd);
+    if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
+        !_is_addr_broadcast(hdr->dst) &&
+        (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+              "That's not me => Dropped\n",
+              hdr->dst[0], hdr->dst[1], hdr->dst[2],
+              hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+        return false;
     }
-
-    _native_in_syscall--;
+    return true;
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+/* reads the next frame from the TAP, returns -EAGAIN if none is pending */
+static int _read(netdev_tap_t *dev, void *buf, size_t len)
 {
-    netdev_tap_t *dev = (netdev_tap_t*)netdev;
-    (void)info;
+    int nread = real_read(dev->tap_fd, buf, len);
 
-    if (!buf) {
-        if (len > 0) {
-            /* no memory available in pktbuf, discarding the frame */
-            DEBUG("netdev_tap: discarding the frame\n");
+    if (nread < 0) {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+            err(EXIT_FAILURE, "netdev_tap: read");
+        }
+        nread = -EAGAIN;
+    }
+    else if (nread == 0) {
+        DEBUG("netdev_tap: ignoring null-event\n");
+        nread = -EAGAIN;
+    }
+    DEBUG("netdev_tap: read %d bytes\n", nread);
+    dev->rx_res = nread;
+    return nread;
+}
 
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
+static void _drop(netdev_tap_t *dev)
+{
+    /* repeating `real_read` for small size on tap device results in
+     * freeze for some reason. Using a large buffer for now. */
+    static uint8_t nullbuf[ETHERNET_FRAME_LEN];
 
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
+    DEBUG("netdev_tap: discarding the frame\n");
+    _read(dev, nullbuf, sizeof(nullbuf));
+}
 
-            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
+static void _isr(netdev_t *netdev)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
 
-            _continue_reading(dev);
+    /* the kernel only signals newly arriving frames, so hand frames to the
+     * upper layer until the TAP runs dry */
+    do {
+        dev->rx_res = 0;
+        if (netdev->event_callback) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
         }
+#if DEVELHELP
+        else {
+            puts("netdev_tap: _isr(): no event_callback set.");
+        }
+#endif
+        if (dev->rx_res == 0) {
+            /* upper layer did not fetch the frame, drop it to not stall */
+            _drop(dev);
+        }
+    } while (dev->rx_res != -EAGAIN);
 
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
-    }
-
-    int nread = real_read(dev->tap_fd, buf, len);
-    DEBUG("netdev_tap: read %d bytes\n", nread);
+    native_async_read_continue(dev->tap_fd);
+}
 
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
 
-            native_async_read_continue(dev->tap_fd);
+    if (!buf) {
+        int size = 0;
 
-            return 0;
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            _drop(dev);
+            return len;
         }
-
-        _continue_reading(dev);
-
-#ifdef MODULE_NETSTATS_L2
-        netdev->stats.rx_count++;
-        netdev->stats.rx_bytes += nread;
-#endif
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        if (real_ioctl(dev->tap_fd, FIONREAD, &size) < 0) {
+            /* not supported by the host's TAP driver, so we return the
+             * maximum possible size */
+            DEBUG("netdev_tap: error reading FIONREAD: %s\n", strerror(errno));
+            return ETHERNET_FRAME_LEN;
         }
-        else {
-            err(EXIT_FAILURE, "netdev_tap: read");
+        if (size == 0) {
+            dev->rx_res = -EAGAIN;
         }
+        return size;
     }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
+
+    int nread = _read(dev, buf, len);
+
+    if (nread < 0) {
+        return -1;
     }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
+    if (!_is_for_me(dev, buf, nread)) {
+        return 0;
     }
-
-    return -1;
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += nread;
+#endif
+    return nread;
 }
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
@@ -341,6 +344,7 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->rx_res = 0;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
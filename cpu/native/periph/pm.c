@@ -18,6 +18,7 @@
  */
 
 #include <err.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -31,8 +32,29 @@
 
 void pm_set_lowest(void)
 {
+    sigset_t all, mask;
+
     _native_in_syscall++; /* no switching here */
-    real_pause();
+
+    /* Signals are only queued while in an ISR, so one might be pending
+     * already. Block them while checking, sigsuspend() unblocks them
+     * atomically when going to sleep. */
+    sigfillset(&all);
+    if (sigprocmask(SIG_BLOCK, &all, &mask) == -1) {
+        err(EXIT_FAILURE, "pm_set_lowest: sigprocmask");
+    }
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    /* only wait for real time to pass if no timer is set */
+    if ((_native_sigpend == 0) && (native_vtime_idle(&mask) < 0)) {
+#else
+    if (_native_sigpend == 0) {
+#endif
+        sigsuspend(&mask);
+    }
+    if (sigprocmask(SIG_SETMASK, &mask, NULL) == -1) {
+        err(EXIT_FAILURE, "pm_set_lowest: sigprocmask");
+    }
+
     _native_in_syscall--;
 
     if (_native_sigpend > 0) {
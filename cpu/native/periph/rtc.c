@@ -16,6 +16,8 @@
  *
  * The implementation uses POSIX system calls to emulate a real-time
  * clock based on the system clock.
+ * With the `native_virtual_time` module, the clock advances with native's
+ * virtual time, starting from the system time at initialization.
  *
  * @author Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
  *
@@ -40,6 +42,10 @@ static int _native_rtc_powered = 0;
 static struct tm _native_rtc_alarm;
 static rtc_alarm_cb_t _native_rtc_alarm_callback;
 static void *_native_rtc_alarm_argument;
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/* system time at virtual time 0 */
+static time_t _native_rtc_epoch;
+#endif
 
 void rtc_init(void)
 {
@@ -48,6 +54,9 @@ void rtc_init(void)
     memset(&_native_rtc_alarm, 0, sizeof(_native_rtc_alarm));
     _native_rtc_alarm_callback = NULL;
     _native_rtc_alarm_argument = NULL;
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    _native_rtc_epoch = time(NULL) - (time_t)(native_vtime_now() / 1000000);
+#endif
 
     _native_rtc_initialized = 1;
     printf("Native RTC initialized.\n");
@@ -116,7 +125,11 @@ int rtc_get_time(struct tm *ttime)
     }
 
     _native_syscall_enter();
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    t = _native_rtc_epoch + (time_t)(native_vtime_now() / 1000000);
+#else
     t = time(NULL);
+#endif
 
     if (localtime_r(&t, ttime) == NULL) {
         err(EXIT_FAILURE, "rtc_get_time: localtime_r");
@@ -17,6 +17,13 @@
  *
  * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
  *
+ * With the `native_virtual_time` module, the timer counts virtual time
+ * instead, which only advances when the timer is read and when all threads
+ * are idle. In the latter case it jumps straight to the next deadline.
+ * Host calls that block for long advance it by the real time they took.
+ * Nodes connected to a ZEP hub can instead advance in lock-step, with the
+ * hub deciding when time moves on and by how much.
+ *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
@@ -38,6 +45,8 @@
 #include <time.h>
 #include <sys/time.h>
 #include <signal.h>
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -47,6 +56,15 @@
 #include "cpu_conf.h"
 #include "native_internal.h"
 #include "periph/timer.h"
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+
+#include "async_read.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -58,6 +76,199 @@ static unsigned long time_null;
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+static uint64_t _vtime;
+static uint64_t _vtime_deadline;
+static bool _vtime_armed;
+static struct timespec _vtime_block_start;
+
+/* lock-step with the ZEP hub, see native_vtime_sync_setup() */
+#define VTIME_SYNC_IDLE         (1U)    /**< node -> hub: idle, next deadline */
+#define VTIME_SYNC_ADVANCE      (2U)    /**< hub -> node: advance to time */
+#define VTIME_SYNC_IDLE_LEN     (24U)
+#define VTIME_SYNC_ADVANCE_LEN  (16U)
+#define VTIME_SYNC_NO_DEADLINE  (UINT64_MAX)
+
+static int _vtime_sync_fd = -1;
+static uint16_t _vtime_sync_port;
+static uint32_t _vtime_frames_sent;
+static uint32_t _vtime_frames_received;
+
+/* queues the timer interrupt as if SIGALRM was received */
+static void _vtime_fire(void)
+{
+    int sig = SIGALRM;
+
+    _vtime_armed = false;
+    if (real_write(_sig_pipefd[1], &sig, sizeof(sig)) == -1) {
+        err(EXIT_FAILURE, "timer: real_write");
+    }
+    _native_sigpend++;
+}
+
+uint64_t native_vtime_now(void)
+{
+    return _vtime;
+}
+
+static void _put_be(uint8_t *buf, uint64_t val, unsigned len)
+{
+    while (len--) {
+        buf[len] = val & 0xff;
+        val >>= 8;
+    }
+}
+
+static uint64_t _get_be(const uint8_t *buf, unsigned len)
+{
+    uint64_t val = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        val = (val << 8) | buf[i];
+    }
+    return val;
+}
+
+void native_vtime_sync_setup(const char *addr, const char *port,
+                             uint16_t zep_port)
+{
+    static const struct addrinfo hints = { .ai_family = AF_UNSPEC,
+                                           .ai_socktype = SOCK_DGRAM };
+    struct addrinfo *ai = NULL, *hub;
+    int res;
+
+    if ((res = real_getaddrinfo(addr, port, &hints, &ai)) != 0) {
+        errx(EXIT_FAILURE, "vtime: unable to get hub address: %s",
+             real_gai_strerror(res));
+    }
+    for (hub = ai; hub != NULL; hub = hub->ai_next) {
+        if ((res = real_socket(hub->ai_family, hub->ai_socktype,
+                               hub->ai_protocol)) < 0) {
+            continue;
+        }
+        if (real_connect(res, hub->ai_addr, hub->ai_addrlen) == 0) {
+            break;
+        }
+        real_close(res);
+    }
+    real_freeaddrinfo(ai);
+    if ((hub == NULL) || (real_fcntl(res, F_SETFL, O_NONBLOCK) < 0)) {
+        err(EXIT_FAILURE, "vtime: unable to connect to hub");
+    }
+    _vtime_sync_fd = res;
+    _vtime_sync_port = zep_port;
+}
+
+void native_vtime_frame_sent(void)
+{
+    _vtime_frames_sent++;
+}
+
+void native_vtime_frame_received(void)
+{
+    _vtime_frames_received++;
+}
+
+/* tells the hub that this node is idle, then waits until the hub lets time
+ * advance or something else (I/O, a signal) wakes the node up */
+static void _vtime_sync_idle(const sigset_t *mask)
+{
+    uint8_t buf[VTIME_SYNC_IDLE_LEN] = { 'V', 'T', VTIME_SYNC_IDLE };
+    fd_set rfds;
+    ssize_t len;
+
+    _put_be(&buf[4], _vtime_sync_port, 2);
+    _put_be(&buf[8], _vtime_frames_sent, 4);
+    _put_be(&buf[12], _vtime_frames_received, 4);
+    _put_be(&buf[16], _vtime_armed ? _vtime_deadline : VTIME_SYNC_NO_DEADLINE,
+            8);
+    if (real_write(_vtime_sync_fd, buf, sizeof(buf)) < 0) {
+        err(EXIT_FAILURE, "vtime: unable to reach hub");
+    }
+
+    FD_ZERO(&rfds);
+    FD_SET(_vtime_sync_fd, &rfds);
+    /* signals (SIGIO for frames and the UART, SIGINT, ...) interrupt the
+     * wait, just like sigsuspend() in pm_set_lowest() */
+    if (pselect(_vtime_sync_fd + 1, &rfds, NULL, NULL, NULL, mask) <= 0) {
+        return;
+    }
+    while ((len = real_read(_vtime_sync_fd, buf, sizeof(buf))) > 0) {
+        if ((len != VTIME_SYNC_ADVANCE_LEN) || (buf[0] != 'V') ||
+            (buf[1] != 'T') || (buf[2] != VTIME_SYNC_ADVANCE)) {
+            continue;
+        }
+        uint64_t t = _get_be(&buf[8], 8);
+
+        DEBUG("%s: hub advances to %" PRIu64 " us\n", __func__, t);
+        if (_vtime < t) {
+            _vtime = t;
+        }
+    }
+    if ((len < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+        err(EXIT_FAILURE, "vtime: unable to reach hub");
+    }
+    if (_vtime_armed && (_vtime >= _vtime_deadline)) {
+        _vtime_fire();
+    }
+}
+
+int native_vtime_idle(const sigset_t *mask)
+{
+    if (_native_sigpend > 0) {
+        /* interrupts are still pending */
+        return 0;
+    }
+    if (_vtime_sync_fd >= 0) {
+        if (!native_async_read_wait(0)) {
+            _vtime_sync_idle(mask);
+        }
+        return 0;
+    }
+    if (native_async_read_wait(NATIVE_VTIME_IO_WAIT)) {
+        /* handle I/O before time moves on */
+        return 0;
+    }
+    if (!_vtime_armed) {
+        return -1;
+    }
+    DEBUG("%s: jumping %" PRIu64 " us\n", __func__, _vtime_deadline - _vtime);
+    if (_vtime < _vtime_deadline) {
+        _vtime = _vtime_deadline;
+    }
+    _vtime_fire();
+    return 0;
+}
+
+void native_vtime_block_enter(void)
+{
+    if (real_clock_gettime(CLOCK_MONOTONIC, &_vtime_block_start) == -1) {
+        err(EXIT_FAILURE, "native_vtime_block_enter: clock_gettime");
+    }
+}
+
+void native_vtime_block_leave(void)
+{
+    struct timespec t;
+    uint64_t blocked;
+
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "native_vtime_block_leave: clock_gettime");
+    }
+    blocked = (uint64_t)(t.tv_sec - _vtime_block_start.tv_sec) * NATIVE_TIMER_SPEED
+              + (t.tv_nsec - _vtime_block_start.tv_nsec) / 1000;
+
+    /* the process was stuck in the host, let timers catch up with real time,
+     * unless the hub dictates the time */
+    if ((blocked >= NATIVE_VTIME_BLOCK_MIN) && (_vtime_sync_fd < 0)) {
+        DEBUG("%s: blocked %" PRIu64 " us\n", __func__, blocked);
+        _vtime += blocked;
+        if (_vtime_armed && (_vtime >= _vtime_deadline)) {
+            _vtime_fire();
+        }
+    }
+}
+#else
 static struct itimerval itv;
 
 /**
@@ -68,6 +279,7 @@ static unsigned long ts2ticks(struct timespec *tp)
     /* TODO: check for overflow */
     return((tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
 }
+#endif
 
 /**
  * native timer signal handler
@@ -109,6 +321,11 @@ static void do_timer_set(unsigned int offset)
 {
     DEBUG("%s\n", __func__);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    /* no clock skew to avoid */
+    _vtime_deadline = _vtime + offset;
+    _vtime_armed = (offset != 0);
+#else
     if (offset && offset < NATIVE_TIMER_MIN_RES) {
         offset = NATIVE_TIMER_MIN_RES;
     }
@@ -124,6 +341,7 @@ static void do_timer_set(unsigned int offset)
         err(EXIT_FAILURE, "timer_arm: setitimer");
     }
     _native_syscall_leave();
+#endif
 }
 
 int timer_set(tim_t dev, int channel, unsigned int offset)
@@ -178,10 +396,21 @@ unsigned int timer_read(tim_t dev)
         return 0;
     }
 
-    struct timespec t;
-
     DEBUG("timer_read()\n");
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    /* time passes while code polls the timer, e.g. in xtimer_spin() */
+    _native_syscall_enter();
+    _vtime += NATIVE_VTIME_READ_STEP;
+    if (_vtime_armed && (_vtime >= _vtime_deadline)) {
+        _vtime_fire();
+    }
+    _native_syscall_leave();
+
+    return (unsigned int)_vtime - time_null;
+#else
+    struct timespec t;
+
     _native_syscall_enter();
 #ifdef __MACH__
     clock_serv_t cclock;
@@ -201,4 +430,5 @@ unsigned int timer_read(tim_t dev)
     _native_syscall_leave();
 
     return ts2ticks(&t) - time_null;
+#endif
 }
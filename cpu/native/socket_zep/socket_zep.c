@@ -114,6 +114,9 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
         DEBUG("socket_zep::send: error writing packet: %s\n", strerror(errno));
         return res;
     }
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_frame_sent();
+#endif
     /* simulate TX_COMPLETE interrupt */
     if (netdev->event_callback) {
         dev->last_event = NETDEV_EVENT_TX_COMPLETE;
@@ -196,6 +199,9 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         size = real_read(dev->sock_fd, dev->rcv_buf, sizeof(dev->rcv_buf));
 
         if (size > 0) {
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+            native_vtime_frame_received();
+#endif
             zep_hdr_t *tmp = (zep_hdr_t *)&dev->rcv_buf;
 
             if ((tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
@@ -92,6 +92,9 @@ static const char short_opts[] = ":hi:s:deEoc:"
 #endif
 #ifdef MODULE_SOCKET_ZEP
     "z:"
+#endif
+#if defined(MODULE_SOCKET_ZEP) && defined(MODULE_NATIVE_VIRTUAL_TIME)
+    "V"
 #endif
     "";
 
@@ -112,6 +115,9 @@ static const struct option long_opts[] = {
 #endif
 #ifdef MODULE_SOCKET_ZEP
     { "zep", required_argument, NULL, 'z' },
+#endif
+#if defined(MODULE_SOCKET_ZEP) && defined(MODULE_NATIVE_VIRTUAL_TIME)
+    { "vtime-sync", no_argument, NULL, 'V' },
 #endif
     { NULL, 0, NULL, '\0' },
 };
@@ -280,6 +286,11 @@ void usage_exit(int status)
 "        provide a ZEP interface with local address and port (<laddr>, <lport>)\n"
 "        and remote address and port (default local: [::]:17754).\n"
 "        Required to be provided SOCKET_ZEP_MAX times\n"
+#endif
+#if defined(MODULE_SOCKET_ZEP) && defined(MODULE_NATIVE_VIRTUAL_TIME)
+"    -V, --vtime-sync\n"
+"        advance virtual time in lock-step with the ZEP hub of the first ZEP\n"
+"        interface (see dist/tools/zep_hub)\n"
 #endif
     );
 #ifdef MODULE_MTD_NATIVE
@@ -384,6 +395,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
     int c, opt_idx = 0, uart = 0;
 #ifdef MODULE_SOCKET_ZEP
     unsigned zeps = 0;
+#endif
+#if defined(MODULE_SOCKET_ZEP) && defined(MODULE_NATIVE_VIRTUAL_TIME)
+    bool vtime_sync = false;
 #endif
     bool dmn = false, force_stderr = false;
     _stdiotype_t stderrtype = _STDIOTYPE_STDIO;
@@ -455,6 +469,11 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
             case 'z':
                 _zep_params_setup(optarg, zeps++);
                 break;
+#endif
+#if defined(MODULE_SOCKET_ZEP) && defined(MODULE_NATIVE_VIRTUAL_TIME)
+            case 'V':
+                vtime_sync = true;
+                break;
 #endif
             default:
                 usage_exit(EXIT_FAILURE);
@@ -475,6 +494,16 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
         usage_exit(EXIT_FAILURE);
     }
 #endif
+#if defined(MODULE_SOCKET_ZEP) && defined(MODULE_NATIVE_VIRTUAL_TIME)
+    if (vtime_sync) {
+        if (zeps == 0) {
+            usage_exit(EXIT_FAILURE);
+        }
+        native_vtime_sync_setup(socket_zep_params[0].remote_addr,
+                                socket_zep_params[0].remote_port,
+                                atoi(socket_zep_params[0].local_port));
+    }
+#endif
 
     if (dmn) {
         filter_daemonize_argv(_native_argv);
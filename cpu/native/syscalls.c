@@ -133,7 +133,7 @@ void _native_syscall_leave(void)
         native_isr_context.uc_stack.ss_flags = 0;
         native_interrupts_enabled = 0;
         makecontext(&native_isr_context, native_irq_handler, 0);
-        if (swapcontext(_native_cur_ctx, &native_isr_context) == -1) {
+        if (_native_swapcontext(_native_cur_ctx, &native_isr_context) == -1) {
             err(EXIT_FAILURE, "_native_syscall_leave: swapcontext");
         }
     }
@@ -220,7 +220,13 @@ ssize_t _native_read(int fd, void *buf, size_t count)
     ssize_t r;
 
     _native_syscall_enter();
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_block_enter();
+#endif
     r = real_read(fd, buf, count);
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_block_leave();
+#endif
     _native_syscall_leave();
 
     return r;
@@ -231,7 +237,13 @@ ssize_t _native_write(int fd, const void *buf, size_t count)
     ssize_t r;
 
     _native_syscall_enter();
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_block_enter();
+#endif
     r = real_write(fd, buf, count);
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_block_leave();
+#endif
     _native_syscall_leave();
 
     return r;
@@ -242,7 +254,13 @@ ssize_t _native_writev(int fd, const struct iovec *iov, int iovcnt)
     ssize_t r;
 
     _native_syscall_enter();
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_block_enter();
+#endif
     r = real_writev(fd, iov, iovcnt);
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    native_vtime_block_leave();
+#endif
     _native_syscall_leave();
 
     return r;
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Convert a RIOT kernel event trace (ktrace) to the Chrome trace event format.
+
+The input is either a binary file written by `ktrace save <file>` (native) or
+a terminal log containing the output of `ktrace dump`. The output can be
+opened in chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import binascii
+import collections
+import json
+import re
+import struct
+import sys
+
+MAGIC = b"KTRC"
+VERSION = 1
+HDR = struct.Struct("<4sBBHII")
+THREAD = struct.Struct("<H14s")
+ENTRY = struct.Struct("<IBBHI")
+
+SWITCH, MSG_SEND, MSG_RECV, MUTEX_BLOCK, MUTEX_UNBLOCK, FLAGS_SET, \
+    ISR_ENTER, ISR_EXIT = range(8)
+
+# track used for interrupts, above any valid PID
+ISR_TID = 0x10000
+
+
+def extract_dump(text):
+    """Return the binary data of the last `ktrace dump` in a terminal log."""
+    match = None
+    for match in re.finditer(r"ktrace: begin\s*\n(.*?)ktrace: end", text, re.S):
+        pass
+    if match is None:
+        raise ValueError("no ktrace dump found")
+    data = ""
+    for line in match.group(1).splitlines():
+        # strip anything a terminal program might have prepended
+        hexdata = re.search(r"([0-9a-f]+)\s*$", line)
+        if hexdata:
+            data += hexdata.group(1)
+    return binascii.unhexlify(data)
+
+
+def parse(data):
+    """Parse the binary export format into thread names and entries."""
+    magic, version, entry_len, thread_num, entry_num, lost = \
+        HDR.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION or entry_len != ENTRY.size:
+        raise ValueError("not a ktrace v{} export".format(VERSION))
+    offset = HDR.size
+    threads = {}
+    for _ in range(thread_num):
+        pid, name = THREAD.unpack_from(data, offset)
+        offset += THREAD.size
+        name = name.rstrip(b"\0").decode("ascii", "replace")
+        threads[pid] = name or "pid {}".format(pid)
+    entries = []
+    last = None
+    wraps = 0
+    for _ in range(entry_num):
+        time, event, pid, arg16, arg32 = ENTRY.unpack_from(data, offset)
+        offset += ENTRY.size
+        # unwrap the 32 bit microsecond time stamps, entries preempted by an
+        # ISR while recording may be slightly out of order
+        if last is not None and last - time > (1 << 31):
+            wraps += 1
+        last = time
+        entries.append((time + (wraps << 32), event, pid, arg16, arg32))
+    return threads, entries, lost
+
+
+def convert(threads, entries, lost):
+    """Build the Chrome trace event list."""
+    events = []
+    for pid, name in sorted(threads.items()):
+        events.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": pid,
+                       "args": {"name": name}})
+    events.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": ISR_TID,
+                   "args": {"name": "ISR"}})
+
+    running = None
+    flows = collections.defaultdict(collections.deque)
+    flow_id = 0
+
+    def instant(ts, tid, name, args):
+        events.append({"ph": "i", "s": "t", "name": name, "ts": ts, "pid": 0,
+                       "tid": tid, "args": args})
+
+    for ts, event, pid, arg16, arg32 in entries:
+        if event == SWITCH:
+            if running is not None:
+                events.append({"ph": "E", "ts": ts, "pid": 0, "tid": running})
+            running = arg16
+            events.append({"ph": "B", "name": "running", "ts": ts, "pid": 0,
+                           "tid": running})
+        elif event == MSG_SEND:
+            flow_id += 1
+            flows[(arg16, arg32)].append(flow_id)
+            instant(ts, pid, "msg_send", {"to": arg16, "type": hex(arg32)})
+            events.append({"ph": "s", "name": "msg", "cat": "msg",
+                           "id": flow_id, "ts": ts, "pid": 0, "tid": pid})
+        elif event == MSG_RECV:
+            instant(ts, pid, "msg_recv", {"from": arg16, "type": hex(arg32)})
+            pending = flows.get((pid, arg32))
+            if pending:
+                events.append({"ph": "f", "bp": "e", "name": "msg",
+                               "cat": "msg", "id": pending.popleft(),
+                               "ts": ts, "pid": 0, "tid": pid})
+        elif event == MUTEX_BLOCK:
+            instant(ts, pid, "mutex_block", {"mutex": hex(arg32)})
+        elif event == MUTEX_UNBLOCK:
+            instant(ts, pid, "mutex_unblock",
+                    {"mutex": hex(arg32), "woken": arg16})
+        elif event == FLAGS_SET:
+            instant(ts, pid, "flags_set", {"to": arg16, "flags": hex(arg32)})
+        elif event in (ISR_ENTER, ISR_EXIT):
+            events.append({"ph": "B" if event == ISR_ENTER else "E",
+                           "name": "irq {}".format(arg32), "ts": ts,
+                           "pid": 0, "tid": ISR_TID})
+    if running is not None and entries:
+        events.append({"ph": "E", "ts": entries[-1][0], "pid": 0,
+                       "tid": running})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns",
+            "otherData": {"lost_events": lost}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", type=argparse.FileType("rb"),
+                        help="binary trace or terminal log with a ktrace dump")
+    parser.add_argument("output", nargs="?", type=argparse.FileType("w"),
+                        default=sys.stdout, help="JSON output (default: stdout)")
+    args = parser.parse_args()
+
+    data = args.input.read()
+    if not data.startswith(MAGIC):
+        data = extract_dump(data.decode("utf-8", "replace"))
+    threads, entries, lost = parse(data)
+    if lost:
+        print("warning: {} events were overwritten".format(lost),
+              file=sys.stderr)
+    json.dump(convert(threads, entries, lost), args.output, indent=1)
+
+
+if __name__ == "__main__":
+    main()
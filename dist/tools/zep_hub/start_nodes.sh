@@ -0,0 +1,43 @@
+#!/bin/sh
+
+# Starts a ZEP hub and <count> instances of a native RIOT application
+# connected to it. Node i uses the UDP port <first port> + i, which is also
+# its name in topology files and statistics.
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <native elf> <count> [<first port>] [<zep_hub args>...]"
+    exit 1
+fi
+
+ZEP_HUB_DIR="$(dirname $(readlink -f $0))"
+ELF=$1
+COUNT=$2
+FIRST_PORT=${3:-17755}
+shift 3 2> /dev/null || shift $#
+HUB_PORT=17754
+LOG_DIR=${LOG_DIR:-/tmp/zep_nodes}
+# set VTIME=1 to run nodes built with native_virtual_time in lock-step
+if [ "${VTIME}" = "1" ]; then
+    HUB_VTIME="-V ${COUNT}"
+    NODE_VTIME="-V"
+fi
+
+trap "kill 0" INT TERM EXIT
+
+make -C "${ZEP_HUB_DIR}" > /dev/null || exit 1
+mkdir -p "${LOG_DIR}"
+
+"${ZEP_HUB_DIR}/zep_hub" -p ${HUB_PORT} -n ${COUNT} ${HUB_VTIME} "$@" &
+sleep 1
+
+i=0
+while [ $i -lt ${COUNT} ]; do
+    PORT=$((FIRST_PORT + i))
+    # keep stdin open so the nodes' shells don't see EOF
+    sleep 2147483647 | "${ELF}" -i $i -s $((i + 1)) ${NODE_VTIME} \
+        -z "[::1]:${PORT},[::1]:${HUB_PORT}" > "${LOG_DIR}/${PORT}.log" 2>&1 &
+    i=$((i + 1))
+done
+
+echo "${COUNT} nodes running, logs in ${LOG_DIR}, press Ctrl-C to stop"
+wait
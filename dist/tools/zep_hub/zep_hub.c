@@ -0,0 +1,835 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/*
+ * ZEP hub: connects native RIOT instances using socket_zep to a simulated
+ * IEEE 802.15.4 network. Each node is identified by the UDP port its
+ * socket_zep is bound to. Frames are forwarded to every node the sender has
+ * a link to, with optional per-link frame loss and propagation delay.
+ *
+ * With -V, nodes built with native_virtual_time and started with -V report
+ * when they are idle and their next timer deadline. Once all of them are
+ * idle and have handled all frames sent to them, the hub advances their
+ * clocks to the earliest deadline or delayed frame, so they share one
+ * virtual time base.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#define ZEP_HUB_ADDR_DEFAULT    "::1"
+#define ZEP_HUB_PORT_DEFAULT    "17754"
+#define ZEP_HUB_NODES_DEFAULT   (512U)
+#define ZEP_HUB_BENCH_ROUNDS    (100U)
+#define ZEP_FRAME_MAX           (256U)
+#define ZEP_HDR_V2_DATA_LEN     (32U)
+/* virtual time messages, see cpu/native/periph/timer.c */
+#define VTIME_IDLE              (1U)
+#define VTIME_ADVANCE           (2U)
+#define VTIME_IDLE_LEN          (24U)
+#define VTIME_ADVANCE_LEN       (16U)
+
+/* a node, i.e. a socket_zep instance */
+typedef struct {
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+    uint16_t port;
+    uint32_t rx;                /* frames sent by the node */
+    uint32_t tx;                /* frames delivered to the node */
+} node_t;
+
+/* directed link between two nodes */
+typedef struct {
+    uint32_t loss;              /* frames are lost if rand() < loss */
+    uint32_t delay_us;
+    uint32_t frames;            /* frames forwarded over the link */
+    uint32_t lost;              /* frames lost on the link */
+    bool up;
+} link_t;
+
+/* directed link as read from the topology, applied once both nodes exist */
+typedef struct {
+    uint16_t src;
+    uint16_t dst;
+    uint32_t loss;
+    uint32_t delay_us;
+} rule_t;
+
+/* virtual clock of a node, i.e. a native instance started with -V */
+typedef struct {
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+    uint16_t port;              /* port of the node's socket_zep */
+    uint32_t sent;              /* frames sent by the node */
+    uint32_t received;          /* frames received by the node */
+    uint64_t deadline;          /* next timer deadline, UINT64_MAX if none */
+    bool idle;
+} vclock_t;
+
+/* frame waiting for its propagation delay to pass */
+typedef struct delayed {
+    struct delayed *next;
+    uint64_t due_us;
+    unsigned dst;
+    size_t len;
+    uint8_t data[];
+} delayed_t;
+
+static struct {
+    int fd;
+    node_t *nodes;
+    unsigned nodes_numof;
+    unsigned nodes_max;
+    uint16_t port2node[UINT16_MAX + 1]; /* node index + 1, 0 if unknown */
+    link_t *links;                      /* nodes_max x nodes_max matrix */
+    rule_t *rules;
+    unsigned rules_numof;
+    bool topology;                      /* only links in rules are up */
+    uint32_t loss;                      /* defaults for unlisted links */
+    uint32_t delay_us;
+    delayed_t *queue;
+    vclock_t *clocks;
+    unsigned clocks_numof;
+    unsigned clocks_min;                /* 0 if virtual time is off */
+    uint64_t vtime;                     /* current virtual time */
+    uint64_t rng;
+    uint32_t frames_in;
+    uint32_t frames_out;
+    uint32_t frames_invalid;
+    uint32_t send_errors;
+    bool quiet;                         /* don't report joining nodes */
+} _hub;
+
+static volatile sig_atomic_t _print_stats;
+static volatile sig_atomic_t _quit;
+
+static uint64_t _now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + (ts.tv_nsec / 1000U);
+}
+
+/* xorshift64*, seeded with -s to make loss patterns reproducible */
+static uint32_t _rand(void)
+{
+    _hub.rng ^= _hub.rng >> 12;
+    _hub.rng ^= _hub.rng << 25;
+    _hub.rng ^= _hub.rng >> 27;
+    return (uint32_t)((_hub.rng * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static link_t *_link(unsigned src, unsigned dst)
+{
+    return &_hub.links[(src * _hub.nodes_max) + dst];
+}
+
+static uint16_t _addr_port(const struct sockaddr_storage *addr)
+{
+    if (addr->ss_family == AF_INET6) {
+        return ntohs(((const struct sockaddr_in6 *)addr)->sin6_port);
+    }
+    return ntohs(((const struct sockaddr_in *)addr)->sin_port);
+}
+
+static bool _parse_loss(const char *str, uint32_t *loss)
+{
+    char *end;
+    double percent = strtod(str, &end);
+
+    if ((*end != '\0') || (percent < 0) || (percent > 100)) {
+        return false;
+    }
+    *loss = (percent >= 100) ? UINT32_MAX
+                             : (uint32_t)(ldexp(percent / 100, 32));
+    return true;
+}
+
+static bool _parse_u32(const char *str, uint32_t *val)
+{
+    char *end;
+    unsigned long res = strtoul(str, &end, 0);
+
+    if ((*end != '\0') || (res > UINT32_MAX)) {
+        return false;
+    }
+    *val = res;
+    return true;
+}
+
+static void _add_rule(uint16_t src, uint16_t dst, uint32_t loss,
+                      uint32_t delay_us)
+{
+    rule_t *rules = realloc(_hub.rules,
+                            (_hub.rules_numof + 1) * sizeof(rule_t));
+
+    if (rules == NULL) {
+        perror("realloc");
+        exit(EXIT_FAILURE);
+    }
+    _hub.rules = rules;
+    _hub.rules[_hub.rules_numof++] = (rule_t){ .src = src, .dst = dst,
+                                               .loss = loss,
+                                               .delay_us = delay_us };
+}
+
+/*
+ * One link per line:
+ *
+ *     <port> <-> <port> [<loss in %> [<delay in us>]]
+ *     <port> -> <port> [<loss in %> [<delay in us>]]
+ */
+static void _load_topology(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    unsigned lineno = 0;
+
+    if (f == NULL) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *tok[5] = { NULL };
+        char *comment = strchr(line, '#'), *save = NULL;
+        unsigned n = 0;
+        uint32_t src, dst, loss = 0, delay_us = 0;
+
+        lineno++;
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        for (char *t = strtok_r(line, " \t\r\n", &save); t != NULL;
+             t = strtok_r(NULL, " \t\r\n", &save)) {
+            if (n == 5) {
+                n++;
+                break;
+            }
+            tok[n++] = t;
+        }
+        if (n == 0) {
+            continue;
+        }
+        if ((n < 3) || (n > 5) ||
+            (strcmp(tok[1], "->") && strcmp(tok[1], "<->")) ||
+            !_parse_u32(tok[0], &src) || (src > UINT16_MAX) ||
+            !_parse_u32(tok[2], &dst) || (dst > UINT16_MAX) ||
+            ((n > 3) && !_parse_loss(tok[3], &loss)) ||
+            ((n > 4) && !_parse_u32(tok[4], &delay_us))) {
+            fprintf(stderr, "%s:%u: invalid link\n", path, lineno);
+            exit(EXIT_FAILURE);
+        }
+        _add_rule(src, dst, loss, delay_us);
+        if (tok[1][0] == '<') {
+            _add_rule(dst, src, loss, delay_us);
+        }
+    }
+    fclose(f);
+    _hub.topology = true;
+}
+
+static void _apply_rules(unsigned idx)
+{
+    uint16_t port = _hub.nodes[idx].port;
+
+    for (unsigned i = 0; i < _hub.rules_numof; i++) {
+        rule_t *rule = &_hub.rules[i];
+        unsigned src = _hub.port2node[rule->src];
+        unsigned dst = _hub.port2node[rule->dst];
+
+        if (((rule->src != port) && (rule->dst != port)) ||
+            (src == 0) || (dst == 0) || (src == dst)) {
+            continue;
+        }
+        link_t *link = _link(src - 1, dst - 1);
+        link->up = true;
+        link->loss = rule->loss;
+        link->delay_us = rule->delay_us;
+    }
+}
+
+static int _node_get(const struct sockaddr_storage *addr, socklen_t addr_len)
+{
+    uint16_t port = _addr_port(addr);
+    unsigned idx = _hub.port2node[port];
+
+    if (idx > 0) {
+        return idx - 1;
+    }
+    if (_hub.nodes_numof == _hub.nodes_max) {
+        fprintf(stderr, "zep_hub: ignoring node %u, increase -n\n", port);
+        return -1;
+    }
+    idx = _hub.nodes_numof++;
+    _hub.nodes[idx] = (node_t){ .addr_len = addr_len, .port = port };
+    memcpy(&_hub.nodes[idx].addr, addr, addr_len);
+    _hub.port2node[port] = idx + 1;
+    for (unsigned i = 0; i < idx; i++) {
+        link_t dflt = { .up = !_hub.topology, .loss = _hub.loss,
+                        .delay_us = _hub.delay_us };
+
+        *_link(i, idx) = dflt;
+        *_link(idx, i) = dflt;
+    }
+    _apply_rules(idx);
+    if (!_hub.quiet) {
+        printf("zep_hub: node %u joined (%u nodes)\n", port,
+               _hub.nodes_numof);
+    }
+    return idx;
+}
+
+static void _send(unsigned dst, const uint8_t *data, size_t len)
+{
+    node_t *node = &_hub.nodes[dst];
+
+    if (sendto(_hub.fd, data, len, 0, (struct sockaddr *)&node->addr,
+               node->addr_len) < 0) {
+        /* node might be gone or its socket buffer full */
+        _hub.send_errors++;
+        return;
+    }
+    node->tx++;
+    _hub.frames_out++;
+}
+
+static void _enqueue(unsigned dst, const uint8_t *data, size_t len,
+                     uint64_t due_us)
+{
+    delayed_t *frame = malloc(sizeof(delayed_t) + len), **pos;
+
+    if (frame == NULL) {
+        _hub.send_errors++;
+        return;
+    }
+    frame->due_us = due_us;
+    frame->dst = dst;
+    frame->len = len;
+    memcpy(frame->data, data, len);
+    /* keep the queue sorted, frames with equal delay stay in order */
+    for (pos = &_hub.queue; (*pos != NULL) && ((*pos)->due_us <= due_us);
+         pos = &(*pos)->next) {}
+    frame->next = *pos;
+    *pos = frame;
+}
+
+static void _flush(uint64_t now)
+{
+    while ((_hub.queue != NULL) && (_hub.queue->due_us <= now)) {
+        delayed_t *frame = _hub.queue;
+
+        _hub.queue = frame->next;
+        _send(frame->dst, frame->data, frame->len);
+        free(frame);
+    }
+}
+
+static void _forward(unsigned src, const uint8_t *data, size_t len,
+                     uint64_t now)
+{
+    _hub.nodes[src].rx++;
+    _hub.frames_in++;
+    for (unsigned dst = 0; dst < _hub.nodes_numof; dst++) {
+        link_t *link = _link(src, dst);
+
+        if ((dst == src) || !link->up) {
+            continue;
+        }
+        if ((link->loss > 0) && (_rand() < link->loss)) {
+            link->lost++;
+            continue;
+        }
+        link->frames++;
+        if (link->delay_us == 0) {
+            _send(dst, data, len);
+        }
+        else {
+            _enqueue(dst, data, len, now + link->delay_us);
+        }
+    }
+}
+
+static void _put_be(uint8_t *buf, uint64_t val, unsigned len)
+{
+    while (len--) {
+        buf[len] = val & 0xff;
+        val >>= 8;
+    }
+}
+
+static uint64_t _get_be(const uint8_t *buf, unsigned len)
+{
+    uint64_t val = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        val = (val << 8) | buf[i];
+    }
+    return val;
+}
+
+static void _clock_msg(const struct sockaddr_storage *addr,
+                       socklen_t addr_len, const uint8_t *buf, size_t len)
+{
+    vclock_t *clock = NULL;
+
+    if ((len != VTIME_IDLE_LEN) || (buf[2] != VTIME_IDLE)) {
+        _hub.frames_invalid++;
+        return;
+    }
+    for (unsigned i = 0; i < _hub.clocks_numof; i++) {
+        if ((_hub.clocks[i].addr_len == addr_len) &&
+            (memcmp(&_hub.clocks[i].addr, addr, addr_len) == 0)) {
+            clock = &_hub.clocks[i];
+            break;
+        }
+    }
+    if (clock == NULL) {
+        if (_hub.clocks_numof == _hub.nodes_max) {
+            fputs("zep_hub: ignoring clock, increase -n\n", stderr);
+            return;
+        }
+        clock = &_hub.clocks[_hub.clocks_numof++];
+        clock->addr_len = addr_len;
+        memcpy(&clock->addr, addr, addr_len);
+        if (!_hub.quiet) {
+            printf("zep_hub: clock of node %u joined (%u clocks)\n",
+                   (unsigned)_get_be(&buf[4], 2), _hub.clocks_numof);
+        }
+    }
+    clock->port = _get_be(&buf[4], 2);
+    clock->sent = _get_be(&buf[8], 4);
+    clock->received = _get_be(&buf[12], 4);
+    clock->deadline = _get_be(&buf[16], 8);
+    clock->idle = true;
+}
+
+/* a node is done with the current point in time if it is idle and the hub
+ * got all frames it sent and it got all frames the hub sent to it */
+static bool _clock_done(const vclock_t *clock)
+{
+    unsigned idx = _hub.port2node[clock->port];
+    uint32_t rx = 0, tx = 0;
+
+    if (idx > 0) {
+        rx = _hub.nodes[idx - 1].rx;
+        tx = _hub.nodes[idx - 1].tx;
+    }
+    return clock->idle && (clock->sent == rx) && (clock->received == tx);
+}
+
+/* advances all clocks to the next deadline or delayed frame once all nodes
+ * are done with the current virtual time */
+static void _step(void)
+{
+    uint8_t msg[VTIME_ADVANCE_LEN] = { 'V', 'T', VTIME_ADVANCE };
+    uint64_t next = (_hub.queue != NULL) ? _hub.queue->due_us : UINT64_MAX;
+
+    if (_hub.clocks_numof < _hub.clocks_min) {
+        return;
+    }
+    for (unsigned i = 0; i < _hub.clocks_numof; i++) {
+        if (!_clock_done(&_hub.clocks[i])) {
+            return;
+        }
+        if (_hub.clocks[i].deadline < next) {
+            next = _hub.clocks[i].deadline;
+        }
+    }
+    if (next == UINT64_MAX) {
+        /* nothing will happen without input from outside */
+        return;
+    }
+    if (next > _hub.vtime) {
+        _hub.vtime = next;
+    }
+    _put_be(&msg[8], _hub.vtime, 8);
+    for (unsigned i = 0; i < _hub.clocks_numof; i++) {
+        vclock_t *clock = &_hub.clocks[i];
+
+        if (sendto(_hub.fd, msg, sizeof(msg), 0,
+                   (struct sockaddr *)&clock->addr, clock->addr_len) < 0) {
+            _hub.send_errors++;
+        }
+        clock->idle = false;
+    }
+    _flush(_hub.vtime);
+}
+
+/* handles all frames pending on the hub's socket */
+static void _receive(void)
+{
+    uint8_t buf[ZEP_FRAME_MAX];
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+    ssize_t len;
+
+    while ((len = recvfrom(_hub.fd, buf, sizeof(buf), MSG_DONTWAIT,
+                           (struct sockaddr *)&addr, &addr_len)) >= 0) {
+        int src;
+
+        if ((len >= 2) && (buf[0] == 'V') && (buf[1] == 'T') &&
+            (_hub.clocks_min > 0)) {
+            _clock_msg(&addr, addr_len, buf, len);
+        }
+        else if ((len < 2) || (buf[0] != 'E') || (buf[1] != 'X')) {
+            _hub.frames_invalid++;
+        }
+        else if ((src = _node_get(&addr, addr_len)) >= 0) {
+            _forward(src, buf, len, _hub.clocks_min ? _hub.vtime : _now_us());
+        }
+        addr_len = sizeof(addr);
+    }
+    if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+        perror("recvfrom");
+    }
+}
+
+static void _stats(void)
+{
+    printf("zep_hub: %" PRIu32 " frames in, %" PRIu32 " frames out, %" PRIu32
+           " invalid, %" PRIu32 " send errors\n", _hub.frames_in,
+           _hub.frames_out, _hub.frames_invalid, _hub.send_errors);
+    if (_hub.clocks_min > 0) {
+        printf("zep_hub: virtual time %" PRIu64 " us, %u clocks\n",
+               _hub.vtime, _hub.clocks_numof);
+    }
+    for (unsigned i = 0; i < _hub.nodes_numof; i++) {
+        printf("node %u: %" PRIu32 " sent, %" PRIu32 " received\n",
+               _hub.nodes[i].port, _hub.nodes[i].rx, _hub.nodes[i].tx);
+    }
+    for (unsigned src = 0; src < _hub.nodes_numof; src++) {
+        for (unsigned dst = 0; dst < _hub.nodes_numof; dst++) {
+            link_t *link = _link(src, dst);
+
+            if ((link->frames > 0) || (link->lost > 0)) {
+                printf("link %u -> %u: %" PRIu32 " frames, %" PRIu32
+                       " lost\n", _hub.nodes[src].port, _hub.nodes[dst].port,
+                       link->frames, link->lost);
+            }
+        }
+    }
+    fflush(stdout);
+}
+
+static void _signal(int sig)
+{
+    if (sig == SIGUSR1) {
+        _print_stats = 1;
+    }
+    else {
+        _quit = 1;
+    }
+}
+
+static int _bind(const char *addr, const char *port, struct addrinfo **list,
+                 struct addrinfo **bound)
+{
+    static const struct addrinfo hints = { .ai_family = AF_UNSPEC,
+                                           .ai_socktype = SOCK_DGRAM,
+                                           .ai_flags = AI_PASSIVE };
+    int err = getaddrinfo(addr, port, &hints, list);
+
+    if (err != 0) {
+        fprintf(stderr, "%s: %s\n", addr, gai_strerror(err));
+        return -1;
+    }
+    for (struct addrinfo *ai = *list; ai != NULL; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+
+        if (fd < 0) {
+            continue;
+        }
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            *bound = ai;
+            return fd;
+        }
+        close(fd);
+    }
+    perror("bind");
+    return -1;
+}
+
+static void _run(void)
+{
+    struct pollfd pfd = { .fd = _hub.fd, .events = POLLIN };
+
+    while (!_quit) {
+        int timeout = -1;
+
+        /* with virtual time, delayed frames are due in virtual time */
+        if ((_hub.queue != NULL) && (_hub.clocks_min == 0)) {
+            uint64_t now = _now_us();
+
+            timeout = (_hub.queue->due_us > now)
+                    ? (int)((_hub.queue->due_us - now + 999) / 1000) : 0;
+        }
+        if ((poll(&pfd, 1, timeout) < 0) && (errno != EINTR)) {
+            perror("poll");
+            break;
+        }
+        if (pfd.revents & POLLIN) {
+            _receive();
+        }
+        if (_hub.clocks_min > 0) {
+            _step();
+        }
+        else {
+            _flush(_now_us());
+        }
+        if (_print_stats) {
+            _print_stats = 0;
+            _stats();
+        }
+    }
+    _stats();
+}
+
+/*
+ * Simulates nodes with plain UDP sockets in a square grid, where each node
+ * can reach its (up to) four direct neighbours, and measures how fast the hub
+ * forwards their frames.
+ */
+static int _bench(const struct addrinfo *hub, unsigned numof)
+{
+    int *fds = calloc(numof, sizeof(int));
+    uint8_t frame[ZEP_HDR_V2_DATA_LEN + 20] = { 'E', 'X', 2, 1 };
+    uint8_t buf[ZEP_FRAME_MAX];
+    unsigned width = 1;
+    uint64_t start, usec;
+    uint32_t in, out;
+
+    if (fds == NULL) {
+        perror("calloc");
+        return -1;
+    }
+    frame[ZEP_HDR_V2_DATA_LEN - 1] = sizeof(frame) - ZEP_HDR_V2_DATA_LEN;
+    while (width * width < numof) {
+        width++;
+    }
+    _hub.topology = true;
+    _hub.quiet = true;
+    for (unsigned i = 0; i < numof; i++) {
+        struct sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+
+        if (((fds[i] = socket(hub->ai_family, SOCK_DGRAM, 0)) < 0) ||
+            (connect(fds[i], hub->ai_addr, hub->ai_addrlen) < 0) ||
+            (getsockname(fds[i], (struct sockaddr *)&addr, &addr_len) < 0)) {
+            perror("bench: node socket");
+            return -1;
+        }
+        uint16_t port = _addr_port(&addr);
+
+        /* link to the left and upper neighbours, which joined already */
+        if ((i % width) > 0) {
+            _add_rule(port, _hub.nodes[i - 1].port, _hub.loss, _hub.delay_us);
+            _add_rule(_hub.nodes[i - 1].port, port, _hub.loss, _hub.delay_us);
+        }
+        if (i >= width) {
+            _add_rule(port, _hub.nodes[i - width].port, _hub.loss,
+                      _hub.delay_us);
+            _add_rule(_hub.nodes[i - width].port, port, _hub.loss,
+                      _hub.delay_us);
+        }
+        /* the first frame makes the node join */
+        if ((send(fds[i], frame, sizeof(frame), 0) < 0) ||
+            (poll(&(struct pollfd){ .fd = _hub.fd, .events = POLLIN }, 1,
+                  1000) <= 0)) {
+            perror("bench: join");
+            return -1;
+        }
+        _receive();
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        while (recv(fds[i], buf, sizeof(buf), MSG_DONTWAIT) > 0) {}
+    }
+    printf("bench: %u nodes in a %ux%u grid, %u rounds\n", _hub.nodes_numof,
+           width, width, ZEP_HUB_BENCH_ROUNDS);
+    in = _hub.frames_in;
+    out = _hub.frames_out;
+    start = _now_us();
+    for (unsigned round = 0; round < ZEP_HUB_BENCH_ROUNDS; round++) {
+        for (unsigned i = 0; i < numof; i++) {
+            if (send(fds[i], frame, sizeof(frame), 0) < 0) {
+                perror("bench: send");
+                return -1;
+            }
+            _receive();
+            _flush(_now_us());
+        }
+        for (unsigned i = 0; i < numof; i++) {
+            while (recv(fds[i], buf, sizeof(buf), MSG_DONTWAIT) > 0) {}
+        }
+    }
+    /* don't wait for the propagation delay of the last frames */
+    _flush(UINT64_MAX);
+    usec = _now_us() - start;
+    in = _hub.frames_in - in;
+    out = _hub.frames_out - out;
+    printf("bench: %" PRIu32 " frames in, %" PRIu32 " frames out in %" PRIu64
+           " us\n", in, out, usec);
+    if (usec > 0) {
+        printf("bench: %" PRIu64 " frames/s in, %" PRIu64 " frames/s out\n",
+               ((uint64_t)in * 1000000U) / usec,
+               ((uint64_t)out * 1000000U) / usec);
+    }
+    printf("bench: %" PRIu32 " send errors\n", _hub.send_errors);
+    for (unsigned i = 0; i < numof; i++) {
+        close(fds[i]);
+    }
+    free(fds);
+    return 0;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-a <addr>] [-p <port>] [-n <max nodes>] [-t <file>]\n"
+            "          [-l <loss in %%>] [-d <delay in us>] [-s <seed>]"
+            " [-B <nodes>]\n"
+            "          [-V <nodes>]\n"
+            "\n"
+            "    -a  address to listen on (default: %s)\n"
+            "    -p  port to listen on (default: %s)\n"
+            "    -n  maximum number of nodes (default: %u)\n"
+            "    -t  topology file, only links listed there are up\n"
+            "    -l  frame loss of links not listed in the topology\n"
+            "    -d  propagation delay of links not listed in the topology\n"
+            "    -s  seed for the frame loss\n"
+            "    -B  benchmark forwarding between the given number of nodes\n"
+            "    -V  advance the virtual time of nodes started with -V in\n"
+            "        lock-step, once the given number of them joined\n"
+            "\n"
+            "Send SIGUSR1 to print per node and per link statistics.\n",
+            name, ZEP_HUB_ADDR_DEFAULT, ZEP_HUB_PORT_DEFAULT,
+            ZEP_HUB_NODES_DEFAULT);
+}
+
+int main(int argc, char **argv)
+{
+    const char *addr = ZEP_HUB_ADDR_DEFAULT, *port = ZEP_HUB_PORT_DEFAULT;
+    const char *topology = NULL;
+    struct addrinfo *ai_list = NULL, *ai = NULL;
+    struct sigaction sa = { .sa_handler = _signal };
+    uint32_t bench = 0, clocks = 0, seed = 1;
+    int c, res = EXIT_SUCCESS;
+
+    _hub.nodes_max = ZEP_HUB_NODES_DEFAULT;
+    while ((c = getopt(argc, argv, "a:p:n:t:l:d:s:B:V:h")) != -1) {
+        bool ok = true;
+
+        switch (c) {
+            case 'a':
+                addr = optarg;
+                break;
+            case 'p':
+                port = optarg;
+                break;
+            case 'n':
+                ok = _parse_u32(optarg, &_hub.nodes_max) &&
+                     (_hub.nodes_max > 0) && (_hub.nodes_max <= UINT16_MAX);
+                break;
+            case 't':
+                topology = optarg;
+                break;
+            case 'l':
+                ok = _parse_loss(optarg, &_hub.loss);
+                break;
+            case 'd':
+                ok = _parse_u32(optarg, &_hub.delay_us);
+                break;
+            case 's':
+                ok = _parse_u32(optarg, &seed);
+                break;
+            case 'B':
+                ok = _parse_u32(optarg, &bench) && (bench > 0);
+                break;
+            case 'V':
+                ok = _parse_u32(optarg, &clocks) && (clocks > 0);
+                break;
+            default:
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ((bench > 0) && (topology != NULL)) {
+        /* node ports are only known once the benchmark created them */
+        fputs("zep_hub: -B uses a grid topology, -t is not supported\n",
+              stderr);
+        return EXIT_FAILURE;
+    }
+    if ((bench > 0) && (clocks > 0)) {
+        fputs("zep_hub: -B and -V are mutually exclusive\n", stderr);
+        return EXIT_FAILURE;
+    }
+    if (bench > _hub.nodes_max) {
+        _hub.nodes_max = bench;
+    }
+    if (clocks > _hub.nodes_max) {
+        _hub.nodes_max = clocks;
+    }
+    _hub.clocks_min = clocks;
+    _hub.rng = ((uint64_t)seed << 32) | 0x9e3779b9U;
+    _hub.nodes = calloc(_hub.nodes_max, sizeof(node_t));
+    _hub.links = calloc((size_t)_hub.nodes_max * _hub.nodes_max,
+                        sizeof(link_t));
+    _hub.clocks = calloc(_hub.nodes_max, sizeof(vclock_t));
+    if ((_hub.nodes == NULL) || (_hub.links == NULL) ||
+        (_hub.clocks == NULL)) {
+        perror("calloc");
+        return EXIT_FAILURE;
+    }
+    if (topology != NULL) {
+        _load_topology(topology);
+    }
+    if ((_hub.fd = _bind(addr, port, &ai_list, &ai)) < 0) {
+        return EXIT_FAILURE;
+    }
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGUSR1, &sa, NULL);
+
+    if (bench > 0) {
+        if (_bench(ai, bench) < 0) {
+            res = EXIT_FAILURE;
+        }
+    }
+    else {
+        printf("zep_hub: listening on [%s]:%s\n", addr, port);
+        if (clocks > 0) {
+            printf("zep_hub: virtual time starts once %" PRIu32 " nodes "
+                   "joined\n", clocks);
+        }
+        _run();
+    }
+    freeaddrinfo(ai_list);
+    close(_hub.fd);
+    return res;
+}
@@ -15,6 +15,7 @@
 
 #include <errno.h>
 
+#include "kernel_defines.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
 #include "net/ipv6/hdr.h"
@@ -43,6 +44,9 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
                                 (struct _sock_tl_ep *)remote, proto, flags,
                                 NETCONN_RAW)) == 0) {
         sock->conn = tmp;
+#ifdef MODULE_SOCK_ASYNC
+        sock->async_cb = NULL;
+#endif
     }
     return res;
 }
@@ -104,7 +108,7 @@ static uint16_t _ip6_addr_to_netif(const ip6_addr_p_t *_addr)
 }
 #endif
 
-static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
+static int _parse_iphdr(const struct netbuf *buf, void **data,
                         sock_ip_ep_t *remote)
 {
     uint8_t *data_ptr = buf->p->payload;
@@ -115,9 +119,6 @@ static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
     switch (data_ptr[0] >> 4) {
 #if LWIP_IPV4
         case 4:
-            if ((data_len - sizeof(struct ip_hdr)) > max_len) {
-                return -ENOBUFS;
-            }
             if (remote != NULL) {
                 struct ip_hdr *iphdr = (struct ip_hdr *)data_ptr;
 
@@ -132,9 +133,6 @@ static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
 #endif
 #if LWIP_IPV6
         case 6:
-            if ((data_len - sizeof(struct ip6_hdr)) > max_len) {
-                return -ENOBUFS;
-            }
             if (remote != NULL) {
                 struct ip6_hdr *iphdr = (struct ip6_hdr *)data_ptr;
 
@@ -150,22 +148,55 @@ static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
         default:
             return -EPROTO;
     }
-    memcpy(data, data_ptr, data_len);
+    *data = data_ptr;
     return (ssize_t)data_len;
 }
 
 ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
                      uint32_t timeout, sock_ip_ep_t *remote)
+{
+    void *pkt = NULL, *ctx = NULL;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = sock_ip_recv_buf(sock, &pkt, &ctx, timeout, remote);
+    if (res <= 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, pkt, res);
+    }
+    /* release the netbuf */
+    sock_ip_recv_buf(sock, &pkt, &ctx, 0, NULL);
+    return res;
+}
+
+ssize_t sock_ip_recv_buf(sock_ip_t *sock, void **data, void **buf_ctx,
+                         uint32_t timeout, sock_ip_ep_t *remote)
 {
     struct netbuf *buf;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    *data = NULL;
+    if (*buf_ctx != NULL) {
+        netbuf_delete(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
     if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
         return res;
     }
-    res = _parse_iphdr(buf, data, max_len, remote);
-    netbuf_delete(buf);
+    res = _parse_iphdr(buf, data, remote);
+    if (res <= 0) {
+        *data = NULL;
+        netbuf_delete(buf);
+        return res;
+    }
+    *buf_ctx = buf;
     return res;
 }
 
@@ -178,4 +209,27 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                           (struct _sock_tl_ep *)remote, NETCONN_RAW);
 }
 
+#ifdef MODULE_SOCK_ASYNC
+static void _async_cb(lwip_sock_async_t *async, sock_async_flags_t flags)
+{
+    sock_ip_t *sock = container_of(async, sock_ip_t, async);
+
+    if (sock->async_cb != NULL) {
+        sock->async_cb(sock, flags, sock->async_cb_arg);
+    }
+}
+
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = NULL;
+    sock->async_cb_arg = cb_arg;
+    sock->async_cb = cb;
+    sock->async.cb = _async_cb;
+    if (sock->conn != NULL) {
+        netconn_set_callback_arg(sock->conn, &sock->async);
+    }
+}
+#endif  /* MODULE_SOCK_ASYNC */
+
 /** @} */
@@ -20,6 +20,9 @@
 #include "net/ipv6/addr.h"
 #include "net/sock.h"
 #include "timex.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "sock_types.h"
+#endif
 
 #include "lwip/err.h"
 #include "lwip/ip.h"
@@ -255,11 +258,50 @@ static int _sock_ep_to_netconn_pars(const struct _sock_tl_ep *local,
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+static void _netconn_cb(struct netconn *conn, enum netconn_evt evt, u16_t len)
+{
+    lwip_sock_async_t *async = netconn_get_callback_arg(conn);
+    sock_async_flags_t flags;
+
+    (void)len;
+    /* lwIP initializes callback_arg.socket with -1 for connections it
+     * creates itself, i.e. accepted TCP connections */
+    if ((async == NULL) || (conn->callback_arg.socket == -1) ||
+        (async->cb == NULL)) {
+        return;
+    }
+    switch (evt) {
+        case NETCONN_EVT_RCVPLUS:
+            /* new data, a new connection on a listening netconn, or the
+             * connection was closed */
+            flags = SOCK_ASYNC_MSG_RECV;
+            break;
+        case NETCONN_EVT_ERROR:
+            flags = SOCK_ASYNC_CONN_FIN;
+            break;
+        default:
+            return;
+    }
+    async->cb(async, flags);
+}
+#endif
+
 static int _create(int type, int proto, uint16_t flags, struct netconn **out)
 {
-    if ((*out = netconn_new_with_proto_and_callback(type, proto, NULL)) == NULL) {
+#ifdef MODULE_SOCK_ASYNC
+    netconn_callback cb = _netconn_cb;
+#else
+    netconn_callback cb = NULL;
+#endif
+
+    if ((*out = netconn_new_with_proto_and_callback(type, proto, cb)) == NULL) {
         return -ENOMEM;
     }
+#ifdef MODULE_SOCK_ASYNC
+    /* set by sock_*_set_cb() */
+    netconn_set_callback_arg(*out, NULL);
+#endif
 #if LWIP_IPV4 && LWIP_IPV6
     if (type & NETCONN_TYPE_IPV6) {
         netconn_set_ipv6only(*out, 1);
@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include "kernel_defines.h"
 #include "mutex.h"
 
 #include "net/sock/tcp.h"
@@ -31,6 +32,9 @@ static inline void _tcp_sock_init(sock_tcp_t *sock, struct netconn *conn,
     sock->queue = queue;
     sock->last_buf = NULL;
     sock->last_offset = 0;
+#ifdef MODULE_SOCK_ASYNC
+    sock->async_cb = NULL;
+#endif
     mutex_unlock(&sock->mutex);
 }
 
@@ -78,6 +82,9 @@ int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
     queue->array = queue_array;
     queue->len = queue_len;
     queue->used = 0;
+#ifdef MODULE_SOCK_ASYNC
+    queue->async_cb = NULL;
+#endif
     memset(queue->array, 0, sizeof(sock_tcp_t) * queue_len);
     mutex_unlock(&queue->mutex);
     switch (netconn_listen_with_backlog(queue->conn, queue->len)) {
@@ -370,4 +377,53 @@ ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+static void _async_cb(lwip_sock_async_t *async, sock_async_flags_t flags)
+{
+    sock_tcp_t *sock = container_of(async, sock_tcp_t, async);
+
+    if (sock->async_cb != NULL) {
+        sock->async_cb(sock, flags, sock->async_cb_arg);
+    }
+}
+
+static void _queue_async_cb(lwip_sock_async_t *async, sock_async_flags_t flags)
+{
+    sock_tcp_queue_t *queue = container_of(async, sock_tcp_queue_t, async);
+
+    /* data on a listening netconn are new connections */
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        flags = SOCK_ASYNC_CONN_RECV;
+    }
+    if (queue->async_cb != NULL) {
+        queue->async_cb(queue, flags, queue->async_cb_arg);
+    }
+}
+
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = NULL;
+    sock->async_cb_arg = cb_arg;
+    sock->async_cb = cb;
+    sock->async.cb = _async_cb;
+    if (sock->conn != NULL) {
+        netconn_set_callback_arg(sock->conn, &sock->async);
+    }
+}
+
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_queue_cb_t cb,
+                           void *cb_arg)
+{
+    assert(queue != NULL);
+    queue->async_cb = NULL;
+    queue->async_cb_arg = cb_arg;
+    queue->async_cb = cb;
+    queue->async.cb = _queue_async_cb;
+    if (queue->conn != NULL) {
+        netconn_set_callback_arg(queue->conn, &queue->async);
+    }
+}
+#endif  /* MODULE_SOCK_ASYNC */
+
 /** @} */
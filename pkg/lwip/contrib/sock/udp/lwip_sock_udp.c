@@ -15,6 +15,7 @@
 
 #include <errno.h>
 
+#include "kernel_defines.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
 #include "net/sock/udp.h"
@@ -38,6 +39,9 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
                                 (struct _sock_tl_ep *)remote, 0, flags,
                                 NETCONN_UDP)) == 0) {
         sock->conn = tmp;
+#ifdef MODULE_SOCK_ASYNC
+        sock->async_cb = NULL;
+#endif
     }
     return res;
 }
@@ -65,6 +69,38 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
                                0)) ? -ENOTCONN : 0;
 }
 
+static int _parse_remote(sock_udp_t *sock, const struct netbuf *buf,
+                         sock_udp_ep_t *remote)
+{
+    size_t addr_len;
+
+#if LWIP_IPV6
+    if (sock->conn->type & NETCONN_TYPE_IPV6) {
+        addr_len = sizeof(ipv6_addr_t);
+        remote->family = AF_INET6;
+    }
+    else {
+#endif
+#if LWIP_IPV4
+        addr_len = sizeof(ipv4_addr_t);
+        remote->family = AF_INET;
+#else
+        return -EPROTO;
+#endif
+#if LWIP_IPV6
+    }
+#endif
+#if LWIP_NETBUF_RECVINFO
+    remote->netif = lwip_sock_bind_addr_to_netif(&buf->toaddr);
+#else
+    remote->netif = SOCK_ADDR_ANY_NETIF;
+#endif
+    /* copy address */
+    memcpy(&remote->addr, &buf->addr, addr_len);
+    remote->port = buf->port;
+    return 0;
+}
+
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote)
 {
@@ -83,32 +119,12 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     }
     if (remote != NULL) {
         /* convert remote */
-        size_t addr_len;
-#if LWIP_IPV6
-        if (sock->conn->type & NETCONN_TYPE_IPV6) {
-            addr_len = sizeof(ipv6_addr_t);
-            remote->family = AF_INET6;
-        }
-        else {
-#endif
-#if LWIP_IPV4
-            addr_len = sizeof(ipv4_addr_t);
-            remote->family = AF_INET;
-#else
+        int err = _parse_remote(sock, buf, remote);
+
+        if (err < 0) {
             netbuf_delete(buf);
-            return -EPROTO;
-#endif
-#if LWIP_IPV6
+            return err;
         }
-#endif
-#if LWIP_NETBUF_RECVINFO
-        remote->netif = lwip_sock_bind_addr_to_netif(&buf->toaddr);
-#else
-        remote->netif = SOCK_ADDR_ANY_NETIF;
-#endif
-        /* copy address */
-        memcpy(&remote->addr, &buf->addr, addr_len);
-        remote->port = buf->port;
     }
     /* copy data */
     for (struct pbuf *q = buf->p; q != NULL; q = q->next) {
@@ -119,6 +135,46 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (ssize_t)res;
 }
 
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    struct netbuf *buf;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    *data = NULL;
+    if (*buf_ctx != NULL) {
+        netbuf_delete(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
+    if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
+        return res;
+    }
+    if ((remote != NULL) && ((res = _parse_remote(sock, buf, remote)) < 0)) {
+        netbuf_delete(buf);
+        return res;
+    }
+    if (buf->p->next != NULL) {
+        /* the message needs to be handed out in one piece */
+        struct pbuf *p = pbuf_coalesce(buf->p, PBUF_RAW);
+
+        if (p == buf->p) {
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        buf->p = p;
+        buf->ptr = p;
+    }
+    if (buf->p->len == 0) {
+        netbuf_delete(buf);
+        return 0;
+    }
+    *data = buf->p->payload;
+    *buf_ctx = buf;
+    return (ssize_t)buf->p->len;
+}
+
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
 {
@@ -132,4 +188,27 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                           NETCONN_UDP);
 }
 
+#ifdef MODULE_SOCK_ASYNC
+static void _async_cb(lwip_sock_async_t *async, sock_async_flags_t flags)
+{
+    sock_udp_t *sock = container_of(async, sock_udp_t, async);
+
+    if (sock->async_cb != NULL) {
+        sock->async_cb(sock, flags, sock->async_cb_arg);
+    }
+}
+
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = NULL;
+    sock->async_cb_arg = cb_arg;
+    sock->async_cb = cb;
+    sock->async.cb = _async_cb;
+    if (sock->conn != NULL) {
+        netconn_set_callback_arg(sock->conn, &sock->async);
+    }
+}
+#endif  /* MODULE_SOCK_ASYNC */
+
 /** @} */
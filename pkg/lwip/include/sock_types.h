@@ -20,17 +20,50 @@
 
 #include "net/af.h"
 #include "lwip/api.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+struct lwip_sock_async;
+
+/**
+ * @brief   Event callback for @ref lwip_sock_async_t
+ * @internal
+ */
+typedef void (*lwip_sock_async_cb_t)(struct lwip_sock_async *async,
+                                     sock_async_flags_t flags);
+
+/**
+ * @brief   Asynchronous event context of a sock, the callback argument of its
+ *          netconn
+ * @internal
+ */
+typedef struct lwip_sock_async {
+    /**
+     * @brief   called from the netconn callback, set by the sock type
+     *          implementation to call the user's callback
+     */
+    lwip_sock_async_cb_t cb;
+} lwip_sock_async_t;
+#endif  /* defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN) */
+
 /**
  * @brief   Raw IP sock type
  * @internal
  */
 struct sock_ip {
     struct netconn *conn;
+#if (defined(MODULE_SOCK_ASYNC) && defined(MODULE_SOCK_IP)) || \
+    defined(DOXYGEN)
+    lwip_sock_async_t async;            /**< asynchronous event context */
+    sock_ip_cb_t async_cb;              /**< asynchronous event callback */
+    void *async_cb_arg;                 /**< argument for sock_ip::async_cb */
+#endif
 };
 
 /**
@@ -43,6 +76,12 @@ struct sock_tcp {
     mutex_t mutex;
     struct pbuf *last_buf;
     ssize_t last_offset;
+#if (defined(MODULE_SOCK_ASYNC) && defined(MODULE_SOCK_TCP)) || \
+    defined(DOXYGEN)
+    lwip_sock_async_t async;            /**< asynchronous event context */
+    sock_tcp_cb_t async_cb;             /**< asynchronous event callback */
+    void *async_cb_arg;                 /**< argument for sock_tcp::async_cb */
+#endif
 };
 
 /**
@@ -54,6 +93,13 @@ struct sock_tcp_queue {
     mutex_t mutex;
     unsigned short len;
     unsigned short used;
+#if (defined(MODULE_SOCK_ASYNC) && defined(MODULE_SOCK_TCP)) || \
+    defined(DOXYGEN)
+    lwip_sock_async_t async;            /**< asynchronous event context */
+    sock_tcp_queue_cb_t async_cb;       /**< asynchronous event callback */
+    void *async_cb_arg;                 /**< argument for
+                                         *   sock_tcp_queue::async_cb */
+#endif
 };
 
 /**
@@ -62,6 +108,12 @@ struct sock_tcp_queue {
  */
 struct sock_udp {
     struct netconn *conn;
+#if (defined(MODULE_SOCK_ASYNC) && defined(MODULE_SOCK_UDP)) || \
+    defined(DOXYGEN)
+    lwip_sock_async_t async;            /**< asynchronous event context */
+    sock_udp_cb_t async_cb;             /**< asynchronous event callback */
+    void *async_cb_arg;                 /**< argument for sock_udp::async_cb */
+#endif
 };
 
 #ifdef __cplusplus
@@ -28,6 +28,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+#include "sched_round_robin.h"
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN
 #include "net/gnrc/sixlowpan.h"
 #endif
@@ -48,6 +52,10 @@
 #include "net/gnrc/pktdump.h"
 #endif
 
+#ifdef MODULE_GNRC_PCAP
+#include "net/gnrc/pcap.h"
+#endif
+
 #ifdef MODULE_GNRC_UDP
 #include "net/gnrc/udp.h"
 #endif
@@ -105,6 +113,10 @@ void auto_init(void)
     DEBUG("Auto init mci module.\n");
     mci_initialize();
 #endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    DEBUG("Auto init sched_round_robin module.\n");
+    sched_round_robin_init();
+#endif
 #ifdef MODULE_PROFILING
     extern void profiling_init(void);
     profiling_init();
@@ -117,6 +129,10 @@ void auto_init(void)
     DEBUG("Auto init gnrc_pktdump module.\n");
     gnrc_pktdump_init();
 #endif
+#ifdef MODULE_GNRC_PCAP
+    DEBUG("Auto init gnrc_pcap module.\n");
+    gnrc_pcap_init();
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN
     DEBUG("Auto init gnrc_sixlowpan module.\n");
     gnrc_sixlowpan_init();
@@ -92,21 +92,26 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
+static void _set_timer(evtimer_t *evtimer, uint32_t offset_ms)
 {
     uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
 
     DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
           xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
 
-    xtimer_set64(timer, offset_us);
+#ifdef MODULE_XTIMER_SLACK
+    evtimer->deadline = xtimer_now_usec() + (uint32_t)offset_us;
+    xtimer_set_slack64(&evtimer->timer, offset_us, evtimer->slack * US_PER_MS);
+#else
+    xtimer_set64(&evtimer->timer, offset_us);
+#endif
 }
 
 static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
         evtimer_event_t *event = evtimer->events;
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer, event->offset);
     }
     else {
         xtimer_remove(&evtimer->timer);
@@ -116,8 +121,14 @@ static void _update_timer(evtimer_t *evtimer)
 static uint32_t _get_offset(xtimer_t *timer)
 {
     uint64_t now_us = xtimer_now_usec64();
-    uint64_t target_us = _xtimer_usec_from_ticks64(
-                        ((uint64_t)timer->long_target) << 32 | timer->target);
+    uint64_t target = ((uint64_t)timer->long_target) << 32 | timer->target;
+#ifdef MODULE_XTIMER_SLACK
+    /* the event is due at the start of the timer's window */
+    if (target >= timer->slack) {
+        target -= timer->slack;
+    }
+#endif
+    uint64_t target_us = _xtimer_usec_from_ticks64(target);
 
     if (target_us <= now_us) {
         return 0;
@@ -147,7 +158,7 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
     _update_head_offset(evtimer);
     evtimer_add_event_to_list(evtimer, event);
     if (evtimer->events == event) {
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer, event->offset);
     }
     irq_restore(state);
     if (sched_context_switch_request) {
@@ -196,6 +207,18 @@ static void _evtimer_handler(void *arg)
         evtimer->callback(event);
     }
 
+#ifdef MODULE_XTIMER_SLACK
+    /* the timer may have fired up to slack late, so the next event is due
+     * that much sooner */
+    int32_t late = (int32_t)(xtimer_now_usec() - evtimer->deadline);
+    if ((late > 0) && evtimer->events) {
+        event = evtimer->events;
+        late /= US_PER_MS;
+        event->offset -= ((uint32_t)late < event->offset) ? (uint32_t)late
+                                                           : event->offset;
+    }
+#endif
+
     _update_timer(evtimer);
 }
 
@@ -205,6 +228,9 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->timer.callback = _evtimer_handler;
     evtimer->timer.arg = (void *)evtimer;
     evtimer->events = NULL;
+#ifdef MODULE_XTIMER_SLACK
+    evtimer->slack = 0;
+#endif
 }
 
 void evtimer_print(const evtimer_t *evtimer)
@@ -75,6 +75,22 @@ void event_timeout_init(event_timeout_t *event_timeout, event_queue_t *queue,
  */
 void event_timeout_set(event_timeout_t *event_timeout, uint32_t timeout);
 
+/**
+ * @brief   Set a timeout that tolerates a delay
+ *
+ * Like event_timeout_set(), but the event may be posted up to @p slack
+ * microseconds late, see xtimer_set_slack().
+ *
+ * @note: the used event_timeout struct must stay valid until after the timeout
+ *        event has been processed!
+ *
+ * @param[in]   event_timeout   event_timout context object to use
+ * @param[in]   timeout         timeout in microseconds
+ * @param[in]   slack           tolerated delay in microseconds
+ */
+void event_timeout_set_slack(event_timeout_t *event_timeout, uint32_t timeout,
+                             uint32_t slack);
+
 /**
  * @brief   Clear a timeout event
  *
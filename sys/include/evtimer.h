@@ -72,6 +72,12 @@ typedef struct {
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
     evtimer_event_t *events;        /**< Event queue */
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;                 /**< Tolerated delay of events in
+                                         milliseconds */
+    uint32_t deadline;              /**< Due time of the first event (lower
+                                         32 bit of xtimer_now_usec64()) */
+#endif
 } evtimer_t;
 
 /**
@@ -98,6 +104,27 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+/**
+ * @brief   Sets the delay the events of an event timer tolerate
+ *
+ * With the `xtimer_slack` module, events may then be handled up to @p slack
+ * milliseconds after they are due, so they can be handled together with
+ * other timers (see xtimer_set_slack()). Without the module, this function
+ * does nothing.
+ *
+ * @param[in] evtimer   An event timer
+ * @param[in] slack     Tolerated delay in milliseconds, less than 2147483
+ */
+static inline void evtimer_set_slack(evtimer_t *evtimer, uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    evtimer->slack = slack;
+#else
+    (void)evtimer;
+    (void)slack;
+#endif
+}
+
 /**
  * @brief   Print overview of current state of an event timer
  *
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ktrace Kernel event tracing
+ * @ingroup     sys
+ * @brief       Low overhead trace buffer for scheduler and IPC events
+ *
+ * When this module is used, the kernel records context switches, message
+ * passing, mutex contention, thread flags and (on native) interrupts into a
+ * ring buffer of @ref KTRACE_BUFSIZE entries, each time stamped with
+ * xtimer_now_usec(). Recording only reserves a slot with an atomic increment,
+ * so it can be done from threads and ISRs alike. When the buffer is full,
+ * the oldest entries are overwritten.
+ *
+ * Recording is off until ktrace_start() is called (or `ktrace start` is
+ * issued on the shell). The buffer can be exported in a binary format with
+ * ktrace_export(), printed with the `ktrace dump` shell command, or, on
+ * native, saved to a file on the host with `ktrace save <file>`.
+ * `dist/tools/ktrace/ktrace2json.py` converts both to the Chrome trace event
+ * format that can be viewed in chrome://tracing or Perfetto.
+ *
+ * Binary format
+ * -------------
+ *
+ * All fields are little endian.
+ *
+ * | Field           | Size | Description                                  |
+ * |-----------------|------|----------------------------------------------|
+ * | magic           | 4    | "KTRC"                                       |
+ * | version         | 1    | @ref KTRACE_VERSION                          |
+ * | entry size      | 1    | size of an entry, 12                         |
+ * | thread number   | 2    | number of thread records                     |
+ * | entry number    | 4    | number of entries                            |
+ * | lost            | 4    | number of entries that were overwritten      |
+ *
+ * This header is followed by the thread records, each consisting of the PID
+ * (2 bytes) and a NUL padded name of @ref KTRACE_NAME_LEN bytes, and the
+ * entries, oldest first: time stamp in microseconds (4 bytes), event
+ * (@ref ktrace_event_t, 1 byte), PID of the active thread (1 byte),
+ * and the event specific arguments arg16 (2 bytes) and arg32 (4 bytes).
+ *
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracing interface
+ */
+
+#ifndef KTRACE_H
+#define KTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the trace buffer, must be a power of two
+ */
+#ifndef KTRACE_BUFSIZE
+#define KTRACE_BUFSIZE          (256U)
+#endif
+
+/**
+ * @brief   Version of the binary export format
+ */
+#define KTRACE_VERSION          (1U)
+
+/**
+ * @brief   Length of a thread name in the binary export format
+ */
+#define KTRACE_NAME_LEN         (14U)
+
+/**
+ * @brief   Traced events
+ */
+typedef enum {
+    KTRACE_SWITCH = 0,      /**< context switch, arg16: next PID */
+    KTRACE_MSG_SEND,        /**< message sent, arg16: target PID,
+                             *   arg32: message type */
+    KTRACE_MSG_RECV,        /**< message received, arg16: sender PID,
+                             *   arg32: message type */
+    KTRACE_MUTEX_BLOCK,     /**< thread blocks on mutex, arg32: mutex */
+    KTRACE_MUTEX_UNBLOCK,   /**< mutex handed over, arg16: woken PID,
+                             *   arg32: mutex */
+    KTRACE_FLAGS_SET,       /**< thread flags set, arg16: target PID,
+                             *   arg32: flags */
+    KTRACE_ISR_ENTER,       /**< interrupt entry, arg32: interrupt number */
+    KTRACE_ISR_EXIT,        /**< interrupt exit, arg32: interrupt number */
+} ktrace_event_t;
+
+/**
+ * @brief   A trace buffer entry
+ */
+typedef struct {
+    uint32_t time;          /**< time stamp in microseconds */
+    uint8_t event;          /**< the event, see @ref ktrace_event_t */
+    uint8_t pid;            /**< PID of the active thread */
+    uint16_t arg16;         /**< event specific argument */
+    uint32_t arg32;         /**< event specific argument */
+} ktrace_entry_t;
+
+/**
+ * @brief   Callback to write out exported trace data
+ *
+ * @param[in] data  data to write
+ * @param[in] len   length of @p data
+ * @param[in] arg   argument given to ktrace_export()
+ */
+typedef void (*ktrace_write_t)(const void *data, size_t len, void *arg);
+
+/**
+ * @brief   Start recording events
+ */
+void ktrace_start(void);
+
+/**
+ * @brief   Stop recording events
+ */
+void ktrace_stop(void);
+
+/**
+ * @brief   Discard all recorded events
+ */
+void ktrace_clear(void);
+
+/**
+ * @brief   Record an event
+ *
+ * Does nothing if recording is stopped. Can be called from ISRs.
+ *
+ * @param[in] event     the event
+ * @param[in] arg16     event specific argument
+ * @param[in] arg32     event specific argument
+ */
+void ktrace_record(ktrace_event_t event, uint16_t arg16, uint32_t arg32);
+
+/**
+ * @brief   Get the number of recorded events in the buffer
+ *
+ * @return  number of events that ktrace_export() would write
+ */
+unsigned ktrace_numof(void);
+
+/**
+ * @brief   Export the trace buffer in the binary format
+ *
+ * Recording should be stopped while exporting, otherwise the export may
+ * contain inconsistent entries.
+ *
+ * @param[in] write     called for each chunk of data
+ * @param[in] arg       argument passed to @p write
+ */
+void ktrace_export(ktrace_write_t write, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KTRACE_H */
+/** @} */
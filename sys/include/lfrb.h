@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_lfrb Lock-free ring buffers
+ * @ingroup     sys
+ * @brief       Lock-free byte ring buffers for single and multiple producers
+ *
+ * This module provides byte ring buffers that can be shared between threads
+ * and ISRs without disabling interrupts:
+ *
+ * - @ref lfrb_t is a single producer, single consumer (SPSC) ring buffer.
+ *   One context may write to it while another one reads from it.
+ * - @ref lfrb_mpsc_t is a multiple producer, single consumer (MPSC) ring
+ *   buffer. Any number of threads and ISRs may write to it concurrently,
+ *   each write being added as a whole or not at all. The single consumer
+ *   uses the @ref lfrb_t functions on lfrb_mpsc_t::rb.
+ *
+ * Bulk reads and writes copy at most two contiguous segments with memcpy().
+ * Additionally, the zero-copy functions lfrb_reserve() / lfrb_commit() and
+ * lfrb_peek_region() / lfrb_consume() give direct access to the buffer
+ * memory, e.g. for DMA or for parsers that work in place.
+ *
+ * The buffer size must be a power of two.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free ring buffer interface
+ */
+
+#ifndef LFRB_H
+#define LFRB_H
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Single producer, single consumer ring buffer
+ */
+typedef struct {
+    uint8_t *buf;               /**< Buffer to operate on */
+    unsigned size;              /**< Size of buf, must be a power of 2 */
+    atomic_uint reads;          /**< total number of bytes read */
+    atomic_uint writes;         /**< total number of bytes written */
+} lfrb_t;
+
+/**
+ * @brief   Multiple producer, single consumer ring buffer
+ */
+typedef struct {
+    lfrb_t rb;                  /**< ring buffer the consumer reads from */
+    atomic_uint reserved;       /**< total number of bytes reserved by
+                                     producers */
+    atomic_uint committed;      /**< total number of bytes written by
+                                     producers */
+} lfrb_mpsc_t;
+
+/**
+ * @brief   Static initializer for @ref lfrb_t
+ *
+ * @param[in] BUF   buffer to use, the size is deduced through `sizeof (BUF)`
+ */
+#define LFRB_INIT(BUF)          { (uint8_t *)(BUF), sizeof(BUF), \
+                                  ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(0) }
+
+/**
+ * @brief   Static initializer for @ref lfrb_mpsc_t
+ *
+ * @param[in] BUF   buffer to use, the size is deduced through `sizeof (BUF)`
+ */
+#define LFRB_MPSC_INIT(BUF)     { LFRB_INIT(BUF), \
+                                  ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(0) }
+
+/**
+ * @brief   Initialize a ring buffer
+ *
+ * @param[out] rb       ring buffer to initialize
+ * @param[in]  buf      buffer to use
+ * @param[in]  size     size of @p buf, must be a power of 2
+ */
+static inline void lfrb_init(lfrb_t *rb, void *buf, unsigned size)
+{
+    /* make sure size is a power of two */
+    assert((size != 0) && ((size & (size - 1)) == 0));
+
+    rb->buf = buf;
+    rb->size = size;
+    atomic_init(&rb->reads, 0);
+    atomic_init(&rb->writes, 0);
+}
+
+/**
+ * @brief   Initialize a multiple producer ring buffer
+ *
+ * @param[out] rb       ring buffer to initialize
+ * @param[in]  buf      buffer to use
+ * @param[in]  size     size of @p buf, must be a power of 2
+ */
+static inline void lfrb_mpsc_init(lfrb_mpsc_t *rb, void *buf, unsigned size)
+{
+    lfrb_init(&rb->rb, buf, size);
+    atomic_init(&rb->reserved, 0);
+    atomic_init(&rb->committed, 0);
+}
+
+/**
+ * @brief   Get the number of bytes available for reading
+ *
+ * @param[in] rb        ring buffer to operate on
+ *
+ * @return  number of bytes available
+ */
+static inline unsigned lfrb_avail(lfrb_t *rb)
+{
+    return atomic_load_explicit(&rb->writes, memory_order_acquire) -
+           atomic_load_explicit(&rb->reads, memory_order_relaxed);
+}
+
+/**
+ * @brief   Get the number of bytes that can be written
+ *
+ * @param[in] rb        ring buffer to operate on
+ *
+ * @return  number of free bytes
+ */
+static inline unsigned lfrb_free(lfrb_t *rb)
+{
+    return rb->size - (atomic_load_explicit(&rb->writes, memory_order_relaxed) -
+                       atomic_load_explicit(&rb->reads, memory_order_acquire));
+}
+
+/**
+ * @brief   Test if the ring buffer is empty
+ *
+ * @param[in] rb        ring buffer to operate on
+ *
+ * @return  0 if not empty
+ */
+static inline int lfrb_empty(lfrb_t *rb)
+{
+    return lfrb_avail(rb) == 0;
+}
+
+/**
+ * @brief   Test if the ring buffer is full
+ *
+ * @param[in] rb        ring buffer to operate on
+ *
+ * @return  0 if not full
+ */
+static inline int lfrb_full(lfrb_t *rb)
+{
+    return lfrb_free(rb) == 0;
+}
+
+/**
+ * @brief   Add bytes to the ring buffer
+ *
+ * Only as many bytes are added as there is space for.
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] src       bytes to add
+ * @param[in] n         number of bytes to add
+ *
+ * @return  number of bytes added
+ */
+size_t lfrb_add(lfrb_t *rb, const void *src, size_t n);
+
+/**
+ * @brief   Add a byte to the ring buffer
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] c         byte to add
+ *
+ * @return  0 on success
+ * @return  -1 if the buffer is full
+ */
+int lfrb_add_one(lfrb_t *rb, uint8_t c);
+
+/**
+ * @brief   Get and remove bytes from the ring buffer
+ *
+ * @param[in]  rb       ring buffer to operate on
+ * @param[out] dst      buffer to copy the bytes to
+ * @param[in]  n        maximum number of bytes to get
+ *
+ * @return  number of bytes copied to @p dst
+ */
+size_t lfrb_get(lfrb_t *rb, void *dst, size_t n);
+
+/**
+ * @brief   Get and remove a byte from the ring buffer
+ *
+ * @param[in] rb        ring buffer to operate on
+ *
+ * @return  the byte
+ * @return  -1 if the buffer is empty
+ */
+int lfrb_get_one(lfrb_t *rb);
+
+/**
+ * @brief   Get bytes from the ring buffer without removing them
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in]  rb       ring buffer to operate on
+ * @param[out] dst      buffer to copy the bytes to
+ * @param[in]  n        maximum number of bytes to get
+ *
+ * @return  number of bytes copied to @p dst
+ */
+size_t lfrb_peek(lfrb_t *rb, void *dst, size_t n);
+
+/**
+ * @brief   Remove bytes from the ring buffer
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] n         maximum number of bytes to remove
+ *
+ * @return  number of bytes removed
+ */
+size_t lfrb_drop(lfrb_t *rb, size_t n);
+
+/**
+ * @brief   Get the contiguous free region at the write position
+ *
+ * The producer may write up to the returned number of bytes to @p region and
+ * then make them available with lfrb_commit(). If the free space wraps
+ * around the end of the buffer, only the part up to the end is returned, the
+ * rest can be reserved after committing.
+ *
+ * @param[in]  rb       ring buffer to operate on
+ * @param[out] region   start of the free region
+ *
+ * @return  size of the free region
+ */
+size_t lfrb_reserve(lfrb_t *rb, void **region);
+
+/**
+ * @brief   Make bytes written to a reserved region available for reading
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] n         number of bytes written, at most the size returned by
+ *                      lfrb_reserve()
+ */
+void lfrb_commit(lfrb_t *rb, size_t n);
+
+/**
+ * @brief   Get the contiguous readable region at the read position
+ *
+ * The consumer may read up to the returned number of bytes from @p region
+ * and then release them with lfrb_consume(). If the data wraps around the
+ * end of the buffer, only the part up to the end is returned.
+ *
+ * @param[in]  rb       ring buffer to operate on
+ * @param[out] region   start of the readable region
+ *
+ * @return  size of the readable region
+ */
+size_t lfrb_peek_region(lfrb_t *rb, const void **region);
+
+/**
+ * @brief   Release bytes read from a region returned by lfrb_peek_region()
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] n         number of bytes to release, at most the size returned
+ *                      by lfrb_peek_region()
+ */
+void lfrb_consume(lfrb_t *rb, size_t n);
+
+/**
+ * @brief   Add bytes to a multiple producer ring buffer
+ *
+ * Can be called from any thread or ISR concurrently. Either all @p n bytes
+ * are added in one piece or none. The bytes become available for reading
+ * once all writes that started before have completed, too.
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] src       bytes to add
+ * @param[in] n         number of bytes to add
+ *
+ * @return  @p n on success
+ * @return  0 if there is not enough space
+ */
+size_t lfrb_mpsc_add(lfrb_mpsc_t *rb, const void *src, size_t n);
+
+/**
+ * @brief   Reserve space in a multiple producer ring buffer
+ *
+ * Can be called from any thread or ISR concurrently. The producer copies the
+ * bytes into the reserved space with lfrb_mpsc_write(), possibly in several
+ * pieces, and then makes them available with lfrb_mpsc_commit(). Every
+ * successful reservation must be committed, or the consumer stalls.
+ *
+ * @param[in]  rb       ring buffer to operate on
+ * @param[in]  n        number of bytes to reserve
+ * @param[out] pos      position of the reserved space
+ *
+ * @return  0 on success
+ * @return  -1 if there is not enough space
+ */
+int lfrb_mpsc_reserve(lfrb_mpsc_t *rb, size_t n, unsigned *pos);
+
+/**
+ * @brief   Copy bytes into space reserved with lfrb_mpsc_reserve()
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] pos       position to copy to, within the reserved space
+ * @param[in] src       bytes to copy
+ * @param[in] n         number of bytes to copy
+ */
+void lfrb_mpsc_write(lfrb_mpsc_t *rb, unsigned pos, const void *src, size_t n);
+
+/**
+ * @brief   Make bytes reserved with lfrb_mpsc_reserve() available for reading
+ *
+ * The bytes become available once all reservations made before have been
+ * committed, too.
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] n         number of bytes reserved
+ */
+void lfrb_mpsc_commit(lfrb_mpsc_t *rb, size_t n);
+
+/**
+ * @brief   Add a byte to a multiple producer ring buffer
+ *
+ * @param[in] rb        ring buffer to operate on
+ * @param[in] c         byte to add
+ *
+ * @return  0 on success
+ * @return  -1 if the buffer is full
+ */
+static inline int lfrb_mpsc_add_one(lfrb_mpsc_t *rb, uint8_t c)
+{
+    return lfrb_mpsc_add(rb, &c, 1) ? 0 : -1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LFRB_H */
+/** @} */
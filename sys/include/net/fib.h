@@ -11,6 +11,16 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default, every lookup scans the whole table and expires outdated
+ * entries on the way. With the `fib_radix` pseudomodule, single hop tables
+ * are indexed by a radix tree instead, so a lookup only visits the entries
+ * on the path of the destination address. The entries are also kept in a
+ * min-heap ordered by their lifetime and a timer marks the table once the
+ * earliest one expired. Outdated entries are then removed by the next call
+ * to the FIB, so lookups no longer need to read the current time. The tree
+ * and the heap are stored inside the entries, at the cost of about 40 bytes
+ * of RAM per entry on 32-bit platforms.
+ *
  * @{
  *
  * @file
@@ -24,6 +24,9 @@
 #include "kernel_types.h"
 #include "universal_address.h"
 #include "mutex.h"
+#ifdef MODULE_FIB_RADIX
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,10 +38,27 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+/**
+ * @brief Node of the radix tree indexing a FIB table
+ *
+ * A node is either the node of an entry or a branching node that only
+ * splits the tree at fib_radix_node_t::len. Branching nodes are stored in
+ * the spare node of any entry that is currently in use.
+ */
+typedef struct fib_radix_node {
+    struct fib_radix_node *child[2];    /**< sub trees by the next bit */
+    struct fib_radix_node *parent;      /**< parent node, for duplicates the
+                                             node of the first entry */
+    uint8_t len;                        /**< prefix length in bits */
+    uint8_t flags;                      /**< node state (internal) */
+} fib_radix_node_t;
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +71,18 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** radix tree node of this entry */
+    fib_radix_node_t node;
+    /** spare node, may hold any branching node of the radix tree */
+    fib_radix_node_t glue;
+    /** next entry with the same prefix */
+    struct fib_entry *dup;
+    /** index of the entry at the heap position equal to this entry's index */
+    uint16_t heap_slot;
+    /** position of this entry in the lifetime heap + 1, 0 if not in it */
+    uint16_t heap_pos;
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +165,18 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** root of the radix tree over the single hop entries */
+    fib_radix_node_t *radix_root;
+    /** timer firing when the earliest entry in the heap expires */
+    xtimer_t expiry_timer;
+    /** absolute expiry time the timer is set for */
+    uint64_t expiry_time;
+    /** number of entries in the lifetime heap */
+    uint16_t heap_numof;
+    /** set by the timer when entries expired */
+    volatile uint8_t expired;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
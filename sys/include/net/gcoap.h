@@ -583,14 +583,17 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len, const ipv6_addr_t *addr,
  * @brief   Initializes a CoAP response packet on a buffer
  *
  * Initializes payload location within the buffer based on packet setup.
+ * The request may reside in another buffer than @p buf, e.g. the packet
+ * buffer of the network stack. Its header and token are copied to @p buf
+ * then, its options and payload are no longer accessible through @p pdu.
  *
- * @param[out] pdu      Response metadata
- * @param[in] buf       Buffer containing the PDU
+ * @param[in,out] pdu   Request metadata, response metadata on return
+ * @param[in] buf       Buffer for the response PDU
  * @param[in] len       Length of the buffer
  * @param[in] code      Response code
  *
  * @return  0 on success
- * @return  < 0 on error
+ * @return  -ENOSPC, if @p buf can not hold the header of the response
  */
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code);
 
@@ -205,6 +205,24 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD (0)
 #endif
+
+/**
+ * @brief   Index the NIB for faster lookups
+ *
+ * Keeps a path-compressed binary trie over the off-link entries for the
+ * longest prefix match on forwarding and a hash table over the on-link
+ * entries. Both refer to the entries in their static pools, so the lookups
+ * do not grow linearly with @ref GNRC_IPV6_NIB_OFFL_NUMOF and
+ * @ref GNRC_IPV6_NIB_NUMOF anymore, at the cost of about 50 bytes of RAM
+ * per off-link and 6 bytes per on-link entry.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_INDEX
+#if GNRC_IPV6_NIB_CONF_6LBR
+#define GNRC_IPV6_NIB_CONF_INDEX        (1)
+#else
+#define GNRC_IPV6_NIB_CONF_INDEX        (0)
+#endif
+#endif
 /** @} */
 
 /**
@@ -54,6 +54,37 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_direct   Direct dispatch
+ * @ingroup     net_gnrc_netapi
+ * @brief       Run-to-completion receive path for @ref net_gnrc_netapi
+ * @{
+ * @details The submodule `gnrc_netapi_direct` makes @ref net_gnrc_sixlowpan,
+ *          @ref net_gnrc_ipv6 (including @ref net_gnrc_icmpv6) and
+ *          @ref net_gnrc_udp register @ref net_gnrc_netapi_callbacks
+ *          "callbacks" instead of their threads. A received packet is then
+ *          handled by plain function calls in the thread of the network
+ *          interface that received it, up to the final receiver (e.g. the
+ *          mailbox of a @ref net_sock_udp "sock"), saving a context switch
+ *          and a message per layer.
+ *
+ * The threads of these modules still exist: Packets to send or to forward,
+ * as well as work that may have to wait, like 6LoWPAN fragmentation and
+ * reassembly or address resolution, are deferred to them through their
+ * message queues. Received neighbor discovery messages are still handled in
+ * the interface thread, which briefly locks the neighbor information base
+ * for that.
+ *
+ * As the network interface threads run the whole receive path, their stacks
+ * need to be large enough for it.
+ *
+ * To use, add the module `gnrc_netapi_direct` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_direct
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
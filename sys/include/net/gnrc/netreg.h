@@ -10,6 +10,12 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default, the entries of every protocol type are kept in a list that
+ * has to be searched for the demultiplexing context. With the
+ * `gnrc_netreg_hash` module, entries are kept in a hash table keyed by
+ * protocol type and demultiplexing context instead, so a lookup does not get
+ * slower with the number of registered entries, e.g. UDP ports.
  * @{
  *
  * @file
@@ -72,6 +78,15 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of buckets of the hash table with `gnrc_netreg_hash`
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (16U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -79,6 +94,16 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @internal
+ * @brief   Initializer for the fields following gnrc_netreg_entry_t::target
+ */
+#ifdef MODULE_GNRC_NETREG_HASH
+#define GNRC_NETREG_ENTRY_INIT_TAIL     , GNRC_NETTYPE_UNDEF
+#else
+#define GNRC_NETREG_ENTRY_INIT_TAIL
+#endif
+
 /**
  * @name    Static entry initialization macros
  * @anchor  net_gnrc_netreg_init_static
@@ -96,9 +121,11 @@ typedef enum {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_TAIL }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_TAIL }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +142,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = mbox } }
+                                                       { .mbox = mbox } \
+                                                       GNRC_NETREG_ENTRY_INIT_TAIL }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -132,7 +160,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = cbd } }
+                                                      { .cbd = cbd } \
+                                                      GNRC_NETREG_ENTRY_INIT_TAIL }
 /** @} */
 
 /**
@@ -210,6 +239,16 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+#if defined(MODULE_GNRC_NETREG_HASH) || defined(DOXYGEN)
+    /**
+     * @brief   Type of the protocol the entry is registered for
+     *
+     * @note    Only available with `gnrc_netreg_hash`.
+     *
+     * @internal
+     */
+    gnrc_nettype_t nettype;
+#endif
 } gnrc_netreg_entry_t;
 
 /**
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pcap Capture Network Packets
+ * @ingroup     net_gnrc
+ * @brief       Capture frames of GNRC network interfaces into a pcapng file
+ *
+ * Unlike @ref net_gnrc_pktdump, this module does not print anything and
+ * barely changes the timing of the stack, so it can stay enabled in long
+ * running tests. The Ethernet and IEEE 802.15.4 network interfaces copy the
+ * first @ref GNRC_PCAP_SNAPLEN bytes of every frame they send or receive into
+ * a lock-free ring buffer (see @ref sys_lfrb), so capturing neither blocks
+ * nor disables interrupts for the copy. A low priority thread writes the frames
+ * to @ref GNRC_PCAP_FILE in the pcapng format, with one interface description
+ * per network interface. On native, the file is created on the host, on
+ * other platforms it is opened via @ref sys_vfs.
+ *
+ * Frames are dropped from the capture (not from the stack) when the thread
+ * does not keep up, see @ref gnrc_pcap_get_stats().
+ *
+ * Open the file with e.g. Wireshark or `tcpdump -r`.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Interface for capturing frames into a pcapng file
+ */
+#ifndef NET_GNRC_PCAP_H
+#define NET_GNRC_PCAP_H
+
+#include <stdint.h>
+
+#include "iolist.h"
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer for captured frames in bytes
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_PCAP_BUF_SIZE
+#define GNRC_PCAP_BUF_SIZE              (4096U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes captured per frame
+ */
+#ifndef GNRC_PCAP_SNAPLEN
+#define GNRC_PCAP_SNAPLEN               (256U)
+#endif
+
+/**
+ * @brief   Priority of the capture thread
+ */
+#ifndef GNRC_PCAP_PRIO
+#define GNRC_PCAP_PRIO                  (THREAD_PRIORITY_MIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the capture thread
+ */
+#ifndef GNRC_PCAP_STACKSIZE
+#define GNRC_PCAP_STACKSIZE             (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   File the frames are written to
+ *
+ * On native, the path is relative to the working directory on the host. On
+ * other platforms it must be on a mounted file system.
+ */
+#ifndef GNRC_PCAP_FILE
+#define GNRC_PCAP_FILE                  "riot.pcapng"
+#endif
+
+/**
+ * @name    Link types of captured frames
+ * @see     http://www.tcpdump.org/linktypes.html
+ * @{
+ */
+#define GNRC_PCAP_LINKTYPE_ETHERNET             (1U)    /**< Ethernet */
+#define GNRC_PCAP_LINKTYPE_IEEE802_15_4_NOFCS   (230U)  /**< IEEE 802.15.4
+                                                         *   without FCS */
+/** @} */
+
+/**
+ * @brief   Direction of a captured frame
+ */
+typedef enum {
+    GNRC_PCAP_RX = 1,   /**< received frame */
+    GNRC_PCAP_TX = 2,   /**< sent frame */
+} gnrc_pcap_dir_t;
+
+/**
+ * @brief   Capture statistics
+ */
+typedef struct {
+    uint32_t captured;  /**< frames put into the ring buffer */
+    uint32_t dropped;   /**< frames not captured since the buffer was full */
+    uint32_t written;   /**< frames written to the file */
+} gnrc_pcap_stats_t;
+
+/**
+ * @brief   Starts the capture thread
+ *
+ * @return  PID of the capture thread
+ * @return  negative value on error
+ */
+kernel_pid_t gnrc_pcap_init(void);
+
+/**
+ * @brief   Captures a frame
+ *
+ * Called by the network interfaces, copies at most @ref GNRC_PCAP_SNAPLEN
+ * bytes of @p frame. May be called from several threads.
+ *
+ * @param[in] netif     PID of the network interface
+ * @param[in] linktype  Link type of the frame, e.g.
+ *                      @ref GNRC_PCAP_LINKTYPE_ETHERNET
+ * @param[in] dir       Direction of the frame
+ * @param[in] frame     The frame as it is sent or received by the device
+ */
+void gnrc_pcap_capture(kernel_pid_t netif, uint16_t linktype,
+                       gnrc_pcap_dir_t dir, const iolist_t *frame);
+
+/**
+ * @brief   Gets the capture statistics
+ *
+ * @param[out] stats    The statistics
+ */
+void gnrc_pcap_get_stats(gnrc_pcap_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PCAP_H */
+/** @} */
@@ -58,6 +58,48 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Size classes of the slab packet buffer
+ *
+ * The `gnrc_pktbuf_slab` implementation allocates packet snips and their data
+ * from pools of fixed size blocks. Snips have a pool of their own, data is put
+ * into the smallest block it fits in, or into a larger one if all blocks of
+ * that size are taken. Data larger than @ref GNRC_PKTBUF_SLAB_LARGE_SIZE can't
+ * be allocated. Freeing a block and allocating one from a pool take a constant
+ * time and never fail due to fragmentation.
+ *
+ * The pools take
+ * `GNRC_PKTBUF_SLAB_SNIP_NUMOF * sizeof(gnrc_pktsnip_t) + sum(NUMOF * (SIZE + 1))`
+ * bytes, with all sizes rounded up to multiples of 8 bytes. With the defaults
+ * this is 6128 bytes on 32-bit platforms (24 bytes per snip), so the buffer
+ * fits into the 6 KiB of the default @ref GNRC_PKTBUF_SIZE: three full
+ * Ethernet frames or IPv6 packets of minimum MTU can be held at the same time,
+ * the small and medium blocks take headers and IEEE 802.15.4 frames.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (20U)   /**< number of packet snips */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (64U)   /**< size of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    (10U)   /**< number of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_SIZE
+#define GNRC_PKTBUF_SLAB_MEDIUM_SIZE    (128U)  /**< size of medium blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define GNRC_PKTBUF_SLAB_MEDIUM_NUMOF   (3U)    /**< number of medium blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1536U) /**< size of large blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define GNRC_PKTBUF_SLAB_LARGE_NUMOF    (3U)    /**< number of large blocks */
+#endif
+/** @} */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -358,7 +400,10 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. The slab
+ *          implementation prints the usage, high-water mark, number of
+ *          failed allocations and number of allocations that had to use a
+ *          larger block for each of its size classes.
  */
 void gnrc_pktbuf_stats(void);
 #endif
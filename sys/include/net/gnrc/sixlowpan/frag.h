@@ -52,6 +52,12 @@ extern "C" {
  * @brief   Message type for triggering garbage collection reassembly buffer
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
+
+/**
+ * @brief   Message type for the retransmission timeout of
+ *          @ref net_gnrc_sixlowpan_frag_sfr
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ     (0x0227)
 /** @} */
 
 /**
@@ -120,6 +126,13 @@ gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
  */
 void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+/**
+ * @brief   Generates a new datagram tag for outgoing fragments
+ *
+ * @return  The new datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Handles a packet containing a fragment header
  *
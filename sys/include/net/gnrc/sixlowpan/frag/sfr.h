@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr   Selective fragment recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Recoverable 6LoWPAN fragments with per-fragment
+ *              retransmission
+ *
+ * With this module, datagrams that do not fit a single frame are sent as
+ * recoverable fragments (RFRAG) instead of the FRAG1/FRAGN fragments of
+ * RFC 4944. All fragments of a datagram are handed to the interface in one
+ * go, the last one requesting an acknowledgment. The receiver answers with
+ * an RFRAG-ACK carrying a bitmap of the fragments it received, so only the
+ * missing fragments are sent again, instead of the whole datagram after the
+ * reassembly timed out.
+ *
+ * The fragments are kept in the fragmentation buffer until the datagram is
+ * acknowledged completely, the receiver aborts it or no acknowledgment
+ * arrives after @ref GNRC_SIXLOWPAN_FRAG_SFR_RETRIES retransmissions. If the
+ * fragmentation buffer is full or the datagram needs more than 32
+ * fragments, the datagram is fragmented as per RFC 4944.
+ *
+ * Recovery happens hop by hop: every node on the path needs this module and
+ * reassembles the datagram, even with @ref net_gnrc_sixlowpan_frag_vrb.
+ *
+ * @see [RFC 8931](https://tools.ietf.org/html/rfc8931)
+ * @{
+ *
+ * @file
+ * @brief   Selective fragment recovery definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "msg.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of datagrams that can be in transmission at the same time
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_FB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_SFR_FB_SIZE     (2U)
+#endif
+
+/**
+ * @brief   Time in microseconds to wait for an RFRAG-ACK before the
+ *          unacknowledged fragments are sent again
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT (500U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Number of retransmissions of a datagram before it is given up
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RETRIES
+#define GNRC_SIXLOWPAN_FRAG_SFR_RETRIES     (3U)
+#endif
+
+/**
+ * @brief   Number of reassembled datagrams to remember, so fragments
+ *          retransmitted after a lost RFRAG-ACK are acknowledged again
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RECENT_SIZE
+#define GNRC_SIXLOWPAN_FRAG_SFR_RECENT_SIZE (2U)
+#endif
+
+/**
+ * @brief   An entry in the fragmentation buffer
+ */
+typedef struct {
+    /**
+     * @brief   The compressed datagram with its @ref gnrc_netif_hdr_t, NULL
+     *          if the entry is unused
+     */
+    gnrc_pktsnip_t *pkt;
+    xtimer_t arq_timer;         /**< retransmission timer */
+    msg_t arq_msg;              /**< message for gnrc_sixlowpan_frag_sfr_fb_t::arq_timer */
+    uint32_t acked;             /**< bitmap of acknowledged fragments */
+    uint16_t datagram_size;     /**< size of the uncompressed datagram */
+    uint16_t frag_size;         /**< payload size of all but the last
+                                 *   fragment */
+    uint8_t tag;                /**< datagram tag */
+    uint8_t frags;              /**< number of fragments */
+    uint8_t retries;            /**< retransmissions so far */
+} gnrc_sixlowpan_frag_sfr_fb_t;
+
+/**
+ * @brief   Sends a datagram as recoverable fragments
+ *
+ * @pre `(pkt != NULL) && (netif != NULL)`
+ *
+ * @param[in] pkt                   The compressed datagram with a
+ *                                  @ref gnrc_netif_hdr_t in send order.
+ * @param[in] orig_datagram_size    Size of the uncompressed datagram.
+ * @param[in] netif                 The interface to send over.
+ *
+ * @return  true, if @p pkt is sent. It is released when the transmission
+ *          ends.
+ * @return  false, if @p pkt can not be sent as recoverable fragments. The
+ *          caller keeps @p pkt then.
+ */
+bool gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt,
+                                  size_t orig_datagram_size,
+                                  gnrc_netif_t *netif);
+
+/**
+ * @brief   Handles a packet containing an RFRAG or RFRAG-ACK header
+ *
+ * @param[in] pkt       The packet to handle.
+ * @param[in] ctx       Context for the packet. May be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles the retransmission timeout of a datagram
+ *
+ * Timeouts for datagrams that were acknowledged or retransmitted since the
+ * timer was set are ignored.
+ *
+ * @param[in] arq_id    The value carried by a
+ *                      @ref GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ message.
+ */
+void gnrc_sixlowpan_frag_sfr_arq_timeout(uint32_t arq_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_vrb   Virtual reassembly buffer
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Fragment forwarding for 6LoWPAN routers
+ *
+ * Without this module a 6LR reassembles every fragmented datagram it
+ * forwards and fragments it again for the next hop. With it, the router only
+ * decompresses the first fragment of a datagram to look up the next hop. If
+ * there is one, it remembers the next hop together with a new datagram tag
+ * in the virtual reassembly buffer (VRB), forwards the first fragment right
+ * away and then forwards every subsequent fragment as soon as it arrives,
+ * only exchanging datagram tag and link-layer header.
+ *
+ * The datagram is reassembled as before, if
+ *
+ * - it is addressed to this node, to a multicast address or to or from a
+ *   link-local address,
+ * - the hop limit would expire on this hop,
+ * - fragments other than the first arrived first, or
+ * - there is no usable next hop in the NIB yet (e.g. address resolution
+ *   still needs to be done).
+ *
+ * Entries are looked up by the link-layer source address and the datagram
+ * tag of the incoming fragments via a hash table.
+ *
+ * @see [draft-ietf-6lo-minimal-fragment](https://tools.ietf.org/html/draft-ietf-6lo-minimal-fragment)
+ * @{
+ *
+ * @file
+ * @brief   Virtual reassembly buffer definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+#define NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ieee802154.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the virtual reassembly buffer
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Number of hash buckets used to index the virtual reassembly buffer
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_BUCKETS
+#define GNRC_SIXLOWPAN_FRAG_VRB_BUCKETS     ((GNRC_SIXLOWPAN_FRAG_VRB_SIZE / 2) + 1)
+#endif
+
+/**
+ * @brief   Time in microseconds after the last fragment of a datagram after
+ *          which its entry is removed
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT     (3U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Maximum number of disjoint byte ranges of a datagram tracked per
+ *          entry
+ *
+ * Fragments forwarded out of order leave gaps between the ranges. If more
+ * gaps than this appear, the entry is only removed on timeout.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_INT_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_INT_SIZE    (3U)
+#endif
+
+/**
+ * @brief   A range of bytes of the uncompressed datagram forwarded already
+ */
+typedef struct {
+    uint16_t start;             /**< offset of the first byte */
+    uint16_t end;               /**< offset of the byte after the last one */
+} gnrc_sixlowpan_frag_vrb_int_t;
+
+/**
+ * @brief   An entry in the virtual reassembly buffer
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];       /**< link-layer source
+                                                     *   address of the
+                                                     *   incoming fragments */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];   /**< link-layer address
+                                                     *   of the next hop */
+    uint32_t arrival;           /**< time in microseconds of arrival of the
+                                 *   last fragment */
+    uint16_t datagram_size;     /**< size of the uncompressed datagram */
+    uint16_t tag;               /**< datagram tag of the incoming fragments */
+    uint16_t out_tag;           /**< datagram tag of the outgoing fragments */
+    /**
+     * @brief   byte ranges of the uncompressed datagram forwarded so far,
+     *          sorted by offset
+     */
+    gnrc_sixlowpan_frag_vrb_int_t ints[GNRC_SIXLOWPAN_FRAG_VRB_INT_SIZE];
+    kernel_pid_t out_netif;     /**< interface to the next hop */
+    uint8_t src_len;            /**< length of gnrc_sixlowpan_frag_vrb_t::src,
+                                 *   0 if the entry is unused */
+    uint8_t out_dst_len;        /**< length of
+                                 *   gnrc_sixlowpan_frag_vrb_t::out_dst */
+    uint8_t ints_num;           /**< number of ranges in
+                                 *   gnrc_sixlowpan_frag_vrb_t::ints, UINT8_MAX
+                                 *   if they did not fit */
+} gnrc_sixlowpan_frag_vrb_t;
+
+/**
+ * @brief   Adds an entry to the virtual reassembly buffer
+ *
+ * If the buffer is full, the oldest entry is replaced.
+ *
+ * @param[in] src           Link-layer source address of the incoming
+ *                          fragments.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] tag           Datagram tag of the incoming fragments.
+ * @param[in] datagram_size Size of the uncompressed datagram.
+ * @param[in] out_netif     Interface to the next hop.
+ * @param[in] out_dst       Link-layer address of the next hop.
+ * @param[in] out_dst_len   Length of @p out_dst.
+ *
+ * @return  The new entry with a new outgoing datagram tag.
+ * @return  NULL, if @p src_len or @p out_dst_len are too long.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t tag,
+                                                       uint16_t datagram_size,
+                                                       kernel_pid_t out_netif,
+                                                       const uint8_t *out_dst,
+                                                       size_t out_dst_len);
+
+/**
+ * @brief   Gets the entry for the fragments of a datagram
+ *
+ * @param[in] src           Link-layer source address of the fragment.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] tag           Datagram tag of the fragment.
+ * @param[in] datagram_size Datagram size of the fragment.
+ *
+ * @return  The entry for the datagram.
+ * @return  NULL, if there is no (unexpired) entry for the datagram.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t tag,
+                                                       uint16_t datagram_size);
+
+/**
+ * @brief   Removes an entry from the virtual reassembly buffer
+ *
+ * @pre `vrbe != NULL`
+ *
+ * @param[in] vrbe  An entry of the virtual reassembly buffer.
+ */
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrbe);
+
+/**
+ * @brief   Removes timed out entries from the virtual reassembly buffer
+ */
+void gnrc_sixlowpan_frag_vrb_gc(void);
+
+/**
+ * @brief   Starts forwarding a datagram of which only the first fragment
+ *          was received so far
+ *
+ * Called by @ref net_gnrc_sixlowpan_iphc after the first fragment was
+ * decompressed into @p rbuf. If the datagram can be forwarded fragment by
+ * fragment, a new entry is added, the first fragment is sent to the next hop
+ * and @p rbuf is removed.
+ *
+ * @pre `rbuf != NULL`
+ *
+ * @param[in] rbuf      Reassembly buffer entry of the datagram.
+ * @param[in] frag_len  Number of bytes of the uncompressed datagram carried
+ *                      by the first fragment.
+ *
+ * @return  true, if the datagram is forwarded. @p rbuf is removed then.
+ * @return  false, if the datagram needs to be reassembled.
+ */
+bool gnrc_sixlowpan_frag_vrb_forward_1st(gnrc_sixlowpan_rbuf_t *rbuf,
+                                         size_t frag_len);
+
+/**
+ * @brief   Sends the compressed first fragment of a forwarded datagram
+ *
+ * Called by @ref net_gnrc_sixlowpan_iphc instead of fragmenting the packet.
+ * If the compressed headers grew, so the fragment does not fit the frame
+ * anymore, its tail is sent in a subsequent fragment.
+ *
+ * @pre `(pkt != NULL) && (vrbe != NULL)`
+ *
+ * @param[in] pkt       The compressed first fragment with a
+ *                      @ref gnrc_netif_hdr_t in send order.
+ * @param[in] vrbe      Entry of the datagram.
+ * @param[in] frag_len  Number of bytes of the uncompressed datagram carried
+ *                      by @p pkt.
+ */
+void gnrc_sixlowpan_frag_vrb_send_1st(gnrc_pktsnip_t *pkt,
+                                      gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                      size_t frag_len);
+
+/**
+ * @brief   Forwards a subsequent fragment of a datagram
+ *
+ * @p vrbe is removed once every byte of the datagram was forwarded.
+ * Duplicate or retransmitted fragments are forwarded again, but do not count
+ * towards that.
+ *
+ * @pre `(pkt != NULL) && (vrbe != NULL)`
+ *
+ * @param[in] pkt   A received subsequent fragment in receive order.
+ * @param[in] vrbe  Entry of the datagram.
+ */
+void gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt,
+                                     gnrc_sixlowpan_frag_vrb_t *vrbe);
+
+/**
+ * @brief   Gets the number of fragments forwarded without reassembly
+ *
+ * @return  Number of fragments sent to the next hop since start-up.
+ */
+uint32_t gnrc_sixlowpan_frag_vrb_forwarded(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_VRB_H */
+/** @} */
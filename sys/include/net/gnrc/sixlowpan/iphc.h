@@ -51,7 +51,10 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  *
  * @param[in] pkt   A 6LoWPAN frame with an uncompressed IPv6 header to send.
  *                  Will be translated to an 6LoWPAN IPHC frame.
- * @param[in] ctx   Context for the packet. May be NULL.
+ * @param[in] ctx   Context for the packet. May be NULL. With
+ *                  @ref net_gnrc_sixlowpan_frag_vrb a
+ *                  @ref gnrc_sixlowpan_frag_vrb_t, if @p pkt is the first
+ *                  fragment of a forwarded datagram.
  * @param[in] page  Current 6Lo dispatch parsing page.
  *
  */
@@ -55,13 +55,24 @@ extern "C" {
 
 /**
  * @brief MSS Multiplicator = Number of MSS sized packets stored in receive buffer
+ *
+ * The peer can not send more than the receive window per round trip. With a
+ * single segment in flight, the peer's send queue, congestion control and fast
+ * retransmit never come into play, so the default allows as many segments as
+ * @ref GNRC_TCP_SND_QUEUE_SIZE keeps in flight on the sending side.
+ *
+ * @note Each receive buffer occupies GNRC_TCP_MSS * GNRC_TCP_MSS_MULTIPLICATOR
+ *       bytes of RAM (4880 bytes with IPv6). Set this to 1 on boards short of
+ *       memory, at the cost of one segment per round trip.
  */
 #ifndef GNRC_TCP_MSS_MULTIPLICATOR
-#define GNRC_TCP_MSS_MULTIPLICATOR (1U)
+#define GNRC_TCP_MSS_MULTIPLICATOR (4U)
 #endif
 
 /**
  * @brief Default receive window size
+ *
+ * @note Window scaling is not supported, the window must not exceed 65535 bytes.
  */
 #ifndef GNRC_TCP_DEFAULT_WINDOW
 #define GNRC_TCP_DEFAULT_WINDOW (GNRC_TCP_MSS * GNRC_TCP_MSS_MULTIPLICATOR)
@@ -81,6 +92,37 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Number of segments in the send queue of a connection
+ *
+ * Sent segments stay in the send queue until they are acknowledged, this is
+ * the upper bound for the segments in flight. One entry is kept free for the
+ * FIN, so this value must be at least 2. Each queued segment occupies its size
+ * in the packet buffer. A fast retransmit needs at least
+ * @ref GNRC_TCP_DUP_ACK_THRESHOLD segments in flight behind a lost one, below
+ * that losses are only recovered by the retransmission timeout.
+ */
+#ifndef GNRC_TCP_SND_QUEUE_SIZE
+#define GNRC_TCP_SND_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Number of out-of-order segments a connection keeps
+ *
+ * Segments that arrive ahead of missing data are kept in the packet buffer
+ * until the gap is filled, instead of being dropped.
+ */
+#ifndef GNRC_TCP_RCV_OOO_SIZE
+#define GNRC_TCP_RCV_OOO_SIZE (2U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
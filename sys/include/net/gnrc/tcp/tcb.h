@@ -45,6 +45,16 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Segment in the send queue or the out-of-order queue of a TCB.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< Packet holding the segment, NULL if the entry is unused */
+    uint32_t seq;          /**< Sequence number of the segment */
+    uint16_t len;          /**< Sequence number consumption of the segment */
+    uint8_t flags;         /**< Retransmission state of a sent segment */
+} gnrc_tcp_seg_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -73,10 +83,18 @@ typedef struct _transmission_control_block {
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
+    uint32_t rtt_seq;      /**< Sequence number that ends the running rtt measurement */
     uint8_t retries;       /**< Number of retransmissions */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest sequence number sent on entering fast recovery */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_tcp_seg_t snd_queue[GNRC_TCP_SND_QUEUE_SIZE];   /**< Sent, unacknowledged segments */
+    uint8_t snd_queue_head;   /**< Index of the oldest segment in snd_queue */
+    uint8_t snd_queue_len;    /**< Number of segments in snd_queue */
+    gnrc_tcp_seg_t rcv_ooo[GNRC_TCP_RCV_OOO_SIZE];   /**< Out-of-order received segments */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
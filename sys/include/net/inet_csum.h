@@ -73,6 +73,58 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum after a part of its domain changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Allows to adapt a checksum to rewritten header fields (e.g. an
+ *          address) without summing up the whole domain again.
+ *
+ * @pre     @p old_buf and @p new_buf start at an even offset within the
+ *          checksum domain.
+ *
+ * @param[in] csum      The checksum as found in the header, i.e. the 1's
+ *                      complement of the Internet Checksum, in host byte order.
+ * @param[in] old_buf   The old content of the changed part.
+ * @param[in] new_buf   The new content of the changed part.
+ * @param[in] len       Length of @p old_buf and @p new_buf in byte.
+ *
+ * @return  The checksum to write back into the header, in host byte order.
+ *          A protocol that reserves 0 for "no checksum" (e.g. UDP) needs to
+ *          map a resulting 0 to 0xffff itself.
+ */
+uint16_t inet_csum_update_buf(uint16_t csum, const uint8_t *old_buf,
+                              const uint8_t *new_buf, uint16_t len);
+
+/**
+ * @brief   Updates an Internet Checksum after a 16-bit word of its domain
+ *          changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @param[in] csum      The checksum as found in the header, i.e. the 1's
+ *                      complement of the Internet Checksum, in host byte order.
+ * @param[in] old_word  The old value of the word, in host byte order.
+ * @param[in] new_word  The new value of the word, in host byte order.
+ *
+ * @return  The checksum to write back into the header, in host byte order.
+ */
+static inline uint16_t inet_csum_update(uint16_t csum, uint16_t old_word,
+                                        uint16_t new_word)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum + (uint32_t)(uint16_t)~old_word + new_word;
+
+    sum = (sum >> 16) + (sum & 0xffff);
+    sum = (sum >> 16) + (sum & 0xffff);
+    return ~sum;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -141,6 +141,171 @@ static inline bool sixlowpan_frag_is(sixlowpan_frag_t *hdr)
 }
 /** @} */
 
+/**
+ * @name    6LoWPAN selective fragment recovery header definitions
+ * @see     <a href="https://tools.ietf.org/html/rfc8931#section-5">
+ *              RFC 8931, section 5
+ *          </a>
+ * @{
+ */
+#define SIXLOWPAN_SFR_DISP_MASK     (0xfe)      /**< mask for SFR dispatches */
+#define SIXLOWPAN_SFR_RFRAG_DISP    (0xe8)      /**< dispatch for RFRAG */
+#define SIXLOWPAN_SFR_ACK_DISP      (0xea)      /**< dispatch for RFRAG-ACK */
+#define SIXLOWPAN_SFR_ECN           (0x01)      /**< explicit congestion
+                                                 *   notification flag */
+#define SIXLOWPAN_SFR_ACK_REQ       (0x8000)    /**< acknowledgment request
+                                                 *   flag */
+#define SIXLOWPAN_SFR_SEQ_MASK      (0x7c00)    /**< mask for sequence number */
+#define SIXLOWPAN_SFR_SEQ_POS       (10U)       /**< position of sequence
+                                                 *   number */
+#define SIXLOWPAN_SFR_SEQ_MAX       (31U)       /**< maximum sequence number */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MASK    (0x03ff)    /**< mask for fragment
+                                                     *   size */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MAX     (1023U)     /**< maximum fragment
+                                                     *   size */
+/**
+ * @brief   FULL bitmap of an RFRAG-ACK, acknowledging the reception of the
+ *          complete datagram
+ */
+#define SIXLOWPAN_SFR_ACK_BITMAP_FULL   (0xffffffffUL)
+
+/**
+ * @brief   Recoverable fragment (RFRAG) header
+ *
+ * @note    Like the FRAG1 header of RFC 4944, the first fragment carries the
+ *          size of the uncompressed datagram in
+ *          sixlowpan_sfr_rfrag_t::offset.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;                   /**< dispatch and ECN flag */
+    uint8_t tag;                        /**< datagram tag */
+    /**
+     * @brief   Acknowledgment request flag, sequence number and fragment size
+     */
+    network_uint16_t ar_seq_size;
+    /**
+     * @brief   Offset of the fragment in the compressed datagram, or the
+     *          datagram size for the first fragment
+     */
+    network_uint16_t offset;
+} sixlowpan_sfr_rfrag_t;
+
+/**
+ * @brief   RFRAG acknowledgment (RFRAG-ACK) header
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;                   /**< dispatch and ECN flag */
+    uint8_t tag;                        /**< datagram tag */
+    /**
+     * @brief   Bitmap of the received fragments, the most significant bit
+     *          representing the fragment with sequence number 0
+     */
+    network_uint32_t bitmap;
+} sixlowpan_sfr_ack_t;
+
+/**
+ * @brief   Checks if a given header is an RFRAG header.
+ *
+ * @param[in] hdr   A 6LoWPAN header. Must not be NULL.
+ *
+ * @return  true, if @p hdr is an RFRAG header.
+ * @return  false, if @p hdr is not an RFRAG header.
+ */
+static inline bool sixlowpan_sfr_rfrag_is(const uint8_t *hdr)
+{
+    return ((hdr[0] & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_RFRAG_DISP);
+}
+
+/**
+ * @brief   Checks if a given header is an RFRAG-ACK header.
+ *
+ * @param[in] hdr   A 6LoWPAN header. Must not be NULL.
+ *
+ * @return  true, if @p hdr is an RFRAG-ACK header.
+ * @return  false, if @p hdr is not an RFRAG-ACK header.
+ */
+static inline bool sixlowpan_sfr_ack_is(const uint8_t *hdr)
+{
+    return ((hdr[0] & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_ACK_DISP);
+}
+
+/**
+ * @brief   Checks if a given header is an RFRAG or RFRAG-ACK header.
+ *
+ * @param[in] hdr   A 6LoWPAN header. Must not be NULL.
+ *
+ * @return  true, if @p hdr is a selective fragment recovery header.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_is(const uint8_t *hdr)
+{
+    return sixlowpan_sfr_rfrag_is(hdr) || sixlowpan_sfr_ack_is(hdr);
+}
+
+/**
+ * @brief   Initializes an RFRAG header
+ *
+ * @param[out] hdr      An RFRAG header. Must not be NULL.
+ * @param[in] tag       The datagram tag.
+ * @param[in] seq       The sequence number of the fragment.
+ * @param[in] size      The size of the fragment's payload.
+ * @param[in] offset    The offset of the fragment in the compressed
+ *                      datagram, or the datagram size if @p seq is 0.
+ * @param[in] ack_req   Request an RFRAG-ACK for this fragment.
+ */
+static inline void sixlowpan_sfr_rfrag_set(sixlowpan_sfr_rfrag_t *hdr,
+                                           uint8_t tag, unsigned seq,
+                                           uint16_t size, uint16_t offset,
+                                           bool ack_req)
+{
+    hdr->disp_ecn = SIXLOWPAN_SFR_RFRAG_DISP;
+    hdr->tag = tag;
+    hdr->ar_seq_size = byteorder_htons(
+            ((seq << SIXLOWPAN_SFR_SEQ_POS) & SIXLOWPAN_SFR_SEQ_MASK) |
+            (size & SIXLOWPAN_SFR_FRAG_SIZE_MASK) |
+            ((ack_req) ? SIXLOWPAN_SFR_ACK_REQ : 0));
+    hdr->offset = byteorder_htons(offset);
+}
+
+/**
+ * @brief   Gets the sequence number of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header. Must not be NULL.
+ *
+ * @return  The sequence number of the fragment.
+ */
+static inline unsigned sixlowpan_sfr_rfrag_get_seq(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_SEQ_MASK) >>
+           SIXLOWPAN_SFR_SEQ_POS;
+}
+
+/**
+ * @brief   Gets the payload size of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header. Must not be NULL.
+ *
+ * @return  The size of the fragment's payload.
+ */
+static inline uint16_t sixlowpan_sfr_rfrag_get_size(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+}
+
+/**
+ * @brief   Checks if an RFRAG requests an acknowledgment
+ *
+ * @param[in] hdr   An RFRAG header. Must not be NULL.
+ *
+ * @return  true, if the sender requests an RFRAG-ACK.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_rfrag_ack_req(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_ACK_REQ);
+}
+/** @} */
+
 /**
  * @name    6LoWPAN IPHC dispatch definitions
  * @{
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Sock extension for asynchronous access
+ * @ingroup     net_sock
+ * @brief       Provides backend functionality for asynchronous sock access
+ *
+ * Normally, a thread blocks in `sock_*_recv()` until a message arrives for
+ * its sock. With this extension (module `sock_async`), the network stack
+ * calls a user supplied callback whenever a message was queued for a sock,
+ * so a single thread can wait for several socks at once, e.g. with
+ * [poll()](@ref posix_select).
+ *
+ * The callback is called from the context of the network stack, so it must
+ * not block and should only notify the thread handling the sock, which then
+ * receives the message with `sock_*_recv()` or `sock_*_recv_buf()` and a
+ * timeout of 0.
+ *
+ * @note    Implemented by @ref net_gnrc_sock for @ref net_sock_ip and
+ *          @ref net_sock_udp and by @ref pkg_lwip_sock for all sock types.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for asynchronous sock access
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Flag types to signify asynchronous sock events
+ */
+typedef enum {
+    SOCK_ASYNC_MSG_RECV = 0x0001,   /**< Message received event */
+    SOCK_ASYNC_CONN_RECV = 0x0002,  /**< Connection request received event */
+    SOCK_ASYNC_CONN_FIN = 0x0004,   /**< Connection aborted event */
+} sock_async_flags_t;
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+#include "net/sock/ip.h"
+
+/**
+ * @brief   Event callback for @ref sock_ip_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags. Expected values are
+ *                  - @ref SOCK_ASYNC_MSG_RECV
+ * @param[in] arg   Argument provided when setting the callback using
+ *                  @ref sock_ip_set_cb().
+ */
+typedef void (*sock_ip_cb_t)(sock_ip_t *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Sets event callback for @ref sock_ip_t
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] cb        An event callback. May be NULL to unset event callback.
+ * @param[in] cb_arg    Argument to provide to @p cb. May be NULL.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg);
+#endif  /* defined(MODULE_SOCK_IP) || defined(DOXYGEN) */
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+#include "net/sock/udp.h"
+
+/**
+ * @brief   Event callback for @ref sock_udp_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags. Expected values are
+ *                  - @ref SOCK_ASYNC_MSG_RECV
+ * @param[in] arg   Argument provided when setting the callback using
+ *                  @ref sock_udp_set_cb().
+ */
+typedef void (*sock_udp_cb_t)(sock_udp_t *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Sets event callback for @ref sock_udp_t
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] cb        An event callback. May be NULL to unset event callback.
+ * @param[in] cb_arg    Argument to provide to @p cb. May be NULL.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg);
+#endif  /* defined(MODULE_SOCK_UDP) || defined(DOXYGEN) */
+
+#if defined(MODULE_SOCK_TCP) || defined(DOXYGEN)
+#include "net/sock/tcp.h"
+
+/**
+ * @brief   Event callback for @ref sock_tcp_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags. Expected values are
+ *                  - @ref SOCK_ASYNC_MSG_RECV (also when the connection was
+ *                    closed by the peer, so @ref sock_tcp_read() returns)
+ *                  - @ref SOCK_ASYNC_CONN_FIN
+ * @param[in] arg   Argument provided when setting the callback using
+ *                  @ref sock_tcp_set_cb().
+ */
+typedef void (*sock_tcp_cb_t)(sock_tcp_t *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Event callback for @ref sock_tcp_queue_t
+ *
+ * @param[in] queue The TCP listening queue the event happened on
+ * @param[in] flags The event flags. Expected values are
+ *                  - @ref SOCK_ASYNC_CONN_RECV
+ * @param[in] arg   Argument provided when setting the callback using
+ *                  @ref sock_tcp_queue_set_cb().
+ */
+typedef void (*sock_tcp_queue_cb_t)(sock_tcp_queue_t *queue,
+                                    sock_async_flags_t flags, void *arg);
+
+/**
+ * @brief   Sets event callback for @ref sock_tcp_t
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A TCP sock object.
+ * @param[in] cb        An event callback. May be NULL to unset event callback.
+ * @param[in] cb_arg    Argument to provide to @p cb. May be NULL.
+ */
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb, void *cb_arg);
+
+/**
+ * @brief   Sets event callback for @ref sock_tcp_queue_t
+ *
+ * @pre `(queue != NULL)`
+ *
+ * @param[in] queue     A TCP listening queue.
+ * @param[in] cb        An event callback. May be NULL to unset event callback.
+ * @param[in] cb_arg    Argument to provide to @p cb. May be NULL.
+ */
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_queue_cb_t cb,
+                           void *cb_arg);
+#endif  /* defined(MODULE_SOCK_TCP) || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
@@ -415,6 +415,53 @@ int sock_ip_get_remote(sock_ip_t *sock, sock_ip_ep_t *ep);
 ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
                      uint32_t timeout, sock_ip_ep_t *remote);
 
+/**
+ * @brief   Provides stack-internal buffer space containing a message over IPv4/IPv6
+ *          from a remote end point
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * Instead of copying the received data like @ref sock_ip_recv() does, this
+ * function hands out a pointer into the buffer of the network stack. The
+ * buffer stays valid until the function is called again with the same
+ * @p buf_ctx, which releases the buffer and returns 0. This call must not be
+ * skipped, or the buffer is never released.
+ *
+ * @param[in] sock          A raw IPv4/IPv6 sock object.
+ * @param[out] data         Pointer to the received data in stack-internal
+ *                          buffer space.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. If it points to a
+ *                          `NULL` pointer, a new message is received and its
+ *                          context stored here. Otherwise the buffer of the
+ *                          context is released.
+ * @param[in] timeout       Timeout for receive in microseconds.
+ *                          If 0 and no data is available, the function returns
+ *                          immediately.
+ *                          May be @ref SOCK_NO_TIMEOUT for no timeout (wait
+ *                          until data is available).
+ *                          Ignored when a buffer is released.
+ * @param[out] remote       Remote end point of the received data.
+ *                          May be `NULL`, if it is not required by the
+ *                          application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes received on success.
+ * @return  0, if the buffer of @p buf_ctx was released or no received data is
+ *          available, but everything is in order. `*buf_ctx` is `NULL`
+ *          afterwards.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_ip_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_ip_recv_buf(sock_ip_t *sock, void **data, void **buf_ctx,
+                         uint32_t timeout, sock_ip_ep_t *remote);
+
 /**
  * @brief   Sends a message over IPv4/IPv6 to remote end point
  *
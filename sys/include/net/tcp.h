@@ -43,6 +43,8 @@ extern "C" {
 #define TCP_OPTION_KIND_EOL (0x00)  /**< "End of List"-Option */
 #define TCP_OPTION_KIND_NOP (0x01)  /**< "No Operatrion"-Option */
 #define TCP_OPTION_KIND_MSS (0x02)  /**< "Maximum Segment Size"-Option */
+#define TCP_OPTION_KIND_SACK_PERM (0x04)  /**< "SACK permitted"-Option (see RFC 2018) */
+#define TCP_OPTION_KIND_SACK      (0x05)  /**< "SACK"-Option (see RFC 2018) */
 /** @} */
 
 /**
@@ -50,6 +52,7 @@ extern "C" {
  * @{
  */
 #define TCP_OPTION_LENGTH_MSS (0x04)  /**< MSS Option Size always 4 */
+#define TCP_OPTION_LENGTH_SACK_PERM (0x02)  /**< SACK permitted Option Size always 2 */
 /** @} */
 
 /**
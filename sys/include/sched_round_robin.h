@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_round_robin Round-robin scheduling
+ * @ingroup     sys
+ * @brief       Time slicing between threads of the same priority
+ *
+ * RIOT's scheduler only switches between threads of the same priority when
+ * the running thread blocks or yields. With this module, the running thread
+ * is preempted after @ref SCHED_RR_TIMEBASE microseconds in favor of the next
+ * runnable thread of the same priority.
+ *
+ * The slice timer is periodic, so it keeps firing while the system is idle.
+ * Only use this module when threads of the same priority need to share the
+ * CPU without yielding.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Round-robin scheduling interface
+ */
+
+#ifndef SCHED_ROUND_ROBIN_H
+#define SCHED_ROUND_ROBIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a time slice in microseconds
+ */
+#ifndef SCHED_RR_TIMEBASE
+#define SCHED_RR_TIMEBASE       (10000U)
+#endif
+
+/**
+ * @brief   Start time slicing
+ *
+ * Called by auto_init.
+ */
+void sched_round_robin_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_ROUND_ROBIN_H */
+/** @} */
@@ -15,6 +15,9 @@
  * @note        This ringbuffer implementation can be used without locking if
  *              there's only one producer and one consumer.
  *
+ * tsrb is a wrapper around the single producer, single consumer ring buffer
+ * of @ref sys_lfrb.
+ *
  * @attention   Buffer size must be a power of two!
  *
  * @file
@@ -26,9 +29,10 @@
 #ifndef TSRB_H
 #define TSRB_H
 
-#include <assert.h>
 #include <stddef.h>
 
+#include "lfrb.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,17 +40,12 @@ extern "C" {
 /**
  * @brief     thread-safe ringbuffer struct
  */
-typedef struct tsrb {
-    char *buf;                  /**< Buffer to operate on. */
-    unsigned int size;          /**< Size of buffer, must be power of 2. */
-    volatile unsigned reads;    /**< total number of reads */
-    volatile unsigned writes;   /**< total number of writes */
-} tsrb_t;
+typedef lfrb_t tsrb_t;
 
 /**
  * @brief Static initializer
  */
-#define TSRB_INIT(BUF) { (BUF), sizeof (BUF), 0, 0 }
+#define TSRB_INIT(BUF) LFRB_INIT(BUF)
 
 /**
  * @brief        Initialize a tsrb.
@@ -56,15 +55,7 @@ typedef struct tsrb {
  */
 static inline void tsrb_init(tsrb_t *rb, char *buffer, unsigned bufsize)
 {
-    /* make sure bufsize is a power of two.
-     * http://www.exploringbinary.com/ten-ways-to-check-if-an-integer-is-a-power-of-two-in-c/
-     */
-    assert((bufsize != 0) && ((bufsize & (~bufsize + 1)) == bufsize));
-
-    rb->buf = buffer;
-    rb->size = bufsize;
-    rb->reads = 0;
-    rb->writes = 0;
+    lfrb_init(rb, buffer, bufsize);
 }
 
 /**
@@ -75,7 +66,7 @@ static inline void tsrb_init(tsrb_t *rb, char *buffer, unsigned bufsize)
  */
 static inline int tsrb_empty(const tsrb_t *rb)
 {
-    return (rb->reads == rb->writes);
+    return lfrb_empty((tsrb_t *)rb);
 }
 
 
@@ -86,7 +77,7 @@ static inline int tsrb_empty(const tsrb_t *rb)
  */
 static inline unsigned int tsrb_avail(const tsrb_t *rb)
 {
-    return (rb->writes - rb->reads);
+    return lfrb_avail((tsrb_t *)rb);
 }
 
 /**
@@ -97,7 +88,7 @@ static inline unsigned int tsrb_avail(const tsrb_t *rb)
  */
 static inline int tsrb_full(const tsrb_t *rb)
 {
-    return (rb->writes - rb->reads) == rb->size;
+    return lfrb_full((tsrb_t *)rb);
 }
 
 /**
@@ -107,7 +98,7 @@ static inline int tsrb_full(const tsrb_t *rb)
  */
 static inline unsigned int tsrb_free(const tsrb_t *rb)
 {
-    return (rb->size - rb->writes + rb->reads);
+    return lfrb_free((tsrb_t *)rb);
 }
 
 /**
@@ -11,6 +11,12 @@
  * @ingroup     sys
  * @brief       universal address container
  *
+ * Addresses are interned: every distinct address is stored only once and
+ * shared through its container. With the `universal_address_hash`
+ * pseudomodule, containers are additionally indexed by a hash table, so
+ * universal_address_add() does not need to compare against every stored
+ * address.
+ *
  * @{
  *
  * @file
@@ -158,6 +158,12 @@ extern "C" {
  */
 #define VFS_ANY_FD (-1)
 
+/**
+ * @brief Thread flag set on the thread waiting in @ref vfs_poll when an open
+ *        file may have become ready
+ */
+#define VFS_POLL_THREAD_FLAG (1u << 13)
+
 /* Forward declarations */
 /**
  * @brief struct @c vfs_file_ops typedef
@@ -370,6 +376,29 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Query the readiness of an open file
+     *
+     * File system drivers whose read or write may block implement this, so a
+     * thread can wait for several files at once. The driver remembers
+     * @p waiter and sets @ref VFS_POLL_THREAD_FLAG on it whenever the
+     * readiness of the file may have changed, until called again with
+     * @ref KERNEL_PID_UNDEF. Only one thread may wait for a file at a time.
+     *
+     * If not implemented, the file is considered ready for all @p events.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  events   events to check for, a combination of @c POLLIN and
+     *                      @c POLLOUT, see man 3p poll
+     * @param[in]  waiter   thread to notify, @ref KERNEL_PID_UNDEF to stop
+     *                      notifying
+     *
+     * @return the events of @p events that are ready, @c POLLERR and
+     *         @c POLLHUP may be returned in addition
+     * @return <0 on error
+     */
+    int (*poll) (vfs_file_t *filp, int events, kernel_pid_t waiter);
 };
 
 /**
@@ -592,6 +621,23 @@ int vfs_close(int fd);
  */
 int vfs_fcntl(int fd, int cmd, int arg);
 
+/**
+ * @brief Query the readiness of an open file
+ *
+ * See @ref vfs_file_ops::poll
+ *
+ * @param[in]  fd       fd number to operate on
+ * @param[in]  events   events to check for, a combination of @c POLLIN and
+ *                      @c POLLOUT, see man 3p poll
+ * @param[in]  waiter   thread to set @ref VFS_POLL_THREAD_FLAG on when the
+ *                      file may have become ready, @ref KERNEL_PID_UNDEF to
+ *                      stop notifying
+ *
+ * @return the ready events
+ * @return <0 on error
+ */
+int vfs_poll(int fd, int events, kernel_pid_t waiter);
+
 /**
  * @brief Get status of an open file
  *
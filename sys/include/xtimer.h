@@ -20,6 +20,19 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * Timers set with xtimer_set_slack() tolerate a given delay. With the
+ * `xtimer_slack` module, such timers are fired early together with another
+ * timer if that one expires within their window, which reduces the number of
+ * interrupts and wakeups. Without the module, they fire at their earliest
+ * time, like timers set with xtimer_set(). The module also counts
+ * individually and coalesced fired timers, see xtimer_get_stats().
+ *
+ * With the `xtimer_pairing_heap` module, the timer lists are replaced by
+ * pairing heaps. Setting a timer then takes constant time, removing a timer
+ * or firing the next one O(log n) amortized, at the cost of two more
+ * pointers per timer. This is meant for applications that keep many timers
+ * set concurrently.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -74,8 +87,30 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_PAIRING_HEAP) || defined(DOXYGEN)
+    struct xtimer *prev;         /**< parent or previous sibling in the timer
+                                     heap */
+    struct xtimer *child;        /**< first child in the timer heap */
+#endif
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may fire before target */
+#endif
 } xtimer_t;
 
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief xtimer statistics
+ *
+ * The first timer fired in an xtimer interrupt is counted as an individual
+ * fire, all further timers fired in the same interrupt as coalesced fires.
+ */
+typedef struct {
+    uint32_t fired;              /**< number of timers fired */
+    uint32_t coalesced;          /**< number of timers that fired together
+                                      with a preceding timer */
+} xtimer_stats_t;
+#endif
+
 /**
  * @brief get the current system time as 32bit time stamp value
  *
@@ -312,6 +347,56 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
  */
 static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
 
+/**
+ * @brief Set a timer to execute a callback within a window in the future
+ *
+ * Like xtimer_set(), but the callback may be executed up to @p slack
+ * microseconds late. With the `xtimer_slack` module, xtimer uses this
+ * tolerance to fire timers whose windows overlap in the same interrupt,
+ * instead of waking up the CPU for each of them. Without the module, this
+ * is the same as xtimer_set().
+ *
+ * @warning BEWARE! Callbacks from xtimer_set_slack() are being executed in
+ * interrupt context (unless offset < XTIMER_BACKOFF). DON'T USE THIS FUNCTION
+ * unless you know *exactly* what that means.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    time in microseconds from now specifying the earliest
+ *                      execution time of the timer's callback
+ * @param[in] slack     time in microseconds the callback's execution may be
+ *                      delayed
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
+/**
+ * @brief Set a timer to execute a callback within a window in the future,
+ * 64bit version
+ *
+ * @see xtimer_set_slack()
+ *
+ * @param[in] timer       the timer structure to use.
+ *                        Its xtimer_t::target and xtimer_t::long_target
+ *                        fields need to be initialized with 0 on first use
+ * @param[in] offset_us   time in microseconds from now specifying the
+ *                        earliest execution time of the timer's callback
+ * @param[in] slack       time in microseconds the callback's execution may be
+ *                        delayed
+ */
+static inline void xtimer_set_slack64(xtimer_t *timer, uint64_t offset_us,
+                                      uint32_t slack);
+
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief Get the number of individually and coalesced fired timers
+ *
+ * @param[out] stats    the statistics
+ */
+void xtimer_get_stats(xtimer_stats_t *stats);
+#endif
+
 /**
  * @brief remove a timer
  *
@@ -83,6 +83,8 @@ uint64_t _xtimer_now64(void);
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
+void _xtimer_set_slack64(xtimer_t *timer, uint32_t offset, uint32_t long_offset,
+                         uint32_t slack);
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period);
 void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid);
@@ -241,6 +243,18 @@ static inline void xtimer_set64(xtimer_t *timer, uint64_t period_us)
     _xtimer_set64(timer, ticks, ticks >> 32);
 }
 
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    _xtimer_set_slack64(timer, _xtimer_ticks_from_usec(offset), 0,
+                        _xtimer_ticks_from_usec(slack));
+}
+
+static inline void xtimer_set_slack64(xtimer_t *timer, uint64_t offset_us, uint32_t slack)
+{
+    uint64_t ticks = _xtimer_ticks_from_usec64(offset_us);
+    _xtimer_set_slack64(timer, ticks, ticks >> 32, _xtimer_ticks_from_usec(slack));
+}
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
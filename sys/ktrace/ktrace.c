@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ktrace
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracing implementation
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ktrace.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#if (KTRACE_BUFSIZE & (KTRACE_BUFSIZE - 1)) != 0
+#error "KTRACE_BUFSIZE must be a power of two"
+#endif
+
+#define HDR_LEN         (16U)
+#define THREAD_REC_LEN  (2U + KTRACE_NAME_LEN)
+#define ENTRY_LEN       (12U)
+
+static ktrace_entry_t _buf[KTRACE_BUFSIZE];
+static atomic_uint _head = ATOMIC_VAR_INIT(0);
+static atomic_bool _enabled = ATOMIC_VAR_INIT(false);
+
+void ktrace_start(void)
+{
+    atomic_store(&_enabled, true);
+}
+
+void ktrace_stop(void)
+{
+    atomic_store(&_enabled, false);
+}
+
+void ktrace_clear(void)
+{
+    atomic_store(&_head, 0);
+}
+
+void ktrace_record(ktrace_event_t event, uint16_t arg16, uint32_t arg32)
+{
+    if (!atomic_load_explicit(&_enabled, memory_order_relaxed)) {
+        return;
+    }
+    /* reserving the slot is the only shared write, so ISRs preempting us
+     * simply get the next slot */
+    unsigned idx = atomic_fetch_add_explicit(&_head, 1, memory_order_relaxed);
+    ktrace_entry_t *e = &_buf[idx & (KTRACE_BUFSIZE - 1)];
+
+    e->time = xtimer_now_usec();
+    e->event = (uint8_t)event;
+    e->pid = (uint8_t)sched_active_pid;
+    e->arg16 = arg16;
+    e->arg32 = arg32;
+}
+
+unsigned ktrace_numof(void)
+{
+    unsigned head = atomic_load(&_head);
+
+    return (head < KTRACE_BUFSIZE) ? head : KTRACE_BUFSIZE;
+}
+
+static uint8_t *_put_u16(uint8_t *p, uint16_t val)
+{
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+    return p + 2;
+}
+
+static uint8_t *_put_u32(uint8_t *p, uint32_t val)
+{
+    p = _put_u16(p, (uint16_t)val);
+    return _put_u16(p, (uint16_t)(val >> 16));
+}
+
+void ktrace_export(ktrace_write_t write, void *arg)
+{
+    uint8_t tmp[HDR_LEN];
+    uint8_t *p;
+    unsigned head = atomic_load(&_head);
+    unsigned numof = ktrace_numof();
+    uint16_t threads = 0;
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (thread_get(i) != NULL) {
+            threads++;
+        }
+    }
+
+    memcpy(tmp, "KTRC", 4);
+    tmp[4] = KTRACE_VERSION;
+    tmp[5] = ENTRY_LEN;
+    p = _put_u16(&tmp[6], threads);
+    p = _put_u32(p, numof);
+    _put_u32(p, head - numof);
+    write(tmp, HDR_LEN, arg);
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        uint8_t rec[THREAD_REC_LEN];
+        const char *name;
+
+        if (thread_get(i) == NULL) {
+            continue;
+        }
+        memset(rec, 0, sizeof(rec));
+        _put_u16(rec, (uint16_t)i);
+        name = thread_getname(i);
+        if (name != NULL) {
+            strncpy((char *)&rec[2], name, KTRACE_NAME_LEN);
+        }
+        write(rec, sizeof(rec), arg);
+    }
+
+    for (unsigned i = head - numof; i != head; i++) {
+        const ktrace_entry_t *e = &_buf[i & (KTRACE_BUFSIZE - 1)];
+
+        p = _put_u32(tmp, e->time);
+        *p++ = e->event;
+        *p++ = e->pid;
+        p = _put_u16(p, e->arg16);
+        _put_u32(p, e->arg32);
+        write(tmp, ENTRY_LEN, arg);
+    }
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_lfrb
+ * @{
+ *
+ * @file
+ * @brief       Lock-free ring buffer implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "lfrb.h"
+
+static void _copy_in(lfrb_t *rb, unsigned pos, const uint8_t *src, size_t n)
+{
+    unsigned idx = pos & (rb->size - 1);
+    size_t first = rb->size - idx;
+
+    if (first >= n) {
+        memcpy(&rb->buf[idx], src, n);
+    }
+    else {
+        memcpy(&rb->buf[idx], src, first);
+        memcpy(rb->buf, src + first, n - first);
+    }
+}
+
+static void _copy_out(const lfrb_t *rb, unsigned pos, uint8_t *dst, size_t n)
+{
+    unsigned idx = pos & (rb->size - 1);
+    size_t first = rb->size - idx;
+
+    if (first >= n) {
+        memcpy(dst, &rb->buf[idx], n);
+    }
+    else {
+        memcpy(dst, &rb->buf[idx], first);
+        memcpy(dst + first, rb->buf, n - first);
+    }
+}
+
+size_t lfrb_add(lfrb_t *rb, const void *src, size_t n)
+{
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+    size_t free = lfrb_free(rb);
+
+    if (n > free) {
+        n = free;
+    }
+    _copy_in(rb, writes, src, n);
+    atomic_store_explicit(&rb->writes, writes + n, memory_order_release);
+
+    return n;
+}
+
+int lfrb_add_one(lfrb_t *rb, uint8_t c)
+{
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    if (lfrb_full(rb)) {
+        return -1;
+    }
+    rb->buf[writes & (rb->size - 1)] = c;
+    atomic_store_explicit(&rb->writes, writes + 1, memory_order_release);
+
+    return 0;
+}
+
+size_t lfrb_peek(lfrb_t *rb, void *dst, size_t n)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+    size_t avail = lfrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
+    }
+    _copy_out(rb, reads, dst, n);
+
+    return n;
+}
+
+size_t lfrb_get(lfrb_t *rb, void *dst, size_t n)
+{
+    n = lfrb_peek(rb, dst, n);
+    lfrb_consume(rb, n);
+
+    return n;
+}
+
+int lfrb_get_one(lfrb_t *rb)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+
+    if (lfrb_empty(rb)) {
+        return -1;
+    }
+    uint8_t c = rb->buf[reads & (rb->size - 1)];
+    atomic_store_explicit(&rb->reads, reads + 1, memory_order_release);
+
+    return c;
+}
+
+size_t lfrb_drop(lfrb_t *rb, size_t n)
+{
+    size_t avail = lfrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
+    }
+    lfrb_consume(rb, n);
+
+    return n;
+}
+
+size_t lfrb_reserve(lfrb_t *rb, void **region)
+{
+    unsigned idx = atomic_load_explicit(&rb->writes, memory_order_relaxed) &
+                   (rb->size - 1);
+    size_t free = lfrb_free(rb);
+    size_t contiguous = rb->size - idx;
+
+    *region = &rb->buf[idx];
+
+    return (free < contiguous) ? free : contiguous;
+}
+
+void lfrb_commit(lfrb_t *rb, size_t n)
+{
+    assert(n <= lfrb_free(rb));
+    atomic_fetch_add_explicit(&rb->writes, n, memory_order_release);
+}
+
+size_t lfrb_peek_region(lfrb_t *rb, const void **region)
+{
+    unsigned idx = atomic_load_explicit(&rb->reads, memory_order_relaxed) &
+                   (rb->size - 1);
+    size_t avail = lfrb_avail(rb);
+    size_t contiguous = rb->size - idx;
+
+    *region = &rb->buf[idx];
+
+    return (avail < contiguous) ? avail : contiguous;
+}
+
+void lfrb_consume(lfrb_t *rb, size_t n)
+{
+    assert(n <= lfrb_avail(rb));
+    atomic_fetch_add_explicit(&rb->reads, n, memory_order_release);
+}
+
+int lfrb_mpsc_reserve(lfrb_mpsc_t *mpsc, size_t n, unsigned *pos)
+{
+    lfrb_t *rb = &mpsc->rb;
+    unsigned reserved = atomic_load_explicit(&mpsc->reserved,
+                                             memory_order_relaxed);
+
+    /* reserve n bytes starting at reserved */
+    do {
+        unsigned used = reserved - atomic_load_explicit(&rb->reads,
+                                                        memory_order_acquire);
+        if (n > rb->size - used) {
+            return -1;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&mpsc->reserved, &reserved,
+                                                    reserved + n,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+    *pos = reserved;
+
+    return 0;
+}
+
+void lfrb_mpsc_write(lfrb_mpsc_t *mpsc, unsigned pos, const void *src, size_t n)
+{
+    _copy_in(&mpsc->rb, pos, src, n);
+}
+
+void lfrb_mpsc_commit(lfrb_mpsc_t *mpsc, size_t n)
+{
+    lfrb_t *rb = &mpsc->rb;
+
+    /* Writers that were interrupted by us may not have finished yet, so we
+     * can't just publish our bytes. Instead, whoever finds that all bytes
+     * reserved so far have been written publishes them. As committed is
+     * read before reserved, equality means that no reservation is pending. */
+    unsigned committed = atomic_fetch_add_explicit(&mpsc->committed, n,
+                                                   memory_order_acq_rel) + n;
+    unsigned reserved = atomic_load_explicit(&mpsc->reserved,
+                                             memory_order_acquire);
+    if (committed == reserved) {
+        unsigned writes = atomic_load_explicit(&rb->writes,
+                                               memory_order_relaxed);
+        /* never move writes backwards if a later writer published first */
+        while (((int)(reserved - writes) > 0) &&
+               !atomic_compare_exchange_weak_explicit(&rb->writes, &writes,
+                                                      reserved,
+                                                      memory_order_release,
+                                                      memory_order_relaxed)) {}
+    }
+}
+
+size_t lfrb_mpsc_add(lfrb_mpsc_t *mpsc, const void *src, size_t n)
+{
+    unsigned pos;
+
+    if (lfrb_mpsc_reserve(mpsc, n, &pos) < 0) {
+        return 0;
+    }
+    lfrb_mpsc_write(mpsc, pos, src, n);
+    lfrb_mpsc_commit(mpsc, n);
+
+    return n;
+}
@@ -50,6 +50,8 @@
 /* Internal functions */
 static void *_event_loop(void *arg);
 static void _listen(sock_udp_t *sock);
+static void _process_msg(sock_udp_t *sock, uint8_t *data, size_t len,
+                         sock_udp_ep_t *remote);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
@@ -174,20 +176,18 @@ static void *_event_loop(void *arg)
 /* Listen for an incoming CoAP message. */
 static void _listen(sock_udp_t *sock)
 {
-    coap_pkt_t pdu;
-    uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
-    gcoap_request_memo_t *memo = NULL;
+    void *data, *buf_ctx = NULL;
     uint8_t open_reqs = gcoap_op_state();
 
     /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
      * is interrupted when sending a message in gcoap_req_send2(). While a
-     * request is outstanding, sock_udp_recv() is called here with limited
+     * request is outstanding, sock_udp_recv_buf() is called here with limited
      * waiting so the request's timeout can be handled in a timely manner in
      * _event_loop(). */
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
+    ssize_t res = sock_udp_recv_buf(sock, &data, &buf_ctx,
+                                    open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
+                                    &remote);
     if (res <= 0) {
 #if ENABLE_DEBUG
         if (res < 0 && res != -ETIMEDOUT) {
@@ -197,7 +197,21 @@ static void _listen(sock_udp_t *sock)
         return;
     }
 
-    res = coap_parse(&pdu, buf, res);
+    /* the message is parsed where the network stack received it */
+    _process_msg(sock, data, res, &remote);
+    /* release the message */
+    sock_udp_recv_buf(sock, &data, &buf_ctx, 0, NULL);
+}
+
+/* Handles a received CoAP message. Responses are written to a separate buffer. */
+static void _process_msg(sock_udp_t *sock, uint8_t *data, size_t len,
+                         sock_udp_ep_t *remote)
+{
+    coap_pkt_t pdu;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    gcoap_request_memo_t *memo = NULL;
+
+    ssize_t res = coap_parse(&pdu, data, len);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", (int)res);
         /* If a response, can't clear memo, but it will timeout later. */
@@ -215,9 +229,9 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_REQ:
         if (coap_get_type(&pdu) == COAP_TYPE_NON
                 || coap_get_type(&pdu) == COAP_TYPE_CON) {
-            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
+            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), remote);
             if (pdu_len > 0) {
-                ssize_t bytes = sock_udp_send(sock, buf, pdu_len, &remote);
+                ssize_t bytes = sock_udp_send(sock, buf, pdu_len, remote);
                 if (bytes <= 0) {
                     DEBUG("gcoap: send response failed: %d\n", (int)bytes);
                 }
@@ -232,7 +246,7 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_SUCCESS:
     case COAP_CLASS_CLIENT_FAILURE:
     case COAP_CLASS_SERVER_FAILURE:
-        _find_req_memo(&memo, &pdu, &remote);
+        _find_req_memo(&memo, &pdu, remote);
         if (memo) {
             switch (coap_get_type(&pdu)) {
             case COAP_TYPE_NON:
@@ -240,7 +254,7 @@ static void _listen(sock_udp_t *sock)
                 xtimer_remove(&memo->response_timer);
                 memo->state = GCOAP_MEMO_RESP;
                 if (memo->resp_handler) {
-                    memo->resp_handler(memo->state, &pdu, &remote);
+                    memo->resp_handler(memo->state, &pdu, remote);
                 }
 
                 if (memo->send_limit >= 0) {        /* if confirmable */
@@ -843,13 +857,23 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
 
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 {
+    unsigned header_len  = coap_get_total_hdr_len(pdu);
+
+    if ((header_len + GCOAP_RESP_OPTIONS_BUF) > len) {
+        return -ENOSPC;
+    }
+    /* request was parsed in place from another buffer */
+    if ((uint8_t *)pdu->hdr != buf) {
+        memcpy(buf, pdu->hdr, header_len);
+        pdu->hdr   = (coap_hdr_t *)buf;
+        pdu->token = coap_hdr_data_ptr(pdu->hdr);
+    }
+
     if (coap_get_type(pdu) == COAP_TYPE_CON) {
         coap_hdr_set_type(pdu->hdr, COAP_TYPE_ACK);
     }
     coap_hdr_set_code(pdu->hdr, code);
 
-    unsigned header_len  = coap_get_total_hdr_len(pdu);
-
     pdu->options_len = 0;
     pdu->payload     = buf + header_len;
     pdu->payload_len = len - header_len - GCOAP_RESP_OPTIONS_BUF;
@@ -133,20 +133,25 @@ int nanocoap_server(sock_udp_ep_t *local, uint8_t *buf, size_t bufsize)
     }
 
     while (1) {
-        res = sock_udp_recv(&sock, buf, bufsize, -1, &remote);
+        void *data, *buf_ctx = NULL;
+
+        /* the request is parsed where it was received, the response is
+         * built in buf */
+        res = sock_udp_recv_buf(&sock, &data, &buf_ctx, SOCK_NO_TIMEOUT,
+                                &remote);
         if (res == -1) {
             DEBUG("error receiving UDP packet\n");
             return -1;
         }
-        else {
+        else if (res > 0) {
             coap_pkt_t pkt;
-            if (coap_parse(&pkt, (uint8_t *)buf, res) < 0) {
+            if (coap_parse(&pkt, data, res) < 0) {
                 DEBUG("error parsing packet\n");
-                continue;
             }
-            if ((res = coap_handle_req(&pkt, buf, bufsize)) > 0) {
+            else if ((res = coap_handle_req(&pkt, buf, bufsize)) > 0) {
                 res = sock_udp_send(&sock, buf, res, &remote);
             }
+            sock_udp_recv_buf(&sock, &data, &buf_ctx, 0, NULL);
         }
     }
 
@@ -13,16 +13,57 @@
  */
 
 #include <inttypes.h>
+#include <stdint.h>
 #include <stdio.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   32-bit word that may alias the byte buffer it is read from
+ */
+typedef uint32_t __attribute__((__may_alias__)) _word_t;
+
+static inline uint16_t _fold(uint64_t sum)
+{
+    /* 2^32 = 2^16 = 1 (mod 0xffff), so folding keeps the 1's complement sum,
+     * and it only becomes 0 when the full sum was 0 */
+    uint32_t s = (uint32_t)(sum >> 32);
+
+    s += (uint32_t)sum;
+    if (s < (uint32_t)sum) {
+        s++;
+    }
+    s = (s >> 16) + (s & 0xffff);
+    s = (s >> 16) + (s & 0xffff);
+    return s;
+}
+
+/* adds bytes one by one, odd tells if buf[0] is the low byte of a word */
+static inline uint32_t _sum_bytes(const uint8_t *buf, unsigned len,
+                                  unsigned *odd)
+{
+    uint32_t sum = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        sum += (*odd) ? buf[i] : ((uint32_t)buf[i] << 8);
+        *odd ^= 1;
+    }
+    return sum;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
-    uint32_t csum = sum;
+    uint64_t csum = sum;
+    uint64_t words = 0;
+    unsigned odd = accum_len & 1;   /* buf[0] is the low byte of a word */
+    unsigned head = (-(uintptr_t)buf) & (sizeof(_word_t) - 1);
+    const _word_t *w;
+    uint16_t res;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -34,32 +75,61 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
 #endif
 #endif
 
-    if (len == 0)
-        return csum;
+    if (len == 0) {
+        return sum;
+    }
 
-    if (accum_len & 1) {      /* if accumulated length is odd */
-        csum += *buf;         /* add first byte as bottom half of 16-byte word */
-        buf++;
-        len--;
-        accum_len++;
+    /* bytes up to the first aligned word */
+    if (head > len) {
+        head = len;
     }
+    csum += _sum_bytes(buf, head, &odd);
+    buf += head;
+    len -= head;
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    /* Sum up aligned words in host byte order. The 1's complement sum does not
+     * depend on byte order (RFC 1071, 2.(B)), so the result only needs to be
+     * swapped if the words are not aligned to the big endian 16-bit words of
+     * the checksum domain. */
+    w = (const _word_t *)buf;
+    for (; len >= (4 * sizeof(_word_t)); len -= (4 * sizeof(_word_t))) {
+        words += w[0];
+        words += w[1];
+        words += w[2];
+        words += w[3];
+        w += 4;
     }
+    for (; len >= sizeof(_word_t); len -= sizeof(_word_t)) {
+        words += *w++;
+    }
+    res = _fold(words);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!odd) {
+#else
+    if (odd) {
+#endif
+        res = byteorder_swaps(res);
+    }
+    csum += res;
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    /* remaining bytes, an odd last byte is the top half of a word */
+    csum += _sum_bytes((const uint8_t *)w, len, &odd);
 
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
-    }
+    res = _fold(csum);
+    DEBUG("inet_sum: new sum = 0x%04" PRIx16 "\n", res);
 
-    DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
+    return res;
+}
+
+uint16_t inet_csum_update_buf(uint16_t csum, const uint8_t *old_buf,
+                              const uint8_t *new_buf, uint16_t len)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
 
-    return csum;
+    sum += (uint16_t)~inet_csum(0, old_buf, len);
+    sum += inet_csum(0, new_buf, len);
+    return ~_fold(sum);
 }
 
 /** @} */
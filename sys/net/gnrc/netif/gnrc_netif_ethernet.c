@@ -24,6 +24,9 @@
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
+#ifdef MODULE_GNRC_PCAP
+#include "net/gnrc/pcap.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -151,6 +154,10 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     else {
         dev->stats.tx_unicast_count++;
     }
+#endif
+#ifdef MODULE_GNRC_PCAP
+    gnrc_pcap_capture(netif->pid, GNRC_PCAP_LINKTYPE_ETHERNET, GNRC_PCAP_TX,
+                      &iolist);
 #endif
     res = dev->driver->send(dev, &iolist);
 
@@ -184,6 +191,12 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             DEBUG("gnrc_netif_ethernet: read error.\n");
             goto safe_out;
         }
+#ifdef MODULE_GNRC_PCAP
+        iolist_t frame = { .iol_base = pkt->data, .iol_len = nread };
+
+        gnrc_pcap_capture(netif->pid, GNRC_PCAP_LINKTYPE_ETHERNET,
+                          GNRC_PCAP_RX, &frame);
+#endif
 
         if (nread < bytes_expected) {
             /* we've got less than the expected packet size,
@@ -20,6 +20,9 @@
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
+#ifdef MODULE_GNRC_PCAP
+#include "net/gnrc/pcap.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -96,6 +99,12 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_PCAP
+        iolist_t frame = { .iol_base = pkt->data, .iol_len = nread };
+
+        gnrc_pcap_capture(netif->pid, GNRC_PCAP_LINKTYPE_IEEE802_15_4_NOFCS,
+                          GNRC_PCAP_RX, &frame);
+#endif
         if (netif->flags & GNRC_NETIF_FLAGS_RAWMODE) {
             /* Raw mode, skip packet processing, but provide rx_info via
              * GNRC_NETTYPE_NETIF */
@@ -248,6 +257,10 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         netif->dev->stats.tx_unicast_count++;
     }
 #endif
+#ifdef MODULE_GNRC_PCAP
+    gnrc_pcap_capture(netif->pid, GNRC_PCAP_LINKTYPE_IEEE802_15_4_NOFCS,
+                      GNRC_PCAP_TX, &iolist);
+#endif
 #ifdef MODULE_GNRC_MAC
     if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED) {
         res = csma_sender_csma_ca_send(dev, &iolist, &netif->mac.csma_conf);
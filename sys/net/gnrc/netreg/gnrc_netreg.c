@@ -28,13 +28,33 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+/* The registry as hash table by gnrc_nettype_t and demux context. Entries with
+ * the same type and demux context are kept next to each other in a bucket. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETREG_HASH_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type,
+                                            uint32_t demux_ctx)
+{
+    uint32_t hash = (demux_ctx ^ ((uint32_t)type << 24)) * 2654435761U;
+
+    return &netreg[(hash ^ (hash >> 16)) & (GNRC_NETREG_HASH_BUCKETS - 1)];
+}
+
+static inline bool _matches(const gnrc_netreg_entry_t *entry,
+                            gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    return (entry->nettype == type) && (entry->demux_ctx == demux_ctx);
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#endif
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +79,24 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    gnrc_netreg_entry_t **bucket = _bucket(type, entry->demux_ctx);
+    gnrc_netreg_entry_t **pos = bucket;
+
+    /* prepend to the entries with the same key, or to the bucket if there
+     * are none */
+    while ((*pos != NULL) && !_matches(*pos, type, entry->demux_ctx)) {
+        pos = &(*pos)->next;
+    }
+    if (*pos == NULL) {
+        pos = bucket;
+    }
+    entry->nettype = type;
+    entry->next = *pos;
+    *pos = entry;
+#else
     LL_PREPEND(netreg[type], entry);
+#endif
 
     return 0;
 }
@@ -70,7 +107,13 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    gnrc_netreg_entry_t **bucket = _bucket(type, entry->demux_ctx);
+
+    LL_DELETE(*bucket, entry);
+#else
     LL_DELETE(netreg[type], entry);
+#endif
 }
 
 /**
@@ -91,10 +134,26 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
 {
     gnrc_netreg_entry_t *res = NULL;
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    if (from) {
+        /* entries with the same key are adjacent */
+        res = from->next;
+        if ((res != NULL) && !_matches(res, from->nettype, from->demux_ctx)) {
+            res = NULL;
+        }
+    }
+    else if (!_INVALID_TYPE(type)) {
+        res = *_bucket(type, demux_ctx);
+        while ((res != NULL) && !_matches(res, type, demux_ctx)) {
+            res = res->next;
+        }
+    }
+#else
     if (from || !_INVALID_TYPE(type)) {
         gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
+#endif
 
     return res;
 }
@@ -75,6 +75,15 @@ static void *_event_loop(void *args);
 /* Handles encapsulated IPv6 packets: http://tools.ietf.org/html/rfc2473 */
 static void _decapsulate(gnrc_pktsnip_t *pkt);
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/**
+ * @brief   Message type to pass a packet to forward to the IPv6 thread
+ */
+#define GNRC_IPV6_MSG_TYPE_FWD      (0x0207)
+
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+#endif
+
 kernel_pid_t gnrc_ipv6_init(void)
 {
     if (gnrc_ipv6_pid == KERNEL_PID_UNDEF) {
@@ -250,11 +259,48 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    /* sending may have to wait for address resolution, so leave it to the
+     * IPv6 thread */
+    else if (gnrc_netapi_send(gnrc_ipv6_pid, pkt) < 1) {
+        DEBUG("ipv6: unable to pass packet to IPv6 thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+#ifdef MODULE_GNRC_IPV6_ROUTER
+/* forwarding looks up the next hop in the NIB, so leave it to the IPv6
+ * thread as well */
+static void _forward(gnrc_pktsnip_t *pkt)
+{
+    msg_t msg = { .type = GNRC_IPV6_MSG_TYPE_FWD, .content = { .ptr = pkt } };
+
+    if (msg_try_send(&msg, gnrc_ipv6_pid) < 1) {
+        DEBUG("ipv6: unable to pass packet to forward to IPv6 thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+#endif
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    static gnrc_netreg_entry_cbd_t me_cbd = { .cb = _direct_cb };
+    gnrc_netreg_entry_t me_reg;
+
+    gnrc_netreg_entry_init_cb(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL, &me_cbd);
+#else
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
@@ -281,6 +327,13 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr, true);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+            case GNRC_IPV6_MSG_TYPE_FWD:
+                DEBUG("ipv6: GNRC_IPV6_MSG_TYPE_FWD received\n");
+                _send(msg.content.ptr, false);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
@@ -885,6 +938,12 @@ static void _receive(gnrc_pktsnip_t *pkt)
             }
             pkt = gnrc_pktbuf_reverse_snips(pkt);
             if (pkt != NULL) {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+                if (sched_active_pid != gnrc_ipv6_pid) {
+                    _forward(pkt);
+                    return;
+                }
+#endif
                 _send(pkt, false);
             }
             else {
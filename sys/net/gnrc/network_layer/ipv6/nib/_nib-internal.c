@@ -43,6 +43,45 @@ static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_CONF_INDEX
+#if (2 * GNRC_IPV6_NIB_OFFL_NUMOF) >= UINT16_MAX
+#error "GNRC_IPV6_NIB_OFFL_NUMOF too large for GNRC_IPV6_NIB_CONF_INDEX"
+#endif
+#if GNRC_IPV6_NIB_NUMOF >= UINT16_MAX
+#error "GNRC_IPV6_NIB_NUMOF too large for GNRC_IPV6_NIB_CONF_INDEX"
+#endif
+
+/* The index structures refer to entries and trie nodes by their position in
+ * the respective array plus one, so 0 means none and zero-initialized
+ * structures are empty. */
+#define _TRIE_NUMOF         (2 * GNRC_IPV6_NIB_OFFL_NUMOF)
+#define _TRIE(h)            (&_trie[(h) - 1])
+
+/* node of the path-compressed binary trie over the prefixes in _dsts */
+typedef struct {
+    ipv6_addr_t pfx;        /* prefix of the node */
+    uint16_t child[2];      /* subtries by the bit following the prefix */
+    uint16_t dsts;          /* first entry in _dsts with this prefix */
+    uint8_t pfx_len;        /* length of the prefix in bits */
+} _trie_node_t;
+
+static _trie_node_t _trie[_TRIE_NUMOF];
+static uint16_t _trie_root;
+static uint16_t _trie_free;     /* list of released nodes by child[0] */
+static uint16_t _trie_unused;   /* number of nodes never used */
+/* next entry in _dsts with the same prefix, ordered by position */
+static uint16_t _dsts_next[GNRC_IPV6_NIB_OFFL_NUMOF];
+
+/* hash table over the addresses of _nodes, buckets ordered by position */
+static uint16_t _nodes_buckets[GNRC_IPV6_NIB_NUMOF];
+static uint16_t _nodes_next[GNRC_IPV6_NIB_NUMOF];
+static uint16_t _nodes_bucket_of[GNRC_IPV6_NIB_NUMOF];
+
+static void _nodes_index_update(const _nib_onl_entry_t *node);
+static void _trie_add(const _nib_offl_entry_t *dst);
+static void _trie_remove(const _nib_offl_entry_t *dst);
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
@@ -63,6 +102,14 @@ void _nib_init(void)
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+#if GNRC_IPV6_NIB_CONF_INDEX
+    _trie_root = 0;
+    _trie_free = 0;
+    _trie_unused = 0;
+    memset(_dsts_next, 0, sizeof(_dsts_next));
+    memset(_nodes_buckets, 0, sizeof(_nodes_buckets));
+    memset(_nodes_bucket_of, 0, sizeof(_nodes_bucket_of));
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
 #endif  /* TEST_SUITES */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
@@ -199,20 +246,67 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
+#if GNRC_IPV6_NIB_CONF_INDEX
+static inline unsigned _nodes_hash(const ipv6_addr_t *addr)
+{
+    uint32_t hash = (addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                     addr->u32[3].u32) * 2654435761U;
+
+    return (hash ^ (hash >> 16)) % GNRC_IPV6_NIB_NUMOF;
+}
+
+static void _nodes_index_update(const _nib_onl_entry_t *node)
+{
+    unsigned pos = node - _nodes;
+    unsigned bucket = _nodes_hash(&node->ipv6);
+    uint16_t *ptr;
+
+    if (_nodes_bucket_of[pos] == (bucket + 1)) {
+        return;
+    }
+    if (_nodes_bucket_of[pos] != 0) {
+        for (ptr = &_nodes_buckets[_nodes_bucket_of[pos] - 1];
+             *ptr != (pos + 1); ptr = &_nodes_next[*ptr - 1]) {}
+        *ptr = _nodes_next[pos];
+    }
+    /* keep bucket ordered, so lookups find the same entry as a linear
+     * search would */
+    for (ptr = &_nodes_buckets[bucket]; (*ptr != 0) && (*ptr < (pos + 1));
+         ptr = &_nodes_next[*ptr - 1]) {}
+    _nodes_next[pos] = *ptr;
+    *ptr = pos + 1;
+    _nodes_bucket_of[pos] = bucket + 1;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_INDEX
+    /* cleared entries may linger in the bucket of their former address, but
+     * entries in use are always in the bucket of their current one */
+    for (unsigned i = _nodes_buckets[_nodes_hash(addr)]; i != 0;
+         i = _nodes_next[i - 1]) {
+        _nib_onl_entry_t *node = &_nodes[i - 1];
+#else   /* GNRC_IPV6_NIB_CONF_INDEX */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
@@ -467,6 +561,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+#if GNRC_IPV6_NIB_CONF_INDEX
+                _nodes_index_update(tmp_node);
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -487,6 +584,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if GNRC_IPV6_NIB_CONF_INDEX
+        _trie_add(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
     }
     return dst;
 }
@@ -518,6 +618,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if GNRC_IPV6_NIB_CONF_INDEX
+        _trie_remove(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -541,6 +644,156 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+#if GNRC_IPV6_NIB_CONF_INDEX
+static inline unsigned _addr_bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos / 8] >> (7 - (pos % 8))) & 1;
+}
+
+static uint16_t _trie_alloc(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    uint16_t h;
+    _trie_node_t *node;
+
+    if (_trie_free != 0) {
+        h = _trie_free;
+        _trie_free = _TRIE(h)->child[0];
+    }
+    else {
+        /* a trie with n prefixes has less than 2n nodes */
+        assert(_trie_unused < _TRIE_NUMOF);
+        h = ++_trie_unused;
+    }
+    node = _TRIE(h);
+    memset(node, 0, sizeof(*node));
+    ipv6_addr_init_prefix(&node->pfx, pfx, pfx_len);
+    node->pfx_len = pfx_len;
+    return h;
+}
+
+static unsigned _trie_common_len(const _trie_node_t *node,
+                                 const _nib_offl_entry_t *dst)
+{
+    unsigned res = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+
+    if (res > node->pfx_len) {
+        res = node->pfx_len;
+    }
+    if (res > dst->pfx_len) {
+        res = dst->pfx_len;
+    }
+    return res;
+}
+
+static void _trie_add(const _nib_offl_entry_t *dst)
+{
+    uint16_t pos = (dst - _dsts) + 1;
+    uint16_t *link = &_trie_root, *ptr;
+
+    while (*link != 0) {
+        _trie_node_t *node = _TRIE(*link);
+        unsigned common = _trie_common_len(node, dst);
+
+        if (common < node->pfx_len) {
+            /* dst branches off above node: put a node for the common part
+             * of both in between */
+            uint16_t split = _trie_alloc(&dst->pfx, common);
+
+            _TRIE(split)->child[_addr_bit(&node->pfx, common)] = *link;
+            *link = split;
+        }
+        else if (common == dst->pfx_len) {
+            break;
+        }
+        else {
+            link = &node->child[_addr_bit(&dst->pfx, common)];
+        }
+    }
+    if (*link == 0) {
+        *link = _trie_alloc(&dst->pfx, dst->pfx_len);
+    }
+    /* keep entries with the same prefix ordered, so lookups find the same
+     * entry as a linear search would */
+    for (ptr = &_TRIE(*link)->dsts; (*ptr != 0) && (*ptr < pos);
+         ptr = &_dsts_next[*ptr - 1]) {}
+    _dsts_next[pos - 1] = *ptr;
+    *ptr = pos;
+}
+
+/* removes the node *link refers to if it became redundant */
+static void _trie_collapse(uint16_t *link)
+{
+    uint16_t h = *link;
+    _trie_node_t *node = _TRIE(h);
+
+    if ((node->dsts != 0) ||
+        ((node->child[0] != 0) && (node->child[1] != 0))) {
+        return;
+    }
+    /* replace by its only subtrie, if any */
+    *link = node->child[0] | node->child[1];
+    node->child[0] = _trie_free;
+    _trie_free = h;
+}
+
+static void _trie_remove(const _nib_offl_entry_t *dst)
+{
+    uint16_t pos = (dst - _dsts) + 1;
+    uint16_t *link = &_trie_root, *parent = NULL, *ptr;
+    _trie_node_t *node;
+
+    assert(_trie_root != 0);
+    while (_TRIE(*link)->pfx_len < dst->pfx_len) {
+        parent = link;
+        link = &_TRIE(*link)->child[_addr_bit(&dst->pfx,
+                                              _TRIE(*link)->pfx_len)];
+        assert(*link != 0);
+    }
+    node = _TRIE(*link);
+    assert(_trie_common_len(node, dst) == dst->pfx_len);
+    for (ptr = &node->dsts; *ptr != pos; ptr = &_dsts_next[*ptr - 1]) {
+        assert(*ptr != 0);
+    }
+    *ptr = _dsts_next[pos - 1];
+    _dsts_next[pos - 1] = 0;
+    _trie_collapse(link);
+    if (parent != NULL) {
+        _trie_collapse(parent);
+    }
+}
+
+static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    uint16_t h = _trie_root;
+
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    /* the nodes on the path to dst have increasingly longer prefixes, so the
+     * last one with an entry in use is the longest match */
+    while (h != 0) {
+        _trie_node_t *node = _TRIE(h);
+
+        if (ipv6_addr_match_prefix(&node->pfx, dst) < node->pfx_len) {
+            break;
+        }
+        for (uint16_t i = node->dsts; i != 0; i = _dsts_next[i - 1]) {
+            if (_dsts[i - 1].mode != _EMPTY) {
+                DEBUG("nib: %s/%u matches\n",
+                      ipv6_addr_to_str(addr_str, &node->pfx, sizeof(addr_str)),
+                      node->pfx_len);
+                res = &_dsts[i - 1];
+                break;
+            }
+        }
+        if (node->pfx_len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        h = node->child[_addr_bit(dst, node->pfx_len)];
+    }
+    return res;
+}
+#else   /* GNRC_IPV6_NIB_CONF_INDEX */
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
@@ -569,6 +822,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
     }
     return res;
 }
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
@@ -798,6 +1052,9 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+#if GNRC_IPV6_NIB_CONF_INDEX
+    _nodes_index_update(node);
+#endif  /* GNRC_IPV6_NIB_CONF_INDEX */
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
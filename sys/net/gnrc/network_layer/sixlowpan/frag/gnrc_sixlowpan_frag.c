@@ -21,6 +21,9 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -234,6 +237,11 @@ gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
     return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
 void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 {
     assert(ctx != NULL);
@@ -262,7 +270,7 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* Check whether to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
         /* increment tag for successive, fragmented datagrams */
-        _tag++;
+        gnrc_sixlowpan_frag_next_tag();
         if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
@@ -327,12 +335,33 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+
+    vrbe = gnrc_sixlowpan_frag_vrb_get(gnrc_netif_hdr_get_src_addr(hdr),
+                                       hdr->src_l2addr_len,
+                                       byteorder_ntohs(frag->tag),
+                                       byteorder_ntohs(frag->disp_size) &
+                                       SIXLOWPAN_FRAG_SIZE_MASK);
+    if (vrbe != NULL) {
+        if (offset != 0) {
+            gnrc_sixlowpan_frag_vrb_forward(pkt, vrbe);
+            return;
+        }
+        /* a new first fragment: the previous holder of the tag is gone */
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+#endif
+
     rbuf_add(hdr, pkt, offset, page);
 }
 
 void gnrc_sixlowpan_frag_rbuf_gc(void)
 {
     rbuf_gc();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_gc();
+#endif
 }
 
 void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf)
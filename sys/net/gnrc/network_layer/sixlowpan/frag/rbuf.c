@@ -64,6 +64,12 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag, unsigned page);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+/* gets an existing entry of RFRAGs, identified by their tag only */
+static rbuf_t *_rbuf_get_rfrag(const void *src, size_t src_len,
+                               const void *dst, size_t dst_len,
+                               uint16_t tag);
+#endif
 
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
               size_t offset, unsigned page)
@@ -155,6 +161,105 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     gnrc_pktbuf_release(pkt);
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+uint32_t rbuf_add_rfrag(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                        unsigned page)
+{
+    rbuf_t *entry;
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    uint8_t *data = (uint8_t *)(hdr + 1);
+    unsigned seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+    uint32_t seq_bit = (0x80000000UL >> seq);
+    size_t frag_size = sixlowpan_sfr_rfrag_get_size(hdr);
+    int offset = 0;
+    uint32_t res;
+
+    rbuf_gc();
+    if (frag_size != (pkt->size - sizeof(sixlowpan_sfr_rfrag_t))) {
+        DEBUG("6lo rbuf: RFRAG size does not match frame, discarding\n");
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    if (seq == 0) {
+        entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                          netif_hdr->src_l2addr_len,
+                          gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                          netif_hdr->dst_l2addr_len,
+                          byteorder_ntohs(hdr->offset), hdr->tag, page);
+    }
+    else {
+        entry = _rbuf_get_rfrag(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                netif_hdr->src_l2addr_len,
+                                gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                netif_hdr->dst_l2addr_len, hdr->tag);
+    }
+    if (entry == NULL) {
+        /* out of buffer space or the first fragment is still missing, the
+         * sender will send this fragment again */
+        DEBUG("6lo rbuf: no entry for RFRAG %u\n", seq);
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    if (entry->received & seq_bit) {
+        DEBUG("6lo rbuf: duplicate RFRAG %u\n", seq);
+        gnrc_pktbuf_release(pkt);
+        return entry->received;
+    }
+
+    if (seq == 0) {
+        entry->received = seq_bit;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+        if (sixlowpan_iphc_is(data)) {
+            gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
+                    sizeof(sixlowpan_sfr_rfrag_t), GNRC_NETTYPE_SIXLOWPAN);
+            if (frag_hdr == NULL) {
+                gnrc_pktbuf_release(entry->super.pkt);
+                rbuf_rm(entry);
+                gnrc_pktbuf_release(pkt);
+                return 0;
+            }
+            entry->super.current_size = (uint16_t)frag_size;
+            gnrc_sixlowpan_iphc_recv(pkt, &entry->super, page);
+            if (entry->super.pkt == NULL) {
+                /* dispatched already or dropped */
+                return 0;
+            }
+            /* the other RFRAGs' offsets do not know about decompression */
+            entry->offset_diff = entry->super.current_size - frag_size;
+            return entry->received;
+        }
+#endif
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            data++;
+            frag_size--;
+            entry->offset_diff = -1;
+        }
+    }
+    else {
+        offset = byteorder_ntohs(hdr->offset) + entry->offset_diff;
+    }
+
+    if ((offset < 0) ||
+        ((offset + frag_size) > entry->super.pkt->size)) {
+        DEBUG("6lo rbuf: RFRAG %u out of datagram bounds, discarding datagram\n",
+              seq);
+        gnrc_pktbuf_release(entry->super.pkt);
+        rbuf_rm(entry);
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+
+    entry->received |= seq_bit;
+    entry->super.current_size += (uint16_t)frag_size;
+    memcpy(((uint8_t *)entry->super.pkt->data) + offset, data, frag_size);
+    res = (entry->super.current_size == entry->super.pkt->size) ?
+          SIXLOWPAN_SFR_ACK_BITMAP_FULL : entry->received;
+    gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(&entry->super, netif_hdr);
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+#endif
+
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
 {
     /* start and ends are both inclusive, so using <= for both */
@@ -184,6 +289,10 @@ void rbuf_rm(rbuf_t *entry)
         entry->ints = next;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    entry->received = 0;
+    entry->offset_diff = 0;
+#endif
     entry->super.pkt = NULL;
 }
 
@@ -325,6 +434,10 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    res->received = 0;
+    res->offset_diff = 0;
+#endif
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -339,4 +452,24 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+static rbuf_t *_rbuf_get_rfrag(const void *src, size_t src_len,
+                               const void *dst, size_t dst_len,
+                               uint16_t tag)
+{
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        if ((rbuf[i].super.pkt != NULL) && (rbuf[i].received != 0) &&
+            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
+            (rbuf[i].super.dst_len == dst_len) &&
+            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
+            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
+            rbuf[i].arrival = xtimer_now_usec();
+            _set_rbuf_timeout();
+            return &(rbuf[i]);
+        }
+    }
+    return NULL;
+}
+#endif
+
 /** @} */
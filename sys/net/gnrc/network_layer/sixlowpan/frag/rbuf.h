@@ -65,6 +65,13 @@ typedef struct {
     rbuf_int_t *ints;                   /**< intervals of the fragment */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    uint32_t received;                  /**< bitmap of the received RFRAGs,
+                                         *   0 for RFC 4944 fragments */
+    int16_t offset_diff;                /**< difference between the
+                                         *   uncompressed and compressed
+                                         *   offsets of the RFRAGs */
+#endif
 } rbuf_t;
 
 /**
@@ -84,6 +91,33 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t offset, unsigned page);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Adds a new recoverable fragment to the reassembly buffer. If the
+ *          packet is complete, dispatch the packet with the transmit
+ *          information of the last fragment.
+ *
+ * Fragments other than the first are only accepted after the first one, as
+ * their offset in the uncompressed datagram is unknown before.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment, with
+ *                          gnrc_netif_hdr_t::if_pid and its source and
+ *                          destination address set.
+ * @param[in] frag          The fragment to add. Starts with an RFRAG header.
+ *                          Is released.
+ * @param[in] page          Current 6Lo dispatch parsing page.
+ *
+ * @return  Bitmap of the fragments received so far.
+ * @return  SIXLOWPAN_SFR_ACK_BITMAP_FULL, if the datagram is complete.
+ * @return  0, if the fragment was dropped and there is nothing to
+ *          acknowledge.
+ *
+ * @internal
+ */
+uint32_t rbuf_add_rfrag(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                        unsigned page);
+#endif
+
 /**
  * @brief   Checks timeouts and removes entries if necessary
  */
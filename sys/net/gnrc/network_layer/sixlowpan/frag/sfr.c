@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/neterr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+
+#include "rbuf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+
+#define SEQ_BIT(seq)    (0x80000000UL >> (seq))
+
+/* time after which a sender stops retransmitting fragments of a datagram */
+#define RECENT_TIMEOUT  (GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT * \
+                         (GNRC_SIXLOWPAN_FRAG_SFR_RETRIES + 1))
+
+/* a datagram that was reassembled recently */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /* link-layer source */
+    uint32_t time;                              /* time of completion */
+    uint8_t src_len;                            /* 0 if unused */
+    uint8_t tag;                                /* datagram tag */
+} _recent_t;
+
+static gnrc_sixlowpan_frag_sfr_fb_t _fbuf[GNRC_SIXLOWPAN_FRAG_SFR_FB_SIZE];
+static _recent_t _recent[GNRC_SIXLOWPAN_FRAG_SFR_RECENT_SIZE];
+static unsigned _recent_next;
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/* bitmap with the bits of all fragments of fbuf set */
+static inline uint32_t _all_frags(const gnrc_sixlowpan_frag_sfr_fb_t *fbuf)
+{
+    return (fbuf->frags > SIXLOWPAN_SFR_SEQ_MAX) ? SIXLOWPAN_SFR_ACK_BITMAP_FULL
+                                                 : ~(SIXLOWPAN_SFR_ACK_BITMAP_FULL >>
+                                                     fbuf->frags);
+}
+
+/* identifies a retransmission round of a datagram, so timeouts of earlier
+ * rounds or of a previous datagram in the same entry are ignored */
+static inline uint32_t _arq_id(const gnrc_sixlowpan_frag_sfr_fb_t *fbuf)
+{
+    return ((uint32_t)(fbuf - _fbuf) << 16) | ((uint32_t)fbuf->retries << 8) |
+           fbuf->tag;
+}
+
+static bool _is_complete(const gnrc_sixlowpan_frag_sfr_fb_t *fbuf)
+{
+    return (fbuf->acked & _all_frags(fbuf)) == _all_frags(fbuf);
+}
+
+static void _fb_release(gnrc_sixlowpan_frag_sfr_fb_t *fbuf, uint32_t err)
+{
+    xtimer_remove(&fbuf->arq_timer);
+    gnrc_pktbuf_release_error(fbuf->pkt, err);
+    fbuf->pkt = NULL;
+}
+
+/* copies len bytes starting at offset from the snips of pkt to dst */
+static void _copy(const gnrc_pktsnip_t *pkt, size_t offset, uint8_t *dst,
+                  size_t len)
+{
+    while (len > 0) {
+        if (offset < pkt->size) {
+            size_t clen = _min(pkt->size - offset, len);
+
+            memcpy(dst, ((uint8_t *)pkt->data) + offset, clen);
+            dst += clen;
+            len -= clen;
+            offset = 0;
+        }
+        else {
+            offset -= pkt->size;
+        }
+        pkt = pkt->next;
+    }
+}
+
+static bool _send_frag(gnrc_sixlowpan_frag_sfr_fb_t *fbuf, unsigned seq,
+                       bool ack_req)
+{
+    gnrc_netif_hdr_t *hdr = fbuf->pkt->data, *new_hdr;
+    gnrc_pktsnip_t *netif, *frag;
+    size_t offset = seq * fbuf->frag_size;
+    size_t len = _min(fbuf->frag_size, gnrc_pkt_len(fbuf->pkt->next) - offset);
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(hdr),
+                                 hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(hdr),
+                                 hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header\n");
+        return false;
+    }
+    new_hdr = netif->data;
+    new_hdr->if_pid = hdr->if_pid;
+    new_hdr->flags = hdr->flags;
+    if (!ack_req) {
+        /* Tell the link layer that we will send more fragments */
+        new_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t) + len,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    /* the first fragment carries the datagram size instead of its offset */
+    sixlowpan_sfr_rfrag_set(frag->data, fbuf->tag, seq, len,
+                            (seq == 0) ? fbuf->datagram_size : offset,
+                            ack_req);
+    _copy(fbuf->pkt->next, offset,
+          ((uint8_t *)frag->data) + sizeof(sixlowpan_sfr_rfrag_t), len);
+    netif->next = frag;
+    DEBUG("6lo sfr: send RFRAG (tag: %u, seq: %u, offset: %u, size: %u%s)\n",
+          fbuf->tag, seq, (unsigned)offset, (unsigned)len,
+          (ack_req) ? ", ack request" : "");
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+    return true;
+}
+
+/* sends all unacknowledged fragments of fbuf in one go, the last one
+ * requesting an acknowledgment */
+static void _send_unacked(gnrc_sixlowpan_frag_sfr_fb_t *fbuf)
+{
+    uint32_t unacked = _all_frags(fbuf) & ~fbuf->acked;
+    unsigned last = fbuf->frags - 1;
+
+    if (unacked == 0) {
+        return;
+    }
+    while (!(unacked & SEQ_BIT(last))) {
+        last--;
+    }
+    for (unsigned seq = 0; seq <= last; seq++) {
+        if (!(fbuf->acked & SEQ_BIT(seq)) &&
+            !_send_frag(fbuf, seq, (seq == last))) {
+            /* out of packet buffer: try again on timeout */
+            break;
+        }
+    }
+    fbuf->arq_msg.content.value = _arq_id(fbuf);
+    xtimer_set_msg(&fbuf->arq_timer, GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT,
+                   &fbuf->arq_msg, sched_active_pid);
+}
+
+static _recent_t *_recent_get(const uint8_t *src, size_t src_len, uint8_t tag)
+{
+    uint32_t now = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_RECENT_SIZE; i++) {
+        _recent_t *r = &_recent[i];
+
+        if ((r->src_len == src_len) && (r->tag == tag) &&
+            ((now - r->time) < RECENT_TIMEOUT) &&
+            (memcmp(r->src, src, src_len) == 0)) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+static void _recent_add(const uint8_t *src, size_t src_len, uint8_t tag)
+{
+    _recent_t *r = &_recent[_recent_next];
+
+    _recent_next = (_recent_next + 1) % GNRC_SIXLOWPAN_FRAG_SFR_RECENT_SIZE;
+    memcpy(r->src, src, src_len);
+    r->src_len = src_len;
+    r->tag = tag;
+    r->time = xtimer_now_usec();
+}
+
+static void _send_ack(kernel_pid_t if_pid, uint8_t *dst, size_t dst_len,
+                      uint8_t tag, uint32_t bitmap)
+{
+    gnrc_pktsnip_t *netif, *ack;
+    sixlowpan_sfr_ack_t *hdr;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, dst, dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header\n");
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = if_pid;
+    ack = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (ack == NULL) {
+        DEBUG("6lo sfr: error allocating RFRAG-ACK\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    hdr = ack->data;
+    hdr->disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    hdr->tag = tag;
+    hdr->bitmap = byteorder_htonl(bitmap);
+    netif->next = ack;
+    DEBUG("6lo sfr: send RFRAG-ACK (tag: %u, bitmap: 0x%08lx)\n", tag,
+          (unsigned long)bitmap);
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+}
+
+static void _recv_ack(gnrc_netif_hdr_t *netif_hdr, sixlowpan_sfr_ack_t *ack)
+{
+    uint32_t bitmap = byteorder_ntohl(ack->bitmap);
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_FB_SIZE; i++) {
+        gnrc_sixlowpan_frag_sfr_fb_t *fbuf = &_fbuf[i];
+        gnrc_netif_hdr_t *hdr;
+
+        if ((fbuf->pkt == NULL) || (fbuf->tag != ack->tag)) {
+            continue;
+        }
+        hdr = fbuf->pkt->data;
+        if ((hdr->dst_l2addr_len != netif_hdr->src_l2addr_len) ||
+            (memcmp(gnrc_netif_hdr_get_dst_addr(hdr),
+                    gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    hdr->dst_l2addr_len) != 0)) {
+            continue;
+        }
+        if (bitmap == 0) {
+            DEBUG("6lo sfr: datagram %u aborted by receiver\n", fbuf->tag);
+            _fb_release(fbuf, ECANCELED);
+            return;
+        }
+        /* earlier RFRAG-ACKs may have covered what this one is missing */
+        fbuf->acked |= bitmap;
+        if (_is_complete(fbuf)) {
+            DEBUG("6lo sfr: datagram %u acknowledged\n", fbuf->tag);
+            _fb_release(fbuf, GNRC_NETERR_SUCCESS);
+        }
+        else {
+            xtimer_remove(&fbuf->arq_timer);
+            if (++fbuf->retries > GNRC_SIXLOWPAN_FRAG_SFR_RETRIES) {
+                DEBUG("6lo sfr: giving up datagram %u\n", fbuf->tag);
+                _fb_release(fbuf, ETIMEDOUT);
+            }
+            else {
+                _send_unacked(fbuf);
+            }
+        }
+        return;
+    }
+    DEBUG("6lo sfr: no datagram for RFRAG-ACK with tag %u\n", ack->tag);
+}
+
+bool gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt,
+                                  size_t orig_datagram_size,
+                                  gnrc_netif_t *netif)
+{
+    gnrc_netif_hdr_t *hdr;
+    gnrc_sixlowpan_frag_sfr_fb_t *fbuf = NULL;
+    size_t frag_size, frags;
+
+    assert((pkt != NULL) && (netif != NULL));
+    hdr = pkt->data;
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                      GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        DEBUG("6lo sfr: no acknowledgments for multicast\n");
+        return false;
+    }
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_FB_SIZE; i++) {
+        if (_fbuf[i].pkt == NULL) {
+            fbuf = &_fbuf[i];
+            break;
+        }
+    }
+    if ((fbuf == NULL) ||
+        (netif->sixlo.max_frag_size <= sizeof(sixlowpan_sfr_rfrag_t))) {
+        DEBUG("6lo sfr: fragmentation buffer full\n");
+        return false;
+    }
+    frag_size = _min(netif->sixlo.max_frag_size - sizeof(sixlowpan_sfr_rfrag_t),
+                     SIXLOWPAN_SFR_FRAG_SIZE_MAX);
+    frags = (gnrc_pkt_len(pkt->next) + frag_size - 1) / frag_size;
+    /* the first fragment needs to carry all compressed headers */
+    if ((pkt->next->size > frag_size) || (frags > (SIXLOWPAN_SFR_SEQ_MAX + 1))) {
+        DEBUG("6lo sfr: datagram does not fit into RFRAGs\n");
+        return false;
+    }
+    fbuf->pkt = pkt;
+    fbuf->arq_msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ;
+    fbuf->acked = 0;
+    fbuf->datagram_size = orig_datagram_size;
+    fbuf->frag_size = frag_size;
+    fbuf->tag = (uint8_t)gnrc_sixlowpan_frag_next_tag();
+    fbuf->frags = frags;
+    fbuf->retries = 0;
+    _send_unacked(fbuf);
+    return true;
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    gnrc_netif_hdr_t *hdr = pkt->next->data;
+    sixlowpan_sfr_rfrag_t *rfrag = pkt->data;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t src_len = hdr->src_l2addr_len;
+    kernel_pid_t if_pid = hdr->if_pid;
+    uint8_t tag;
+    bool ack_req;
+    uint32_t bitmap;
+
+    (void)ctx;
+    if (sixlowpan_sfr_ack_is(pkt->data)) {
+        if (pkt->size >= sizeof(sixlowpan_sfr_ack_t)) {
+            _recv_ack(hdr, pkt->data);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((pkt->size < sizeof(sixlowpan_sfr_rfrag_t)) ||
+        (src_len > sizeof(src))) {
+        DEBUG("6lo sfr: invalid RFRAG\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    /* the fragment is released when added to the reassembly buffer */
+    memcpy(src, gnrc_netif_hdr_get_src_addr(hdr), src_len);
+    tag = rfrag->tag;
+    ack_req = sixlowpan_sfr_rfrag_ack_req(rfrag);
+    if (_recent_get(src, src_len, tag) != NULL) {
+        /* the sender missed our last RFRAG-ACK */
+        DEBUG("6lo sfr: RFRAG of completed datagram %u\n", tag);
+        gnrc_pktbuf_release(pkt);
+        if (ack_req) {
+            _send_ack(if_pid, src, src_len, tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+        }
+        return;
+    }
+    bitmap = rbuf_add_rfrag(hdr, pkt, page);
+    if (bitmap == SIXLOWPAN_SFR_ACK_BITMAP_FULL) {
+        _recent_add(src, src_len, tag);
+    }
+    if ((bitmap == SIXLOWPAN_SFR_ACK_BITMAP_FULL) ||
+        (ack_req && (bitmap != 0))) {
+        _send_ack(if_pid, src, src_len, tag, bitmap);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_arq_timeout(uint32_t arq_id)
+{
+    unsigned idx = arq_id >> 16;
+    gnrc_sixlowpan_frag_sfr_fb_t *fbuf;
+
+    if (idx >= GNRC_SIXLOWPAN_FRAG_SFR_FB_SIZE) {
+        return;
+    }
+    fbuf = &_fbuf[idx];
+    if ((fbuf->pkt == NULL) || (_arq_id(fbuf) != arq_id)) {
+        /* acknowledged or retransmitted in the meantime */
+        DEBUG("6lo sfr: stale retransmission timeout\n");
+        return;
+    }
+    if (++fbuf->retries > GNRC_SIXLOWPAN_FRAG_SFR_RETRIES) {
+        DEBUG("6lo sfr: giving up datagram %u\n", fbuf->tag);
+        _fb_release(fbuf, ETIMEDOUT);
+        return;
+    }
+    DEBUG("6lo sfr: retransmission timeout for datagram %u\n", fbuf->tag);
+    _send_unacked(fbuf);
+}
+#else  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+
+/** @} */
@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/ipv6/hdr.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_sixlowpan_frag_vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+/**
+ * @brief first entry (1-based index, 0 for none) of each bucket
+ */
+static uint16_t _buckets[GNRC_SIXLOWPAN_FRAG_VRB_BUCKETS];
+
+/**
+ * @brief next entry (1-based index, 0 for none) in the same bucket
+ */
+static uint16_t _next[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+/**
+ * @brief number of fragments forwarded without reassembly
+ */
+static uint32_t _forwarded;
+
+static inline uint16_t _floor8(uint16_t length)
+{
+    return length & 0xfff8U;
+}
+
+static uint16_t *_bucket(const uint8_t *src, size_t src_len, uint16_t tag)
+{
+    /* FNV-1a */
+    uint32_t h = 2166136261U ^ src_len;
+
+    for (size_t i = 0; i < src_len; i++) {
+        h = (h ^ src[i]) * 16777619U;
+    }
+    h = (h ^ (tag >> 8)) * 16777619U;
+    h = (h ^ (tag & 0xff)) * 16777619U;
+    return &_buckets[h % GNRC_SIXLOWPAN_FRAG_VRB_BUCKETS];
+}
+
+static void _link(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    uint16_t *bucket = _bucket(vrbe->src, vrbe->src_len, vrbe->tag);
+    uint16_t idx = (vrbe - _vrb) + 1;
+
+    _next[idx - 1] = *bucket;
+    *bucket = idx;
+}
+
+static void _unlink(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    uint16_t *link = _bucket(vrbe->src, vrbe->src_len, vrbe->tag);
+    uint16_t idx = (vrbe - _vrb) + 1;
+
+    while ((*link != 0) && (*link != idx)) {
+        link = &_next[*link - 1];
+    }
+    if (*link != 0) {
+        *link = _next[idx - 1];
+    }
+}
+
+/* records the byte range [start, end) of the datagram as forwarded, returns
+ * true if every byte of the datagram was forwarded */
+static bool _add_int(gnrc_sixlowpan_frag_vrb_t *vrbe, uint16_t start,
+                     uint16_t end)
+{
+    gnrc_sixlowpan_frag_vrb_int_t *ints = vrbe->ints;
+    unsigned num = vrbe->ints_num;
+    unsigned i = 0, j;
+
+    if (num > GNRC_SIXLOWPAN_FRAG_VRB_INT_SIZE) {
+        /* lost track of the gaps before, wait for the timeout */
+        return false;
+    }
+    while ((i < num) && (ints[i].end < start)) {
+        i++;
+    }
+    /* merge with all ranges the new one overlaps or touches */
+    for (j = i; (j < num) && (ints[j].start <= end); j++) {
+        if (ints[j].start < start) {
+            start = ints[j].start;
+        }
+        if (ints[j].end > end) {
+            end = ints[j].end;
+        }
+    }
+    if (i == j) {
+        if (num == GNRC_SIXLOWPAN_FRAG_VRB_INT_SIZE) {
+            DEBUG("6lo vrb: too many gaps in datagram (tag %u)\n", vrbe->tag);
+            vrbe->ints_num = UINT8_MAX;
+            return false;
+        }
+        memmove(&ints[i + 1], &ints[i], (num - i) * sizeof(ints[0]));
+        num++;
+    }
+    else {
+        memmove(&ints[i + 1], &ints[j], (num - j) * sizeof(ints[0]));
+        num -= j - i - 1;
+    }
+    ints[i].start = start;
+    ints[i].end = end;
+    vrbe->ints_num = num;
+    return (num == 1) && (ints[0].start == 0) &&
+           (ints[0].end >= vrbe->datagram_size);
+}
+
+static inline bool _expired(const gnrc_sixlowpan_frag_vrb_t *vrbe,
+                            uint32_t now_usec)
+{
+    return (now_usec - vrbe->arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t tag,
+                                                       uint16_t datagram_size,
+                                                       kernel_pid_t out_netif,
+                                                       const uint8_t *out_dst,
+                                                       size_t out_dst_len)
+{
+    gnrc_sixlowpan_frag_vrb_t *res = NULL;
+    uint32_t now_usec = xtimer_now_usec();
+
+    if ((src_len == 0) || (src_len > IEEE802154_LONG_ADDRESS_LEN) ||
+        (out_dst_len > IEEE802154_LONG_ADDRESS_LEN)) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].src_len == 0) || _expired(&_vrb[i], now_usec)) {
+            res = &_vrb[i];
+            break;
+        }
+        /* remember oldest entry */
+        /* note that xtimer_now will overflow in ~1.2 hours */
+        if ((res == NULL) || (res->arrival - _vrb[i].arrival < UINT32_MAX / 2)) {
+            res = &_vrb[i];
+        }
+    }
+    if (res->src_len != 0) {
+        DEBUG("6lo vrb: replacing entry %p\n", (void *)res);
+        gnrc_sixlowpan_frag_vrb_rm(res);
+    }
+    memcpy(res->src, src, src_len);
+    memcpy(res->out_dst, out_dst, out_dst_len);
+    res->arrival = now_usec;
+    res->datagram_size = datagram_size;
+    res->tag = tag;
+    res->out_tag = gnrc_sixlowpan_frag_next_tag();
+    res->ints_num = 0;
+    res->out_netif = out_netif;
+    res->src_len = src_len;
+    res->out_dst_len = out_dst_len;
+    _link(res);
+    DEBUG("6lo vrb: entry %p (tag %u => %u, size %u) created\n", (void *)res,
+          tag, res->out_tag, datagram_size);
+    return res;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t tag,
+                                                       uint16_t datagram_size)
+{
+    for (uint16_t idx = *_bucket(src, src_len, tag); idx != 0;
+         idx = _next[idx - 1]) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[idx - 1];
+
+        if ((vrbe->tag == tag) && (vrbe->datagram_size == datagram_size) &&
+            (vrbe->src_len == src_len) &&
+            (memcmp(vrbe->src, src, src_len) == 0)) {
+            if (_expired(vrbe, xtimer_now_usec())) {
+                gnrc_sixlowpan_frag_vrb_rm(vrbe);
+                return NULL;
+            }
+            return vrbe;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    assert(vrbe != NULL);
+    _unlink(vrbe);
+    vrbe->src_len = 0;
+}
+
+void gnrc_sixlowpan_frag_vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].src_len != 0) && _expired(&_vrb[i], now_usec)) {
+            DEBUG("6lo vrb: entry %p timed out\n", (void *)&_vrb[i]);
+            gnrc_sixlowpan_frag_vrb_rm(&_vrb[i]);
+        }
+    }
+}
+
+static bool _forwardable(const ipv6_hdr_t *ipv6_hdr, size_t frag_len)
+{
+    /* leave everything the IPv6 layer has to look at to reassembly */
+    return (frag_len >= (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t))) &&
+           (ipv6_hdr->hl > 1) &&
+           (ipv6_hdr->nh != PROTNUM_IPV6_EXT_HOPOPT) &&
+           !ipv6_addr_is_multicast(&ipv6_hdr->dst) &&
+           !ipv6_addr_is_link_local(&ipv6_hdr->dst) &&
+           !ipv6_addr_is_link_local(&ipv6_hdr->src) &&
+           (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) == NULL);
+}
+
+bool gnrc_sixlowpan_frag_vrb_forward_1st(gnrc_sixlowpan_rbuf_t *rbuf,
+                                         size_t frag_len)
+{
+    ipv6_hdr_t *ipv6_hdr = rbuf->pkt->data;
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_netif_t *netif;
+    gnrc_pktsnip_t *pkt;
+
+    /* other fragments already went into the reassembly buffer or the first
+     * fragment already completed the datagram */
+    if ((rbuf->current_size != frag_len) || (frag_len >= rbuf->pkt->size) ||
+        !_forwardable(ipv6_hdr, frag_len)) {
+        return false;
+    }
+    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                          &nce) < 0) {
+        DEBUG("6lo vrb: no next hop, reassembling datagram\n");
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((netif == NULL) || !(netif->flags & GNRC_NETIF_FLAGS_6LO_HC) ||
+        (netif->sixlo.max_frag_size == 0)) {
+        return false;
+    }
+    vrbe = gnrc_sixlowpan_frag_vrb_add(rbuf->src, rbuf->src_len, rbuf->tag,
+                                       rbuf->pkt->size, netif->pid,
+                                       nce.l2addr, nce.l2addr_len);
+    if (vrbe == NULL) {
+        return false;
+    }
+    pkt = gnrc_pktbuf_add(NULL, ((uint8_t *)rbuf->pkt->data) + sizeof(ipv6_hdr_t),
+                          frag_len - sizeof(ipv6_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (pkt != NULL) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_add(pkt, ipv6_hdr, sizeof(ipv6_hdr_t),
+                                              GNRC_NETTYPE_IPV6);
+
+        if (tmp != NULL) {
+            pkt = tmp;
+            tmp = gnrc_netif_hdr_build(NULL, 0, nce.l2addr, nce.l2addr_len);
+        }
+        if (tmp == NULL) {
+            gnrc_pktbuf_release(pkt);
+            pkt = NULL;
+        }
+        else {
+            ((gnrc_netif_hdr_t *)tmp->data)->if_pid = netif->pid;
+            tmp->next = pkt;
+            pkt = tmp;
+        }
+    }
+    if (pkt == NULL) {
+        DEBUG("6lo vrb: unable to allocate first fragment\n");
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        return false;
+    }
+    ((ipv6_hdr_t *)pkt->next->data)->hl--;
+    /* the datagram does not need to be reassembled anymore */
+    gnrc_pktbuf_release(rbuf->pkt);
+    gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+    gnrc_sixlowpan_iphc_send(pkt, vrbe, 0);
+    return true;
+}
+
+static void _send_frag(gnrc_sixlowpan_frag_vrb_t *vrbe, gnrc_pktsnip_t *frag,
+                       bool more)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, vrbe->out_dst,
+                                                 vrbe->out_dst_len);
+    gnrc_netif_hdr_t *netif_hdr;
+
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        gnrc_pktbuf_release(frag);
+        return;
+    }
+    netif_hdr = netif->data;
+    netif_hdr->if_pid = vrbe->out_netif;
+    if (more) {
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    netif->next = frag;
+    _forwarded++;
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+}
+
+void gnrc_sixlowpan_frag_vrb_send_1st(gnrc_pktsnip_t *pkt,
+                                      gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                      size_t frag_len)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(vrbe->out_netif);
+    gnrc_pktsnip_t *frag;
+    sixlowpan_frag_t *hdr;
+    /* the (compressed) headers are the only difference between the fragment
+     * we received and the one we send */
+    size_t comp_hdr_len = pkt->next->size;
+    size_t uncomp_hdr_len = frag_len - gnrc_pkt_len(pkt->next->next);
+    size_t comp_len, first_len, max_len;
+
+    assert(netif != NULL);
+    if (gnrc_pktbuf_merge(pkt->next) != 0) {
+        DEBUG("6lo vrb: unable to merge first fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    comp_len = pkt->next->size;
+    max_len = netif->sixlo.max_frag_size - sizeof(sixlowpan_frag_t);
+    first_len = comp_len;
+    if (first_len > max_len) {
+        /* the compressed headers grew: split the fragment where the offset
+         * of the rest in the uncompressed datagram is a multiple of 8 */
+        size_t split = (comp_hdr_len < max_len)
+                     ? _floor8(uncomp_hdr_len + max_len - comp_hdr_len) : 0;
+
+        if ((split <= uncomp_hdr_len) ||
+            ((frag_len - split) >
+             (netif->sixlo.max_frag_size - sizeof(sixlowpan_frag_n_t)))) {
+            DEBUG("6lo vrb: first fragment does not fit, dropping datagram\n");
+            gnrc_sixlowpan_frag_vrb_rm(vrbe);
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        first_len = split - uncomp_hdr_len + comp_hdr_len;
+    }
+
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_frag_t) + first_len,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo vrb: error allocating first fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = frag->data;
+    hdr->disp_size = byteorder_htons(vrbe->datagram_size);
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr->tag = byteorder_htons(vrbe->out_tag);
+    memcpy(hdr + 1, pkt->next->data, first_len);
+    DEBUG("6lo vrb: forward first fragment (tag %u => %u, size %u)\n",
+          vrbe->tag, vrbe->out_tag, (unsigned)first_len);
+    _send_frag(vrbe, frag, true);
+
+    if (first_len < comp_len) {
+        sixlowpan_frag_n_t *hdr_n;
+        size_t offset = uncomp_hdr_len + first_len - comp_hdr_len;
+
+        frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_frag_n_t) +
+                               (comp_len - first_len), GNRC_NETTYPE_SIXLOWPAN);
+        if (frag == NULL) {
+            DEBUG("6lo vrb: error allocating split off fragment\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        hdr_n = frag->data;
+        hdr_n->disp_size = byteorder_htons(vrbe->datagram_size);
+        hdr_n->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr_n->tag = byteorder_htons(vrbe->out_tag);
+        hdr_n->offset = (uint8_t)(offset >> 3);
+        memcpy(hdr_n + 1, ((uint8_t *)pkt->next->data) + first_len,
+               comp_len - first_len);
+        DEBUG("6lo vrb: forward split off fragment (offset %u)\n",
+              (unsigned)offset);
+        _send_frag(vrbe, frag, true);
+    }
+    _add_int(vrbe, 0, frag_len);
+    gnrc_pktbuf_release(pkt);
+}
+
+void gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt,
+                                     gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(vrbe->out_netif);
+    gnrc_pktsnip_t *frag;
+    sixlowpan_frag_n_t *hdr;
+    size_t frag_len = pkt->size - sizeof(sixlowpan_frag_n_t);
+    unsigned offset;
+    bool more;
+
+    if ((pkt->size < sizeof(sixlowpan_frag_n_t)) || (netif == NULL) ||
+        (pkt->size > netif->sixlo.max_frag_size)) {
+        DEBUG("6lo vrb: unable to forward fragment, dropping it\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    frag = gnrc_pktbuf_start_write(pkt);
+    if (frag == NULL) {
+        DEBUG("6lo vrb: unable to get write access to fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    /* replace link-layer header of the received fragment */
+    pkt = gnrc_pktbuf_remove_snip(frag, frag->next);
+    hdr = pkt->data;
+    hdr->tag = byteorder_htons(vrbe->out_tag);
+    vrbe->arrival = xtimer_now_usec();
+    offset = hdr->offset << 3;
+    more = !_add_int(vrbe, offset, offset + frag_len);
+    DEBUG("6lo vrb: forward fragment (tag %u => %u, offset %u)\n",
+          vrbe->tag, vrbe->out_tag, offset);
+    if (!more) {
+        /* every byte of the datagram passed through */
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    _send_frag(vrbe, pkt, more);
+}
+
+uint32_t gnrc_sixlowpan_frag_vrb_forwarded(void)
+{
+    return _forwarded;
+}
+
+/** @} */
@@ -20,6 +20,9 @@
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -122,6 +125,11 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
               (unsigned int)datagram_size, netif->sixlo.max_frag_size);
         gnrc_sixlowpan_msg_frag_t *fragment_msg;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        if (gnrc_sixlowpan_frag_sfr_send(pkt, orig_datagram_size, netif)) {
+            return;
+        }
+#endif
         fragment_msg = gnrc_sixlowpan_msg_frag_get();
         if (fragment_msg == NULL) {
             DEBUG("6lo: Not enough resources to fragment packet. "
@@ -209,6 +217,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_is(dispatch)) {
+        DEBUG("6lo: received 6LoWPAN recoverable fragment\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         DEBUG("6lo: received 6LoWPAN IPHC comressed datagram\n");
@@ -297,11 +312,52 @@ static void _send(gnrc_pktsnip_t *pkt)
     gnrc_sixlowpan_multiplex_by_size(pkt, datagram_size, netif, 0);
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static inline bool _is_frag(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+    gnrc_pktsnip_t *payload = gnrc_pktsnip_search_type(pkt,
+                                                       GNRC_NETTYPE_SIXLOWPAN);
+
+    return (payload != NULL) && (payload->size > 0) &&
+           (sixlowpan_frag_is(payload->data) ||
+            sixlowpan_sfr_is(payload->data));
+#else
+    (void)pkt;
+    return false;
+#endif
+}
+
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if ((cmd == GNRC_NETAPI_MSG_TYPE_RCV) && !_is_frag(pkt)) {
+        _receive(pkt);
+        return;
+    }
+
+    /* the reassembly buffer and fragmentation belong to the 6LoWPAN thread */
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+
+    if (msg_try_send(&msg, _pid) < 1) {
+        DEBUG("6lo: unable to pass packet to 6LoWPAN thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    static gnrc_netreg_entry_cbd_t me_cbd = { .cb = _direct_cb };
+    gnrc_netreg_entry_t me_reg;
+
+    gnrc_netreg_entry_init_cb(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL, &me_cbd);
+#else
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
@@ -344,6 +400,12 @@ static void *_event_loop(void *args)
                 gnrc_sixlowpan_frag_rbuf_gc();
                 break;
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ:
+                DEBUG("6lo: retransmission timeout event received\n");
+                gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.value);
+                break;
+#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
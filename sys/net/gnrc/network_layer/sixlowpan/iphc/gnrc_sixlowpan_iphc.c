@@ -25,6 +25,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
@@ -560,6 +563,16 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
            sixlo->size - payload_offset);
     if (rbuf != NULL) {
         rbuf->current_size += (uncomp_hdr_len - payload_offset);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+        /* recoverable fragments are acknowledged hop by hop, so they are
+         * always reassembled */
+        if (!sixlowpan_sfr_rfrag_is(sixlo->next->data) &&
+            gnrc_sixlowpan_frag_vrb_forward_1st(rbuf, uncomp_hdr_len +
+                                                sixlo->size - payload_offset)) {
+            gnrc_pktbuf_release(sixlo);
+            return;
+        }
+#endif
         gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(rbuf, netif_hdr);
     }
     else {
@@ -1011,6 +1024,14 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     dispatch->next = pkt->next;
     pkt->next = dispatch;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (ctx != NULL) {
+        /* first fragment of a forwarded datagram */
+        gnrc_sixlowpan_frag_vrb_send_1st(pkt, ctx, orig_datagram_size);
+        return;
+    }
+#endif
+
     gnrc_netif_t *netif = gnrc_netif_get_by_pid(netif_hdr->if_pid);
     assert(netif != NULL);
     gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "lfrb.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pcap.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifdef CPU_NATIVE
+#include "native_internal.h"
+#else
+#include "vfs.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_PCAP_BUF_SIZE & (GNRC_PCAP_BUF_SIZE - 1))
+#error "GNRC_PCAP_BUF_SIZE must be a power of 2"
+#endif
+
+#define _FLAG_CAPTURED          (0x0001)
+
+/* pcapng block types and options */
+#define _SHB                    (0x0A0D0D0AUL)
+#define _SHB_MAGIC              (0x1A2B3C4DUL)
+#define _IDB                    (0x00000001UL)
+#define _IDB_IF_NAME            (2U)
+#define _EPB                    (0x00000006UL)
+#define _EPB_FLAGS              (2U)
+#define _OPT_END                (0U)
+
+#define _ALIGN4(x)              (((x) + 3U) & ~3U)
+
+/* frame in the ring buffer, followed by cap_len bytes of data */
+typedef struct {
+    uint8_t dir;
+    kernel_pid_t netif;
+    uint16_t linktype;
+    uint16_t orig_len;
+    uint16_t cap_len;
+    uint32_t ts_high;
+    uint32_t ts_low;
+} _rec_t;
+
+typedef struct {
+    kernel_pid_t netif;
+    uint16_t linktype;
+} _iface_t;
+
+static uint8_t _buf[GNRC_PCAP_BUF_SIZE];
+static lfrb_mpsc_t _rb = LFRB_MPSC_INIT(_buf);
+static gnrc_pcap_stats_t _stats;
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static char _stack[GNRC_PCAP_STACKSIZE];
+static _iface_t _ifaces[GNRC_NETIF_NUMOF];
+static unsigned _ifaces_numof;
+static int _fd = -1;
+
+static void _count(uint32_t *counter)
+{
+    unsigned state = irq_disable();
+
+    (*counter)++;
+    irq_restore(state);
+}
+
+void gnrc_pcap_capture(kernel_pid_t netif, uint16_t linktype,
+                       gnrc_pcap_dir_t dir, const iolist_t *frame)
+{
+    size_t orig_len = iolist_size(frame);
+    uint16_t cap_len = (orig_len < GNRC_PCAP_SNAPLEN) ? orig_len
+                                                      : GNRC_PCAP_SNAPLEN;
+    uint64_t now = xtimer_now_usec64();
+    _rec_t rec;
+    unsigned pos;
+
+    if (lfrb_mpsc_reserve(&_rb, sizeof(rec) + cap_len, &pos) < 0) {
+        _count(&_stats.dropped);
+        return;
+    }
+    rec.dir = dir;
+    rec.netif = netif;
+    rec.linktype = linktype;
+    rec.orig_len = (orig_len > UINT16_MAX) ? UINT16_MAX : orig_len;
+    rec.cap_len = cap_len;
+    rec.ts_high = now >> 32;
+    rec.ts_low = now & UINT32_MAX;
+    lfrb_mpsc_write(&_rb, pos, &rec, sizeof(rec));
+    pos += sizeof(rec);
+    for (; (frame != NULL) && (cap_len > 0); frame = frame->iol_next) {
+        size_t len = (frame->iol_len < cap_len) ? frame->iol_len : cap_len;
+
+        lfrb_mpsc_write(&_rb, pos, frame->iol_base, len);
+        pos += len;
+        cap_len -= len;
+    }
+    lfrb_mpsc_commit(&_rb, sizeof(rec) + rec.cap_len);
+    _count(&_stats.captured);
+    if (_pid != KERNEL_PID_UNDEF) {
+        thread_flags_set((thread_t *)thread_get(_pid), _FLAG_CAPTURED);
+    }
+}
+
+void gnrc_pcap_get_stats(gnrc_pcap_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    *stats = _stats;
+    irq_restore(state);
+}
+
+static int _open(void)
+{
+#ifdef CPU_NATIVE
+    _native_syscall_enter();
+    _fd = real_open(GNRC_PCAP_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    _native_syscall_leave();
+#else
+    _fd = vfs_open(GNRC_PCAP_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    return _fd;
+}
+
+static void _write(const void *data, size_t len)
+{
+    static const uint8_t zeros[3] = { 0 };
+
+    if (data == NULL) {
+        /* padding */
+        data = zeros;
+    }
+#ifdef CPU_NATIVE
+    _native_syscall_enter();
+    real_write(_fd, data, len);
+    _native_syscall_leave();
+#else
+    vfs_write(_fd, data, len);
+#endif
+}
+
+/* writes len bytes from the ring buffer and removes them from it */
+static void _write_rb(size_t len)
+{
+    while (len > 0) {
+        const void *region;
+        size_t n = lfrb_peek_region(&_rb.rb, &region);
+
+        if (n > len) {
+            n = len;
+        }
+        _write(region, n);
+        lfrb_consume(&_rb.rb, n);
+        len -= n;
+    }
+}
+
+static void _write_shb(void)
+{
+    const struct __attribute__((packed)) {
+        uint32_t type;
+        uint32_t len;
+        uint32_t magic;
+        uint16_t major;
+        uint16_t minor;
+        uint64_t section_len;
+        uint32_t len_trailer;
+    } shb = { .type = _SHB, .len = sizeof(shb), .magic = _SHB_MAGIC,
+              .major = 1, .minor = 0, .section_len = UINT64_MAX,
+              .len_trailer = sizeof(shb) };
+
+    _write(&shb, sizeof(shb));
+}
+
+static unsigned _iface_id(kernel_pid_t netif, uint16_t linktype)
+{
+    struct __attribute__((packed)) {
+        uint32_t type;
+        uint32_t len;
+        uint16_t linktype;
+        uint16_t reserved;
+        uint32_t snaplen;
+        uint16_t opt_code;
+        uint16_t opt_len;
+    } idb;
+    const uint32_t opt_end = _OPT_END;
+    char name[8];
+    unsigned id, name_len;
+
+    for (id = 0; id < _ifaces_numof; id++) {
+        if ((_ifaces[id].netif == netif) &&
+            (_ifaces[id].linktype == linktype)) {
+            return id;
+        }
+    }
+    if (_ifaces_numof == GNRC_NETIF_NUMOF) {
+        return UINT_MAX;
+    }
+    _ifaces[id].netif = netif;
+    _ifaces[id].linktype = linktype;
+    _ifaces_numof++;
+    /* describe the new interface */
+    name_len = snprintf(name, sizeof(name), "if%d", (int)netif);
+    idb.type = _IDB;
+    idb.len = sizeof(idb) + _ALIGN4(name_len) + sizeof(opt_end) +
+              sizeof(idb.len);
+    idb.linktype = linktype;
+    idb.reserved = 0;
+    idb.snaplen = GNRC_PCAP_SNAPLEN;
+    idb.opt_code = _IDB_IF_NAME;
+    idb.opt_len = name_len;
+    _write(&idb, sizeof(idb));
+    _write(name, name_len);
+    _write(NULL, _ALIGN4(name_len) - name_len);
+    _write(&opt_end, sizeof(opt_end));
+    _write(&idb.len, sizeof(idb.len));
+    return id;
+}
+
+static void _write_epb(const _rec_t *rec)
+{
+    unsigned id = _iface_id(rec->netif, rec->linktype);
+    uint32_t hdr[7];
+    struct __attribute__((packed)) {
+        uint16_t flags_code;
+        uint16_t flags_len;
+        uint32_t flags;
+        uint32_t end;
+        uint32_t len;
+    } trailer;
+
+    if (id == UINT_MAX) {
+        lfrb_drop(&_rb.rb, rec->cap_len);
+        return;
+    }
+    hdr[0] = _EPB;
+    hdr[1] = sizeof(hdr) + _ALIGN4(rec->cap_len) + sizeof(trailer);
+    hdr[2] = id;
+    hdr[3] = rec->ts_high;
+    hdr[4] = rec->ts_low;
+    hdr[5] = rec->cap_len;
+    hdr[6] = rec->orig_len;
+    /* inbound or outbound */
+    trailer.flags_code = _EPB_FLAGS;
+    trailer.flags_len = sizeof(trailer.flags);
+    trailer.flags = rec->dir;
+    trailer.end = _OPT_END;
+    trailer.len = hdr[1];
+    _write(hdr, sizeof(hdr));
+    _write_rb(rec->cap_len);
+    _write(NULL, _ALIGN4(rec->cap_len) - rec->cap_len);
+    _write(&trailer, sizeof(trailer));
+    _stats.written++;
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    if (_open() < 0) {
+        printf("gnrc_pcap: unable to open %s\n", GNRC_PCAP_FILE);
+        _pid = KERNEL_PID_UNDEF;
+        return NULL;
+    }
+    _write_shb();
+    while (1) {
+        thread_flags_wait_any(_FLAG_CAPTURED);
+        /* only frames copied completely are available for reading */
+        while (!lfrb_empty(&_rb.rb)) {
+            _rec_t rec;
+
+            lfrb_get(&_rb.rb, &rec, sizeof(rec));
+            _write_epb(&rec);
+        }
+    }
+    return NULL;
+}
+
+kernel_pid_t gnrc_pcap_init(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), GNRC_PCAP_PRIO,
+                             THREAD_CREATE_STACKTEST, _thread, NULL,
+                             "pcap");
+    }
+    return _pid;
+}
+
+/** @} */
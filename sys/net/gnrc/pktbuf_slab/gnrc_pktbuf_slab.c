@@ -0,0 +1,595 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer with fixed size classes
+ *
+ * Every pool keeps its free blocks in a LIFO list whose head is changed with a
+ * compare-and-swap only, so no lock is needed to allocate or free a block.
+ * The index of the first free block is stored together with a tag that is
+ * incremented on every change of the head, so that a thread that got
+ * preempted during an allocation notices that the list changed in between
+ * (the ABA problem). The index of the next free block is stored in the first
+ * bytes of a free block.
+ *
+ * gnrc_pktbuf_mark() splits the data of a snip in place, so data blocks have a
+ * reference count of their own. Like gnrc_pktsnip_t::users it is only changed
+ * with interrupts disabled.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "irq.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* blocks are multiples of 8 bytes so that any data structure can be put in */
+#define _WORDS(size)        (((size) + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+#define _STRIDE(size)       (_WORDS(size) * sizeof(uint64_t))
+
+#define _NONE               (0xffff)
+#define _INDEX(head)        ((head) & 0xffff)
+#define _NEXT_TAG(head)     (((head) + 0x10000) & 0xffff0000)
+
+#define _SNIPS              (&_slabs[0])
+#define _DATA_FIRST         (1U)
+#define _NUMOF              (sizeof(_slabs) / sizeof(_slabs[0]))
+
+typedef struct {
+    uint8_t *mem;                   /* first block */
+    uint8_t *refs;                  /* reference counts of data blocks */
+    uint16_t stride;                /* size of a block */
+    uint16_t numof;                 /* number of blocks */
+    atomic_uint_least32_t head;     /* tag << 16 | index of first free block */
+#ifdef DEVELHELP
+    atomic_uint used;               /* blocks in use */
+    atomic_uint max_used;           /* maximum blocks in use */
+    atomic_uint failed;             /* failed allocations of this size */
+    atomic_uint fallbacks;          /* allocations served by a larger class */
+#endif
+} _slab_t;
+
+static uint64_t _snip_mem[GNRC_PKTBUF_SLAB_SNIP_NUMOF *
+                         _WORDS(sizeof(gnrc_pktsnip_t))];
+static uint64_t _small_mem[GNRC_PKTBUF_SLAB_SMALL_NUMOF *
+                          _WORDS(GNRC_PKTBUF_SLAB_SMALL_SIZE)];
+static uint64_t _medium_mem[GNRC_PKTBUF_SLAB_MEDIUM_NUMOF *
+                           _WORDS(GNRC_PKTBUF_SLAB_MEDIUM_SIZE)];
+static uint64_t _large_mem[GNRC_PKTBUF_SLAB_LARGE_NUMOF *
+                          _WORDS(GNRC_PKTBUF_SLAB_LARGE_SIZE)];
+
+static uint8_t _small_refs[GNRC_PKTBUF_SLAB_SMALL_NUMOF];
+static uint8_t _medium_refs[GNRC_PKTBUF_SLAB_MEDIUM_NUMOF];
+static uint8_t _large_refs[GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+static _slab_t _slabs[] = {
+    { .mem = (uint8_t *)_snip_mem, .refs = NULL,
+      .stride = _STRIDE(sizeof(gnrc_pktsnip_t)),
+      .numof = GNRC_PKTBUF_SLAB_SNIP_NUMOF },
+    { .mem = (uint8_t *)_small_mem, .refs = _small_refs,
+      .stride = _STRIDE(GNRC_PKTBUF_SLAB_SMALL_SIZE),
+      .numof = GNRC_PKTBUF_SLAB_SMALL_NUMOF },
+    { .mem = (uint8_t *)_medium_mem, .refs = _medium_refs,
+      .stride = _STRIDE(GNRC_PKTBUF_SLAB_MEDIUM_SIZE),
+      .numof = GNRC_PKTBUF_SLAB_MEDIUM_NUMOF },
+    { .mem = (uint8_t *)_large_mem, .refs = _large_refs,
+      .stride = _STRIDE(GNRC_PKTBUF_SLAB_LARGE_SIZE),
+      .numof = GNRC_PKTBUF_SLAB_LARGE_NUMOF },
+};
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+
+static inline uint8_t *_block(const _slab_t *slab, unsigned idx)
+{
+    return slab->mem + (idx * slab->stride);
+}
+
+/* finds the slab a (possibly interior) pointer belongs to */
+static _slab_t *_slab_of(const void *ptr, unsigned *idx)
+{
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        uintptr_t offset = (uintptr_t)ptr - (uintptr_t)slab->mem;
+
+        if (offset < (uintptr_t)(slab->stride * slab->numof)) {
+            *idx = offset / slab->stride;
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+static inline bool _is_snip(const void *ptr)
+{
+    unsigned idx;
+
+    return _slab_of(ptr, &idx) == _SNIPS;
+}
+
+static void *_slab_alloc(_slab_t *slab)
+{
+    uint_least32_t head = atomic_load_explicit(&slab->head,
+                                               memory_order_acquire);
+    uint_least32_t new_head;
+    uint8_t *block;
+
+    do {
+        if (_INDEX(head) == _NONE) {
+            return NULL;
+        }
+        block = _block(slab, _INDEX(head));
+        /* if the block was taken in the meantime the tag of the head changed
+         * and the compare-and-swap fails, even if the index is the same */
+        new_head = _NEXT_TAG(head) | *((uint16_t *)block);
+    } while (!atomic_compare_exchange_weak_explicit(&slab->head, &head,
+                                                    new_head,
+                                                    memory_order_acquire,
+                                                    memory_order_acquire));
+#ifdef DEVELHELP
+    unsigned used = atomic_fetch_add(&slab->used, 1) + 1;
+    unsigned max_used = atomic_load(&slab->max_used);
+    while ((used > max_used) &&
+           !atomic_compare_exchange_weak(&slab->max_used, &max_used, used)) {}
+#endif
+    return block;
+}
+
+static void _slab_free(_slab_t *slab, unsigned idx)
+{
+    uint_least32_t head = atomic_load_explicit(&slab->head,
+                                               memory_order_relaxed);
+    uint8_t *block = _block(slab, idx);
+
+    do {
+        *((uint16_t *)block) = _INDEX(head);
+    } while (!atomic_compare_exchange_weak_explicit(&slab->head, &head,
+                                                    _NEXT_TAG(head) | idx,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+#ifdef DEVELHELP
+    atomic_fetch_sub(&slab->used, 1);
+#endif
+}
+
+static void *_data_take(_slab_t *slab)
+{
+    uint8_t *data = _slab_alloc(slab);
+
+    if (data != NULL) {
+        slab->refs[(data - slab->mem) / slab->stride] = 1;
+    }
+    return data;
+}
+
+/* finds the smallest data class @p size fits in */
+static _slab_t *_fitting(size_t size)
+{
+    for (unsigned i = _DATA_FIRST; i < _NUMOF; i++) {
+        if (size <= _slabs[i].stride) {
+            return &_slabs[i];
+        }
+    }
+    return NULL;
+}
+
+static void *_data_alloc(size_t size)
+{
+    _slab_t *fitting = _fitting(size);
+
+    if (fitting == NULL) {
+        return NULL;
+    }
+    for (_slab_t *slab = fitting; slab < &_slabs[_NUMOF]; slab++) {
+        void *data = _data_take(slab);
+        if (data != NULL) {
+#ifdef DEVELHELP
+            if (slab != fitting) {
+                atomic_fetch_add(&fitting->fallbacks, 1);
+            }
+#endif
+            return data;
+        }
+    }
+#ifdef DEVELHELP
+    atomic_fetch_add(&fitting->failed, 1);
+#endif
+    DEBUG("pktbuf: no block left for %u bytes\n", (unsigned)size);
+    return NULL;
+}
+
+static void _data_free(void *data)
+{
+    unsigned idx;
+    _slab_t *slab;
+
+    if (data == NULL) {
+        return;
+    }
+    slab = _slab_of(data, &idx);
+    assert((slab != NULL) && (slab != _SNIPS));
+
+    unsigned state = irq_disable();
+    assert(slab->refs[idx] > 0);
+    unsigned refs = --slab->refs[idx];
+    irq_restore(state);
+    if (refs == 0) {
+        _slab_free(slab, idx);
+    }
+}
+
+static void _data_ref(void *data)
+{
+    unsigned idx;
+    _slab_t *slab = _slab_of(data, &idx);
+
+    unsigned state = irq_disable();
+    assert(slab->refs[idx] < UINT8_MAX);
+    slab->refs[idx]++;
+    irq_restore(state);
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+    gnrc_pktsnip_t *pkt = _slab_alloc(_SNIPS);
+
+#ifdef DEVELHELP
+    if (pkt == NULL) {
+        atomic_fetch_add(&_SNIPS->failed, 1);
+    }
+#endif
+    return pkt;
+}
+
+static inline void _snip_block_free(gnrc_pktsnip_t *pkt)
+{
+    _slab_free(_SNIPS, ((uint8_t *)pkt - _SNIPS->mem) / _SNIPS->stride);
+}
+
+static inline void _snip_free(gnrc_pktsnip_t *pkt)
+{
+    _data_free(pkt->data);
+    _snip_block_free(pkt);
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        assert(slab->numof < _NONE);
+        for (unsigned j = 0; j < slab->numof; j++) {
+            *((uint16_t *)_block(slab, j)) = (j + 1 < slab->numof) ? j + 1 : _NONE;
+        }
+        atomic_store(&slab->head, (slab->numof > 0) ? 0 : _NONE);
+#ifdef DEVELHELP
+        atomic_store(&slab->used, 0);
+        atomic_store(&slab->max_used, 0);
+        atomic_store(&slab->failed, 0);
+        atomic_store(&slab->fallbacks, 0);
+#endif
+    }
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    if (size > _slabs[_NUMOF - 1].stride) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SLAB_LARGE_SIZE);
+        return NULL;
+    }
+    return _create_snip(next, data, size, type);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *marked_data;
+
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        return NULL;
+    }
+    marked_data = pkt->data;
+    if (pkt->size == size) {
+        pkt->data = NULL;
+    }
+    else {
+        /* both snips use the block now */
+        _data_ref(pkt->data);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, marked_data, size, type);
+    pkt->next = marked_snip;
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _data_free(pkt->data);
+        pkt->data = NULL;
+    }
+    else {
+        unsigned idx;
+        _slab_t *slab = (pkt->data) ? _slab_of(pkt->data, &idx) : NULL;
+        void *new_data = NULL;
+
+        if ((slab != NULL) && (slab > &_slabs[_DATA_FIRST]) &&
+            (size <= (slab - 1)->stride)) {
+            /* the larger blocks are scarce, so try to move to a smaller one */
+            new_data = _data_take(_fitting(size));
+        }
+        if ((new_data == NULL) &&
+            ((slab == NULL) ||
+             ((size > pkt->size) &&
+              ((slab->refs[idx] > 1) ||
+               ((uint8_t *)pkt->data + size > _block(slab, idx) + slab->stride))))) {
+            /* new size does not fit into the block, or the data behind
+             * belongs to another snip */
+            new_data = _data_alloc(size);
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                return ENOMEM;
+            }
+        }
+        if (new_data != NULL) {
+            if (pkt->data != NULL) {
+                memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+            }
+            _data_free(pkt->data);
+            pkt->data = new_data;
+        }
+    }
+    pkt->size = size;
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    unsigned state = irq_disable();
+
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    irq_restore(state);
+}
+
+/* drops one reference of a single snip */
+static void _release_snip(gnrc_pktsnip_t *pkt)
+{
+    unsigned state = irq_disable();
+
+    assert(pkt->users > 0);
+    unsigned users = --pkt->users;
+    irq_restore(state);
+    if (users == 0) {
+        _snip_free(pkt);
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+
+        assert(_is_snip(pkt));
+        tmp = pkt->next;
+        /* report before the snip is reused */
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        _release_snip(pkt);
+        pkt = tmp;
+    }
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        return NULL;
+    }
+    unsigned state = irq_disable();
+    unsigned users = pkt->users;
+    irq_restore(state);
+    if (users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            /* other users might have released the snip in the meantime */
+            _release_snip(pkt);
+        }
+        return new;
+    }
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[] = { "snips", "small", "medium", "large" };
+
+    printf("packet buffer: %u bytes in %u size classes\n",
+           (unsigned)(sizeof(_snip_mem) + sizeof(_small_mem) +
+                      sizeof(_medium_mem) + sizeof(_large_mem)),
+           (unsigned)_NUMOF);
+    printf("%-8s %6s %8s %8s %8s %9s\n", "class", "size", "used", "max",
+           "failed", "fallbacks");
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        printf("%-8s %6u %3u/%-4u %8u %8u %9u\n", names[i],
+               (unsigned)slab->stride, atomic_load(&slab->used),
+               (unsigned)slab->numof, atomic_load(&slab->max_used),
+               atomic_load(&slab->failed), atomic_load(&slab->fallbacks));
+    }
+}
+#endif
+
+#ifdef TEST_SUITES
+static unsigned _free_blocks(const _slab_t *slab)
+{
+    unsigned idx = _INDEX(atomic_load(&slab->head));
+    unsigned count = 0;
+
+    while ((idx != _NONE) && (count <= slab->numof)) {
+        if (idx >= slab->numof) {
+            /* corrupt list, make sure the result doesn't match */
+            return slab->numof + 1;
+        }
+        count++;
+        idx = *((uint16_t *)_block(slab, idx));
+    }
+    return count;
+}
+
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        if (_free_blocks(&_slabs[i]) != _slabs[i].numof) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - every free list only contains indexes of blocks of its pool
+     *  - no free list contains more blocks than its pool (i.e. no cycles)
+     */
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        if (_free_blocks(&_slabs[i]) > _slabs[i].numof) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _data_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _snip_block_free(pkt);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if ((data != NULL) && (size > 0)) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = gnrc_pktbuf_add(next, NULL, size, type);
+
+    if (new == NULL) {
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    gnrc_pktbuf_release(pkt);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    return new;
+}
+
+/** @} */
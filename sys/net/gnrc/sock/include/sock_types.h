@@ -31,6 +31,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +43,17 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+struct gnrc_sock_reg;
+
+/**
+ * @brief   Event callback for @ref gnrc_sock_reg_t
+ * @internal
+ */
+typedef void (*gnrc_sock_reg_cb_t)(struct gnrc_sock_reg *reg,
+                                   sock_async_flags_t flags);
+#endif  /* defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN) */
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
@@ -51,6 +65,17 @@ typedef struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   netreg callback, puts the packet into gnrc_sock_reg_t::mbox
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    /**
+     * @brief   asynchronous event callback, set by the sock type
+     *          implementation to call the user's callback
+     */
+    gnrc_sock_reg_cb_t async_cb;
+#endif
 } gnrc_sock_reg_t;
 
 /**
@@ -62,6 +87,10 @@ struct sock_ip {
     sock_ip_ep_t local;                 /**< local end-point */
     sock_ip_ep_t remote;                /**< remote end-point */
     uint16_t flags;                     /**< option flags */
+#if (defined(MODULE_SOCK_ASYNC) && defined(MODULE_SOCK_IP)) || defined(DOXYGEN)
+    sock_ip_cb_t async_cb;              /**< asynchronous event callback */
+    void *async_cb_arg;                 /**< argument for sock_ip::async_cb */
+#endif
 };
 
 /**
@@ -73,6 +102,10 @@ struct sock_udp {
     sock_udp_ep_t local;                /**< local end-point */
     sock_udp_ep_t remote;               /**< remote end-point */
     uint16_t flags;                     /**< option flags */
+#if (defined(MODULE_SOCK_ASYNC) && defined(MODULE_SOCK_UDP)) || defined(DOXYGEN)
+    sock_udp_cb_t async_cb;             /**< asynchronous event callback */
+    void *async_cb_arg;                 /**< argument for sock_udp::async_cb */
+#endif
 };
 
 #ifdef __cplusplus
@@ -54,6 +54,10 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         }
         gnrc_ep_set(&sock->remote, remote, sizeof(sock_ip_ep_t));
     }
+#ifdef MODULE_SOCK_ASYNC
+    sock->reg.async_cb = NULL;
+    sock->async_cb = NULL;
+#endif
     gnrc_sock_create(&sock->reg, GNRC_NETTYPE_IPV6,
                      proto);
     sock->flags = flags;
@@ -88,12 +92,40 @@ int sock_ip_get_remote(sock_ip_t *sock, sock_ip_ep_t *remote)
 
 ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
                      uint32_t timeout, sock_ip_ep_t *remote)
+{
+    void *pkt = NULL, *ctx = NULL;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = sock_ip_recv_buf(sock, &pkt, &ctx, timeout, remote);
+    if (res <= 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, pkt, res);
+    }
+    /* release the packet */
+    sock_ip_recv_buf(sock, &pkt, &ctx, 0, NULL);
+    return res;
+}
+
+ssize_t sock_ip_recv_buf(sock_ip_t *sock, void **data, void **buf_ctx,
+                         uint32_t timeout, sock_ip_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
     if (sock->local.family == 0) {
         return -EADDRNOTAVAIL;
     }
@@ -102,10 +134,6 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     if (remote != NULL) {
         /* return remote to possibly block if wrong remote */
         memcpy(remote, &tmp, sizeof(tmp));
@@ -119,10 +147,15 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
-    gnrc_pktbuf_release(pkt);
-    return res;
+    if (pkt->size == 0) {
+        /* nothing to hand out, so nothing to release later either */
+        gnrc_pktbuf_release(pkt);
+        *data = NULL;
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (int)pkt->size;
 }
 
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
@@ -198,4 +231,24 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+static void _async_cb(gnrc_sock_reg_t *reg, sock_async_flags_t flags)
+{
+    sock_ip_t *sock = container_of(reg, sock_ip_t, reg);
+
+    if (sock->async_cb != NULL) {
+        sock->async_cb(sock, flags, sock->async_cb_arg);
+    }
+}
+
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = NULL;
+    sock->async_cb_arg = cb_arg;
+    sock->async_cb = cb;
+    sock->reg.async_cb = _async_cb;
+}
+#endif  /* MODULE_SOCK_ASYNC */
+
 /** @} */
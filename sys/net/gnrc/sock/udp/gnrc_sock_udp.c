@@ -135,6 +135,10 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         gnrc_ep_set((sock_ip_ep_t *)&sock->remote,
                     (sock_ip_ep_t *)remote, sizeof(sock_udp_ep_t));
     }
+#ifdef MODULE_SOCK_ASYNC
+    sock->reg.async_cb = NULL;
+    sock->async_cb = NULL;
+#endif
     if (local != NULL) {
         /* listen only with local given */
         gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, sock->local.port);
@@ -177,13 +181,41 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
 
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote)
+{
+    void *pkt = NULL, *ctx = NULL;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = sock_udp_recv_buf(sock, &pkt, &ctx, timeout, remote);
+    if (res <= 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, pkt, res);
+    }
+    /* release the packet */
+    sock_udp_recv_buf(sock, &pkt, &ctx, 0, NULL);
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -192,10 +224,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -214,10 +242,15 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
-    gnrc_pktbuf_release(pkt);
-    return res;
+    if (pkt->size == 0) {
+        /* nothing to hand out, so nothing to release later either */
+        gnrc_pktbuf_release(pkt);
+        *data = NULL;
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (int)pkt->size;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
@@ -320,4 +353,24 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+static void _async_cb(gnrc_sock_reg_t *reg, sock_async_flags_t flags)
+{
+    sock_udp_t *sock = container_of(reg, sock_udp_t, reg);
+
+    if (sock->async_cb != NULL) {
+        sock->async_cb(sock, flags, sock->async_cb_arg);
+    }
+}
+
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = NULL;
+    sock->async_cb_arg = cb_arg;
+    sock->async_cb = cb;
+    sock->reg.async_cb = _async_cb;
+}
+#endif  /* MODULE_SOCK_ASYNC */
+
 /** @} */
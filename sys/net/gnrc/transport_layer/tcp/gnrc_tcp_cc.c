@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ * @}
+ */
+
+#include <stdbool.h>
+#include "internal/common.h"
+#include "internal/pkt.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Calculates the slow start threshold after a loss: Half the data in flight.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The new slow start threshold, at least two segments.
+ */
+static uint32_t _cc_halve(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+    uint32_t min = 2 * _cc_get_smss(tcb);
+    return ((flight / 2) > min) ? (flight / 2) : min;
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_get_smss(tcb);
+
+    /* Initial window, see RFC 5681 section 3.1 */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = UINT32_MAX;
+    tcb->recover = tcb->iss;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _cc_get_smss(tcb);
+
+    tcb->dup_acks = 0;
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full acknowledgment: Leave fast recovery with a deflated window */
+        if (GRT_32_BIT(tcb->snd_una, tcb->recover)) {
+            uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+            flight = ((flight > smss) ? flight : smss) + smss;
+            tcb->cwnd = (tcb->ssthresh < flight) ? tcb->ssthresh : flight;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : Leave fast recovery, cwnd=%lu\n",
+                  (unsigned long) tcb->cwnd);
+        }
+        /* Partial acknowledgment: The next segment was lost as well, retransmit it */
+        else {
+            _pkt_retransmit_next(tcb, false);
+            tcb->cwnd -= (acked < tcb->cwnd) ? acked : tcb->cwnd;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+        }
+        return;
+    }
+
+    /* Slow start */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance: About one segment per round trip */
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+
+    /* Retransmit segments that are lost since a retransmission timeout */
+    _pkt_retransmit_lost(tcb);
+}
+
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_get_smss(tcb);
+
+    /* In fast recovery every duplicate ACK means that a segment left the network */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd += smss;
+#ifdef MODULE_GNRC_TCP_SACK
+        /* Retransmit the next hole the peer reported */
+        _pkt_retransmit_next(tcb, true);
+#endif
+        return;
+    }
+
+    tcb->dup_acks += 1;
+    if (tcb->dup_acks < GNRC_TCP_DUP_ACK_THRESHOLD) {
+        return;
+    }
+
+    /* Enter fast recovery only, if the loss happened after the last recovery (see RFC 6582) */
+    if (!GRT_32_BIT(tcb->snd_una, tcb->recover)) {
+        return;
+    }
+    tcb->ssthresh = _cc_halve(tcb);
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUP_ACK_THRESHOLD * smss;
+    tcb->status |= STATUS_FAST_RECOVERY;
+    DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : Fast retransmit, ssthresh=%lu\n",
+          (unsigned long) tcb->ssthresh);
+
+    /* Fast retransmit: Start a new recovery episode */
+    for (unsigned i = 0; i < tcb->snd_queue_len; ++i) {
+        _pkt_get_snd_seg(tcb, i)->flags &= ~SEG_RETRANSMITTED;
+    }
+    _pkt_retransmit_next(tcb, false);
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Halve the threshold only for the first timeout of a segment (see RFC 5681) */
+    if (tcb->retries == 0) {
+        tcb->ssthresh = _cc_halve(tcb);
+    }
+    tcb->cwnd = _cc_get_smss(tcb);
+    tcb->recover = tcb->snd_nxt - 1;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+
+    /* Everything in flight is considered lost, except for what the peer SACKed */
+    for (unsigned i = 0; i < tcb->snd_queue_len; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, i);
+        seg->flags &= ~SEG_RETRANSMITTED;
+        if (!(seg->flags & SEG_SACKED)) {
+            seg->flags |= SEG_LOST;
+        }
+    }
+}
@@ -26,6 +26,7 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
+#include "internal/cc.h"
 #include "internal/fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -83,10 +84,15 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->snd_queue_len > 0) {
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        while (tcb->snd_queue_len > 0) {
+            gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, 0);
+            gnrc_pktbuf_release(seg->pkt);
+            seg->pkt = NULL;
+            tcb->snd_queue_head = (tcb->snd_queue_head + 1) % GNRC_TCP_SND_QUEUE_SIZE;
+            tcb->snd_queue_len -= 1;
+        }
     }
     return 0;
 }
@@ -147,6 +153,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             }
 #endif
             tcb->peer_port = PORT_UNSPEC;
+            tcb->status &= ~STATUS_SACK_PERMITTED;
 
             /* Allocate receive buffer */
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
@@ -266,24 +273,40 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    uint32_t smss = _cc_get_smss(tcb);
+    uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+    size_t sent = 0;
+
+    /* Send segments while there is data left, the window is open and the send queue */
+    /* has room. One entry is kept free for the FIN. */
+    while (sent < len && tcb->snd_queue_len < GNRC_TCP_SND_QUEUE_SIZE - 1) {
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+        if (flight >= wnd) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = wnd - flight;
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < len - sent) ? payload : len - sent;
 
-        /* Calculate payload size for this segment */
+        /* Avoid small segments while data is in flight (silly window syndrome) */
+        if (payload < smss && payload < len - sent && flight > 0) {
+            break;
+        }
+
+        /* Build and send segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -505,6 +528,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
+            _cc_init(tcb);
 
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
@@ -570,6 +594,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_wnd = seg_wnd;
             tcb->snd_wl1 = seg_seq;
             tcb->snd_wl2 = seg_ack;
+            _cc_init(tcb);
         }
         return 0;
     }
@@ -631,8 +656,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+
+                    /* Signal user: The send queue has room again */
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -641,6 +671,15 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                     _pkt_send(tcb, out_pkt, seq_con, false);
                     return 0;
                 }
+                /* Duplicate ACK: No data, no window update, but data in flight */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 &&
+                         !(ctl & (MSK_SYN | MSK_FIN)) && seg_wnd == tcb->snd_wnd &&
+                         tcb->snd_queue_len > 0) {
+                    _cc_dup_ack(tcb);
+
+                    /* Signal user: The congestion window might allow new data */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
                 /* Update receive window */
                 if (LEQ_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     if (LSS_32_BIT(tcb->snd_wl1, seg_seq) || (tcb->snd_wl1 == seg_seq &&
@@ -656,25 +695,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -689,32 +728,30 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                /* Accept data that is expected, to be received */
+                if (LEQ_32_BIT(seg_seq, tcb->rcv_nxt)) {
+                    /* Copy contents and kept out-of-order segments into receive buffer */
+                    _rcvbuf_add(tcb, in_pkt, seg_seq);
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+                /* Keep data that arrived ahead of missing data, the FIN is sent again */
+                else if (!(ctl & MSK_FIN)) {
+                    _rcvbuf_ooo_add(tcb, in_pkt, seg_seq, pay_len);
+                }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
-                if (!(ctl & MSK_FIN)) {
+                if (!(ctl & MSK_FIN) || tcb->rcv_nxt != seg_seq + pay_len) {
                     _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
                                NULL, 0);
                     _pkt_send(tcb, out_pkt, seq_con, false);
                 }
             }
         }
-        /* 7) Check FIN */
-        if (ctl & MSK_FIN) {
+        /* 7) Check FIN, if all data in front of it was received */
+        if ((ctl & MSK_FIN) && tcb->rcv_nxt == seg_seq + pay_len) {
             if (tcb->state == FSM_STATE_CLOSED || tcb->state == FSM_STATE_LISTEN ||
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
@@ -728,7 +765,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->snd_queue_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -770,9 +807,12 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->snd_queue_len > 0) {
+        /* Retransmit the oldest segment, the others follow as the window opens again */
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, 0);
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, seg->pkt, true);
+        _pkt_resend(tcb, seg);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
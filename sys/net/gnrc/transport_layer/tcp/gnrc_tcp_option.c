@@ -16,8 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "internal/common.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -38,6 +40,13 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     while (opt_left > 0) {
         tcp_hdr_opt_t *option = (tcp_hdr_opt_t *) opt_ptr;
 
+        /* All options except EOL and NOP carry a length field, that must fit */
+        if ((option->kind != TCP_OPTION_KIND_EOL) && (option->kind != TCP_OPTION_KIND_NOP) &&
+            ((opt_left < 2) || (option->length < 2) || (option->length > opt_left))) {
+            DEBUG("gnrc_tcp_option.c : _option_parse() : invalid option length.\n");
+            return -1;
+        }
+
         /* Examine current option */
         switch (option->kind) {
             case TCP_OPTION_KIND_EOL:
@@ -60,6 +69,40 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+#ifdef MODULE_GNRC_TCP_SACK
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted length.\n");
+                    return -1;
+                }
+                /* SACK is only negotiated during connection setup */
+                if (byteorder_ntohs(hdr->off_ctl) & MSK_SYN) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (option->length < 10 || ((option->length - 2) % 8) != 0 ||
+                    option->length > opt_left) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK option length.\n");
+                    return -1;
+                }
+                /* Mark the segments covered by each block */
+                if (tcb->status & STATUS_SACK_PERMITTED) {
+                    for (uint8_t *blk = option->value; blk < opt_ptr + option->length; blk += 8) {
+                        network_uint32_t left;
+                        network_uint32_t right;
+                        memcpy(&left, blk, sizeof(left));
+                        memcpy(&right, blk + sizeof(left), sizeof(right));
+                        _pkt_sack(tcb, byteorder_ntohl(left), byteorder_ntohl(right));
+                    }
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found\n");
+                break;
+#endif
+
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
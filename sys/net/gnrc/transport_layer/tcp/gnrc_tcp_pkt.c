@@ -25,6 +25,7 @@
 #include "internal/common.h"
 #include "internal/option.h"
 #include "internal/pkt.h"
+#include "internal/rcvbuf.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -46,6 +47,44 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Calculates the RTO from the current round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no estimation yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Performs boundry checks on the RTO and (re)starts the retransmission timer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _start_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    xtimer_remove(&tcb->tim_tout);
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt, gnrc_pktsnip_t *in_pkt)
 {
     tcp_hdr_t tcp_hdr_out;
@@ -171,12 +210,29 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+#ifdef MODULE_GNRC_TCP_SACK
+        /* Offer SACK on SYN, accept it on SYN+ACK if the peer offered it */
+        if (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED)) {
+            offset += 1;
+        }
+#endif
     }
+#ifdef MODULE_GNRC_TCP_SACK
+    /* Report out-of-order received data on pure ACKs */
+    uint32_t sack_blocks[2 * OPTION_SACK_BLOCKS_MAX];
+    unsigned sack_num = 0;
+    if (ctl == MSK_ACK && payload_len == 0 && (tcb->status & STATUS_SACK_PERMITTED)) {
+        sack_num = _rcvbuf_get_sack_blocks(tcb, sack_blocks, OPTION_SACK_BLOCKS_MAX);
+        if (sack_num > 0) {
+            offset += 1 + 2 * sack_num;
+        }
+    }
+#endif
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
     /* Allocate TCP header: size = offset * 4 bytes */
-    tcp_snp = gnrc_pktbuf_add(pay_snp, &tcp_hdr, offset * 4, GNRC_NETTYPE_TCP);
+    tcp_snp = gnrc_pktbuf_add(pay_snp, NULL, offset * 4, GNRC_NETTYPE_TCP);
     if (tcp_snp == NULL) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_build() : Can't allocate buffer for TCP Header\n.");
         gnrc_pktbuf_release(pay_snp);
@@ -184,6 +240,8 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
         return -ENOMEM;
     }
     else {
+        memcpy(tcp_snp->data, &tcp_hdr, sizeof(tcp_hdr));
+
         /* Add options if existing */
         if (TCP_HDR_OFFSET_MIN < offset) {
             uint8_t *opt_ptr = (uint8_t *) tcp_snp->data + sizeof(tcp_hdr);
@@ -196,9 +254,31 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+                opt_left -= sizeof(mss_option);
             }
             /* Increase opt_ptr and decrease opt_ptr, if other options are added */
             /* NOTE: Add additional options here */
+#ifdef MODULE_GNRC_TCP_SACK
+            /* If SACK permitted option is accounted for: Add it */
+            if ((ctl & MSK_SYN) && opt_left >= sizeof(network_uint32_t)) {
+                network_uint32_t sack_perm_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+                opt_left -= sizeof(sack_perm_option);
+            }
+            /* If there are SACK blocks to report: Add SACK option */
+            if (sack_num > 0) {
+                network_uint32_t sack_option = byteorder_htonl(_option_build_sack(sack_num));
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+                for (unsigned i = 0; i < 2 * sack_num; ++i) {
+                    network_uint32_t edge = byteorder_htonl(sack_blocks[i]);
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                }
+            }
+#endif
         }
         *(out_pkt) = tcp_snp;
     }
@@ -262,12 +342,21 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+
+        /* Time one segment per round trip */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_MEASURE)) {
+            tcb->status |= STATUS_RTT_MEASURE;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt;
+        }
     }
+    /* The send queue keeps its user, the retransmission consumes a new one */
     else {
-        tcb->retries += 1;
+        gnrc_pktbuf_hold(out_pkt, 1);
+
+        /* Retransmitted segments must not be timed (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_MEASURE;
     }
 
     /* Pass packet down the network stack */
@@ -351,15 +440,25 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
+    /* Retransmission timeout: Double the rto (Timer Backoff) */
+    if (retransmit) {
+        tcb->rto *= 2;
+        tcb->retries += 1;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+        _start_retransmit_timer(tcb);
+        return 0;
     }
 
     /* Extract control bits and segment length */
     LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
-    ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
+    tcp_hdr_t *hdr = (tcp_hdr_t *) snp->data;
+    ctl = byteorder_ntohs(hdr->off_ctl);
     len = _pkt_get_pay_len(pkt);
 
     /* Check if pkt contains reset or is a pure ACK, return */
@@ -367,76 +466,56 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
-
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
-        }
+    /* Check if send queue is full */
+    if (tcb->snd_queue_len >= GNRC_TCP_SND_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Send queue is full\n");
+        return -ENOMEM;
     }
-    else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
 
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
-        }
-    }
+    /* Append pkt and increase users: every send attempt consumes a user */
+    gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, tcb->snd_queue_len);
+    seg->pkt = pkt;
+    seg->seq = byteorder_ntohl(hdr->seq_num);
+    seg->len = _pkt_get_seg_len(pkt);
+    seg->flags = 0;
+    tcb->snd_queue_len += 1;
+    gnrc_pktbuf_hold(pkt, 1);
 
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    /* Start the retransmission timer, if it is not running for an older segment */
+    if (tcb->snd_queue_len == 1) {
+        _calc_rto(tcb);
+        _start_retransmit_timer(tcb);
     }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
-    }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
-
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->snd_queue_len == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* Release all segments that are acknowledged completely */
+    while (tcb->snd_queue_len > 0) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, 0);
+        if (!LEQ_32_BIT(seg->seq + seg->len, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(seg->pkt);
+        seg->pkt = NULL;
+        tcb->snd_queue_head = (tcb->snd_queue_head + 1) % GNRC_TCP_SND_QUEUE_SIZE;
+        tcb->snd_queue_len -= 1;
+    }
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_MEASURE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
+        tcb->status &= ~STATUS_RTT_MEASURE;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        /* Use time only if ther was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -451,9 +530,90 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* New data was acknowledged: Restart the timer for the remaining segments (see RFC 6298) */
+    tcb->retries = 0;
+    xtimer_remove(&(tcb->tim_tout));
+    if (tcb->snd_queue_len > 0) {
+        _calc_rto(tcb);
+        _start_retransmit_timer(tcb);
+    }
     return 0;
 }
 
+int _pkt_resend(gnrc_tcp_tcb_t *tcb, gnrc_tcp_seg_t *seg)
+{
+    seg->flags &= ~SEG_LOST;
+    seg->flags |= SEG_RETRANSMITTED;
+    return _pkt_send(tcb, seg->pkt, 0, true);
+}
+
+int _pkt_retransmit_next(gnrc_tcp_tcb_t *tcb, const bool hole)
+{
+    bool sacked_after = false;
+    int next = -1;
+
+    /* Search the first segment that was neither SACKed nor retransmitted already */
+    for (unsigned i = 0; i < tcb->snd_queue_len; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, i);
+        if (seg->flags & SEG_SACKED) {
+            sacked_after = true;
+        }
+        else if (next < 0 && !(seg->flags & SEG_RETRANSMITTED)) {
+            next = i;
+        }
+    }
+    /* A hole is a segment in front of a SACKed segment */
+    if (next < 0 || (hole && !sacked_after)) {
+        return -ENODATA;
+    }
+    return _pkt_resend(tcb, _pkt_get_snd_seg(tcb, next));
+}
+
+void _pkt_retransmit_lost(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t pipe = 0;
+
+    /* Estimate the data in flight: Lost and SACKed segments left the network */
+    for (unsigned i = 0; i < tcb->snd_queue_len; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, i);
+        if (!(seg->flags & (SEG_SACKED | SEG_LOST))) {
+            pipe += seg->len;
+        }
+    }
+
+    /* Retransmit lost segments as long as the congestion window permits */
+    for (unsigned i = 0; i < tcb->snd_queue_len; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, i);
+        if (seg->flags & SEG_LOST) {
+            if (pipe + seg->len > tcb->cwnd) {
+                break;
+            }
+            pipe += seg->len;
+            _pkt_resend(tcb, seg);
+        }
+    }
+}
+
+#ifdef MODULE_GNRC_TCP_SACK
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    /* Ignore blocks that do not lie between snd_una and snd_nxt */
+    if (!LSS_32_BIT(left, right) || LSS_32_BIT(left, tcb->snd_una) ||
+        LSS_32_BIT(tcb->snd_nxt, right)) {
+        return;
+    }
+    /* Mark all segments the block covers completely */
+    for (unsigned i = 0; i < tcb->snd_queue_len; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(tcb, i);
+        if (LEQ_32_BIT(left, seg->seq) && LEQ_32_BIT(seg->seq + seg->len, right)) {
+            seg->flags |= SEG_SACKED;
+            seg->flags &= ~SEG_LOST;
+        }
+    }
+}
+#endif
+
 uint16_t _pkt_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr,
                         const gnrc_pktsnip_t *payload)
 {
@@ -16,6 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <stdbool.h>
+#include <utlist.h>
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -92,10 +96,175 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief Copy payload that was not received yet into the receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in]     pkt   Received packet.
+ * @param[in]     seq   Sequence number of the first payload byte in @p pkt.
+ */
+static void _rcvbuf_add_payload(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    uint32_t skip = tcb->rcv_nxt - seq;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (skip < snp->size) {
+            tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), (char *) snp->data + skip,
+                                           snp->size - skip);
+            skip = 0;
+        }
+        else {
+            skip -= snp->size;
+        }
+        snp = snp->next;
+    }
+}
+
+/**
+ * @brief Release an entry of the out-of-order queue.
+ *
+ * @param[in,out] seg   Entry to release.
+ */
+static void _rcvbuf_ooo_free(gnrc_tcp_seg_t *seg)
+{
+    gnrc_pktbuf_release(seg->pkt);
+    seg->pkt = NULL;
+}
+
+void _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq)
+{
+    bool progress = true;
+
+    _rcvbuf_add_payload(tcb, pkt, seq);
+
+    /* Move out-of-order segments whose gap is filled now */
+    while (progress) {
+        progress = false;
+        for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+            gnrc_tcp_seg_t *seg = &(tcb->rcv_ooo[i]);
+            if (seg->pkt != NULL && LEQ_32_BIT(seg->seq, tcb->rcv_nxt)) {
+                if (LSS_32_BIT(tcb->rcv_nxt, seg->seq + seg->len)) {
+                    _rcvbuf_add_payload(tcb, seg->pkt, seg->seq);
+                    progress = true;
+                }
+                _rcvbuf_ooo_free(seg);
+            }
+        }
+    }
+}
+
+int _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq,
+                    const uint32_t len)
+{
+    gnrc_tcp_seg_t *slot = NULL;
+    gnrc_tcp_seg_t *last = NULL;
+
+    /* Keep only segments that fit into the receive window completely */
+    if (len == 0 || !LEQ_32_BIT(seq + len, tcb->rcv_nxt + tcb->rcv_wnd)) {
+        return -ENOSPC;
+    }
+
+    for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        gnrc_tcp_seg_t *seg = &(tcb->rcv_ooo[i]);
+        if (seg->pkt == NULL) {
+            slot = (slot == NULL) ? seg : slot;
+            continue;
+        }
+        /* Payload is kept already */
+        if (LEQ_32_BIT(seg->seq, seq) && LEQ_32_BIT(seq + len, seg->seq + seg->len)) {
+            return -EALREADY;
+        }
+        if (last == NULL || LSS_32_BIT(last->seq, seg->seq)) {
+            last = seg;
+        }
+    }
+
+    /* If the queue is full: Data closer to rcv_nxt replaces the last segment */
+    if (slot == NULL) {
+        if (!LSS_32_BIT(seq, last->seq)) {
+            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_ooo_add() : Out-of-order queue is full\n");
+            return -ENOMEM;
+        }
+        _rcvbuf_ooo_free(last);
+        slot = last;
+    }
+
+    for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        tcb->rcv_ooo[i].flags &= ~SEG_RECENT;
+    }
+    gnrc_pktbuf_hold(pkt, 1);
+    slot->pkt = pkt;
+    slot->seq = seq;
+    slot->len = len;
+    slot->flags = SEG_RECENT;
+    return 0;
+}
+
+#ifdef MODULE_GNRC_TCP_SACK
+unsigned _rcvbuf_get_sack_blocks(gnrc_tcp_tcb_t *tcb, uint32_t *blocks, const unsigned max)
+{
+    gnrc_tcp_seg_t *sorted[GNRC_TCP_RCV_OOO_SIZE];
+    uint32_t edges[2 * GNRC_TCP_RCV_OOO_SIZE];
+    unsigned num = 0;
+    unsigned cnt = 0;
+    unsigned recent = 0;
+
+    /* Sort out-of-order segments by sequence number */
+    for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        gnrc_tcp_seg_t *seg = &(tcb->rcv_ooo[i]);
+        if (seg->pkt != NULL) {
+            unsigned pos = num++;
+            while (pos > 0 && LSS_32_BIT(seg->seq, sorted[pos - 1]->seq)) {
+                sorted[pos] = sorted[pos - 1];
+                pos -= 1;
+            }
+            sorted[pos] = seg;
+        }
+    }
+
+    /* Merge adjacent and overlapping segments into blocks */
+    for (unsigned i = 0; i < num; ++i) {
+        uint32_t right = sorted[i]->seq + sorted[i]->len;
+        if (cnt > 0 && LEQ_32_BIT(sorted[i]->seq, edges[2 * cnt - 1])) {
+            if (LSS_32_BIT(edges[2 * cnt - 1], right)) {
+                edges[2 * cnt - 1] = right;
+            }
+        }
+        else {
+            edges[2 * cnt] = sorted[i]->seq;
+            edges[2 * cnt + 1] = right;
+            cnt += 1;
+        }
+        if (sorted[i]->flags & SEG_RECENT) {
+            recent = cnt - 1;
+        }
+    }
+
+    /* The block holding the most recently received segment comes first (see RFC 2018) */
+    unsigned out = 0;
+    for (unsigned i = 0; i < cnt && out < max; ++i) {
+        unsigned blk = (i == 0) ? recent : ((i <= recent) ? i - 1 : i);
+        blocks[2 * out] = edges[2 * blk];
+        blocks[2 * out + 1] = edges[2 * blk + 1];
+        out += 1;
+    }
+    return out;
+}
+#endif
+
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
         _rcvbuf_free(tcb->rcv_buf_raw);
         tcb->rcv_buf_raw = NULL;
     }
+
+    /* Drop kept out-of-order segments */
+    for (size_t i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        if (tcb->rcv_ooo[i].pkt != NULL) {
+            _rcvbuf_ooo_free(&(tcb->rcv_ooo[i]));
+        }
+    }
 }
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       TCP congestion control (NewReno, see RFC 5681 and RFC 6582).
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/config.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the sender maximum segment size.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The MSS announced by the peer, limited to GNRC_TCP_MSS.
+ */
+static inline uint32_t _cc_get_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->mss == 0 || tcb->mss > GNRC_TCP_MSS) {
+        return GNRC_TCP_MSS;
+    }
+    return tcb->mss;
+}
+
+/**
+ * @brief Initialize congestion control, after the peers MSS is known.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handle an ACK acknowledging new data.
+ *
+ * @pre snd_una was advanced and the send queue was updated already.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked);
+
+/**
+ * @brief Handle a duplicate ACK.
+ *
+ * Enters fast retransmit and fast recovery on GNRC_TCP_DUP_ACK_THRESHOLD
+ * duplicate ACKs.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handle an expired retransmission timer.
+ *
+ * Shrinks the congestion window and marks all segments in the send queue as lost.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
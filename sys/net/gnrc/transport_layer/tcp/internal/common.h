@@ -49,6 +49,19 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_FAST_RECOVERY  (1 << 4)
+#define STATUS_RTT_MEASURE    (1 << 5)
+#define STATUS_SACK_PERMITTED (1 << 6)
+/** @} */
+
+/**
+ * @brief Flags of segments in the send queue and the out-of-order queue
+ * @{
+ */
+#define SEG_SACKED            (1 << 0)
+#define SEG_LOST              (1 << 1)
+#define SEG_RETRANSMITTED     (1 << 2)
+#define SEG_RECENT            (1 << 3)
 /** @} */
 
 /**
@@ -44,6 +44,37 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Maximum number of SACK blocks in the SACK option (see RFC 2018).
+ */
+#define OPTION_SACK_BLOCKS_MAX (4U)
+
+/**
+ * @brief Helper function to build the SACK permitted option, padded with NOPs.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to build the SACK option header, padded with NOPs.
+ *
+ * @param[in] blocks   Number of SACK blocks following the option header.
+ *
+ * @returns   SACK option header value.
+ */
+static inline uint32_t _option_build_sack(unsigned blocks)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK << 8) | (2 + blocks * 8));
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
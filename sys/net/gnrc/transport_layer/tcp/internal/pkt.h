@@ -22,6 +22,7 @@
 #ifndef PKT_H
 #define PKT_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "net/gnrc.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -66,6 +67,8 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
 /**
  * @brief Sends packet to peer.
  *
+ * @note A retransmitted packet stays in the send queue, a new user is held for sending it.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     out_pkt      Pointer to paket to send.
  * @param[in]     seq_con      Sequence number consumption of the packet to send.
@@ -107,9 +110,27 @@ uint32_t _pkt_get_seg_len(gnrc_pktsnip_t *pkt);
  */
 uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief Get a segment in the send queue.
+ *
+ * @param[in] tcb   TCB holding the send queue.
+ * @param[in] i     Position of the segment, zero is the oldest segment.
+ *
+ * @returns   The segment at position @p i.
+ */
+static inline gnrc_tcp_seg_t *_pkt_get_snd_seg(gnrc_tcp_tcb_t *tcb, const unsigned i)
+{
+    return &tcb->snd_queue[(tcb->snd_queue_head + i) % GNRC_TCP_SND_QUEUE_SIZE];
+}
+
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * If @p retransmit is not set, @p pkt is appended to the send queue and the
+ * retransmission timer is started, if it is not running already. If
+ * @p retransmit is set, the retransmission timer expired: The RTO is backed
+ * off and the timer restarted.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
@@ -121,7 +142,7 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -131,6 +152,43 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Sends a segment of the send queue again.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in,out] seg   Segment to retransmit.
+ *
+ * @returns   Zero on success.
+ */
+int _pkt_resend(gnrc_tcp_tcb_t *tcb, gnrc_tcp_seg_t *seg);
+
+/**
+ * @brief Retransmits the first segment that was neither SACKed nor retransmitted.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     hole   Retransmit the segment only, if a SACKed segment follows it.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if there is no such segment.
+ */
+int _pkt_retransmit_next(gnrc_tcp_tcb_t *tcb, const bool hole);
+
+/**
+ * @brief Retransmits segments marked as lost, as far as the congestion window permits.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _pkt_retransmit_lost(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Marks the segments covered by a SACK block.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
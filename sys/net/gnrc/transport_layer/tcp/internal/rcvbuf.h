@@ -63,7 +63,46 @@ void _rcvbuf_init(void);
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Copy the payload of an in-order segment into the receive buffer.
+ *
+ * Payload in front of rcv_nxt is skipped, rcv_nxt is advanced. Afterwards kept
+ * out-of-order segments that became in-order are copied as well.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in]     pkt   Received packet.
+ * @param[in]     seq   Sequence number of the first payload byte in @p pkt.
+ */
+void _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq);
+
+/**
+ * @brief Keep a segment that arrived ahead of missing data.
+ *
+ * @param[in,out] tcb   TCB holding the out-of-order queue.
+ * @param[in]     pkt   Received packet, a user is held for it.
+ * @param[in]     seq   Sequence number of the first payload byte in @p pkt.
+ * @param[in]     len   Payload length of @p pkt.
+ *
+ * @returns   Zero on success.
+ *            -ENOSPC if @p pkt exceeds the receive window.
+ *            -EALREADY if the payload is kept already.
+ *            -ENOMEM if the out-of-order queue is full.
+ */
+int _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq,
+                    const uint32_t len);
+
+/**
+ * @brief Get the SACK blocks describing the kept out-of-order segments.
+ *
+ * @param[in]  tcb      TCB holding the out-of-order queue.
+ * @param[out] blocks   Left and right edges of the blocks.
+ * @param[in]  max      Maximum number of blocks to store in @p blocks.
+ *
+ * @returns   Number of blocks stored in @p blocks.
+ */
+unsigned _rcvbuf_get_sack_blocks(gnrc_tcp_tcb_t *tcb, uint32_t *blocks, const unsigned max);
+
+/**
+ * @brief Release allocated receive buffer and kept out-of-order segments.
  *
  * @param[in,out] tcb   TCB holding the receive buffer that should be released.
  */
@@ -220,13 +220,34 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    else if (gnrc_netapi_send(_pid, pkt) < 1) {
+        DEBUG("udp: unable to pass packet to UDP thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+#endif
+
 static void *_event_loop(void *arg)
 {
     (void)arg;
     msg_t msg, reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    static gnrc_netreg_entry_cbd_t cbd = { .cb = _direct_cb };
+    gnrc_netreg_entry_t netreg;
+
+    gnrc_netreg_entry_init_cb(&netreg, GNRC_NETREG_DEMUX_CTX_ALL, &cbd);
+#else
     gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
     /* preset reply message */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
     reply.content.value = (uint32_t)-ENOTSUP;
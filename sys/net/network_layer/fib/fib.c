@@ -19,11 +19,13 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "kernel_defines.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -65,6 +67,482 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+#ifdef MODULE_FIB_RADIX
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#define FIB_RADIX_USED      (0x01)  /**< node is in use */
+#define FIB_RADIX_ENTRY     (0x02)  /**< node is the node of an entry */
+#define FIB_RADIX_DUP       (0x04)  /**< entry has the prefix of another one */
+
+static inline fib_entry_t *_radix_entry(fib_radix_node_t *node)
+{
+    return container_of(node, fib_entry_t, node);
+}
+
+/**
+ * @brief returns bit @p pos of an address, bits beyond its end are 0
+ */
+static inline unsigned _bit(const uint8_t *addr, size_t addr_size, unsigned pos)
+{
+    if ((pos >> 3) >= addr_size) {
+        return 0;
+    }
+    return (addr[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/**
+ * @brief returns the number of leading bits two addresses have in common,
+ *        but at most @p max
+ */
+static unsigned _common_len(const uint8_t *a, size_t a_size,
+                            const uint8_t *b, size_t b_size, unsigned max)
+{
+    unsigned len = 0;
+
+    while (len < max) {
+        unsigned i = len >> 3;
+        uint8_t diff = ((i < a_size) ? a[i] : 0) ^ ((i < b_size) ? b[i] : 0);
+
+        if (diff != 0) {
+            while (!(diff & 0x80)) {
+                diff <<= 1;
+                len++;
+            }
+            break;
+        }
+        len += 8;
+    }
+
+    return (len < max) ? len : max;
+}
+
+/**
+ * @brief returns the number of bits an entry's destination is matched on
+ */
+static unsigned _prefix_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned bits = global->address_size << 3;
+    unsigned len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                   >> FIB_FLAG_NET_PREFIX_SHIFT;
+
+    for (size_t i = 0; i < global->address_size; i++) {
+        if (global->address[i] != 0) {
+            /* entries without prefix length only match exactly */
+            return ((len == 0) || (len > bits)) ? bits : len;
+        }
+    }
+
+    /* the all-zero address is the default route matching everything */
+    return 0;
+}
+
+/**
+ * @brief returns any entry in the sub tree of @p node
+ */
+static fib_entry_t *_radix_any_entry(fib_radix_node_t *node)
+{
+    /* branching nodes always have two children */
+    while (!(node->flags & FIB_RADIX_ENTRY)) {
+        node = node->child[0];
+    }
+    return _radix_entry(node);
+}
+
+/**
+ * @brief returns the pointer pointing to @p node in the tree
+ */
+static fib_radix_node_t **_radix_link(fib_table_t *table, fib_radix_node_t *node)
+{
+    fib_radix_node_t *parent = node->parent;
+
+    if (parent == NULL) {
+        return &table->radix_root;
+    }
+    return &parent->child[parent->child[1] == node];
+}
+
+/**
+ * @brief moves a node to another place in memory
+ */
+static void _radix_move(fib_table_t *table, fib_radix_node_t *from,
+                        fib_radix_node_t *to)
+{
+    *to = *from;
+    *_radix_link(table, from) = to;
+    for (unsigned i = 0; i < 2; i++) {
+        if (to->child[i] != NULL) {
+            to->child[i]->parent = to;
+        }
+    }
+    memset(from, 0, sizeof(*from));
+}
+
+/**
+ * @brief returns a spare node of an entry in use other than @p except
+ *
+ * A tree with n entries never needs more than n - 1 branching nodes, so
+ * there is always one left.
+ */
+static fib_radix_node_t *_radix_glue_alloc(fib_table_t *table,
+                                           fib_entry_t *except)
+{
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry != except) && (entry->node.flags & FIB_RADIX_USED) &&
+            !(entry->glue.flags & FIB_RADIX_USED)) {
+            return &entry->glue;
+        }
+    }
+
+    assert(false);
+    return NULL;
+}
+
+/**
+ * @brief adds a new entry to the radix tree of the table
+ */
+static void _radix_add(fib_table_t *table, fib_entry_t *entry)
+{
+    universal_address_container_t *key = entry->global;
+    fib_radix_node_t *node = &entry->node;
+    fib_radix_node_t *parent = NULL;
+    fib_radix_node_t **link = &table->radix_root;
+
+    /* an entry not in the tree never lends its spare node */
+    assert(!(entry->glue.flags & FIB_RADIX_USED));
+
+    memset(node, 0, sizeof(*node));
+    node->len = _prefix_len(entry);
+    node->flags = FIB_RADIX_USED | FIB_RADIX_ENTRY;
+    entry->dup = NULL;
+
+    while (*link != NULL) {
+        fib_radix_node_t *cur = *link;
+        universal_address_container_t *cur_key = _radix_any_entry(cur)->global;
+        unsigned common = _common_len(key->address, key->address_size,
+                                      cur_key->address, cur_key->address_size,
+                                      (node->len < cur->len) ? node->len : cur->len);
+
+        if (common < cur->len) {
+            if (common < node->len) {
+                /* branch where the entry and the sub tree differ */
+                fib_radix_node_t *glue = &entry->glue;
+
+                glue->len = common;
+                glue->flags = FIB_RADIX_USED;
+                glue->parent = parent;
+                glue->child[_bit(key->address, key->address_size, common)] = node;
+                glue->child[_bit(cur_key->address, cur_key->address_size, common)] = cur;
+                node->parent = glue;
+                cur->parent = glue;
+                *link = glue;
+                return;
+            }
+            /* the entry is a prefix of the whole sub tree */
+            node->child[_bit(cur_key->address, cur_key->address_size,
+                             node->len)] = cur;
+            cur->parent = node;
+            break;
+        }
+
+        if (node->len == cur->len) {
+            if (cur->flags & FIB_RADIX_ENTRY) {
+                /* same prefix, but different host bits or address size */
+                fib_entry_t *first = _radix_entry(cur);
+
+                node->flags |= FIB_RADIX_DUP;
+                node->parent = cur;
+                entry->dup = first->dup;
+                first->dup = entry;
+                return;
+            }
+            /* the entry replaces the branching node */
+            _radix_move(table, cur, node);
+            node->flags = FIB_RADIX_USED | FIB_RADIX_ENTRY;
+            return;
+        }
+
+        parent = cur;
+        link = &cur->child[_bit(key->address, key->address_size, cur->len)];
+    }
+
+    node->parent = parent;
+    *link = node;
+}
+
+/**
+ * @brief removes an entry from the radix tree of the table
+ */
+static void _radix_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_radix_node_t *node = &entry->node;
+
+    if (!(node->flags & FIB_RADIX_USED)) {
+        return;
+    }
+
+    if (node->flags & FIB_RADIX_DUP) {
+        fib_entry_t *prev = _radix_entry(node->parent);
+
+        while (prev->dup != entry) {
+            prev = prev->dup;
+        }
+        prev->dup = entry->dup;
+    }
+    else if (entry->dup != NULL) {
+        /* the next entry with the same prefix takes over the node */
+        fib_entry_t *next = entry->dup;
+
+        _radix_move(table, node, &next->node);
+        for (fib_entry_t *dup = next->dup; dup != NULL; dup = dup->dup) {
+            dup->node.parent = &next->node;
+        }
+    }
+    else if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* the tree still needs to branch here */
+        fib_radix_node_t *glue = _radix_glue_alloc(table, entry);
+
+        _radix_move(table, node, glue);
+        glue->flags = FIB_RADIX_USED;
+    }
+    else {
+        fib_radix_node_t *parent = node->parent;
+        fib_radix_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                           : node->child[1];
+
+        *_radix_link(table, node) = child;
+        if (child != NULL) {
+            child->parent = parent;
+        }
+        else if ((parent != NULL) && !(parent->flags & FIB_RADIX_ENTRY)) {
+            /* the branching node above has only one sub tree left */
+            child = (parent->child[0] != NULL) ? parent->child[0]
+                                               : parent->child[1];
+            *_radix_link(table, parent) = child;
+            child->parent = parent->parent;
+            memset(parent, 0, sizeof(*parent));
+        }
+    }
+
+    if (entry->glue.flags & FIB_RADIX_USED) {
+        /* the spare node of this entry still holds a branching node */
+        _radix_move(table, &entry->glue, _radix_glue_alloc(table, entry));
+    }
+    memset(node, 0, sizeof(*node));
+    entry->dup = NULL;
+}
+
+static inline fib_entry_t *_heap_get(fib_table_t *table, unsigned pos)
+{
+    return &table->data.entries[table->data.entries[pos].heap_slot];
+}
+
+static inline void _heap_set(fib_table_t *table, unsigned pos, fib_entry_t *entry)
+{
+    table->data.entries[pos].heap_slot = entry - table->data.entries;
+    entry->heap_pos = pos + 1;
+}
+
+/**
+ * @brief restores the heap order for the entry at position @p pos
+ */
+static void _heap_sift(fib_table_t *table, unsigned pos)
+{
+    fib_entry_t *entry = _heap_get(table, pos);
+
+    while (pos > 0) {
+        fib_entry_t *parent = _heap_get(table, (pos - 1) / 2);
+
+        if (parent->lifetime <= entry->lifetime) {
+            break;
+        }
+        _heap_set(table, pos, parent);
+        pos = (pos - 1) / 2;
+    }
+
+    while ((2 * pos + 1) < table->heap_numof) {
+        unsigned next = 2 * pos + 1;
+        fib_entry_t *child = _heap_get(table, next);
+
+        if ((next + 1) < table->heap_numof) {
+            fib_entry_t *right = _heap_get(table, next + 1);
+
+            if (right->lifetime < child->lifetime) {
+                child = right;
+                next++;
+            }
+        }
+        if (entry->lifetime <= child->lifetime) {
+            break;
+        }
+        _heap_set(table, pos, child);
+        pos = next;
+    }
+
+    _heap_set(table, pos, entry);
+}
+
+static void _expiry_cb(void *arg)
+{
+    ((fib_table_t *)arg)->expired = 1;
+}
+
+/**
+ * @brief sets the expiry timer to the lifetime of the earliest entry
+ */
+static void _expiry_timer_set(fib_table_t *table)
+{
+    if (table->heap_numof == 0) {
+        xtimer_remove(&table->expiry_timer);
+        table->expiry_time = 0;
+        return;
+    }
+
+    uint64_t lifetime = _heap_get(table, 0)->lifetime;
+
+    if (lifetime == table->expiry_time) {
+        return;
+    }
+
+    uint64_t now = xtimer_now_usec64();
+
+    table->expiry_time = lifetime;
+    if (lifetime <= now) {
+        xtimer_remove(&table->expiry_timer);
+        table->expired = 1;
+    }
+    else {
+        xtimer_set64(&table->expiry_timer, lifetime - now);
+    }
+}
+
+/**
+ * @brief adds, moves or removes an entry in the lifetime heap after its
+ *        lifetime changed
+ */
+static void _heap_update(fib_table_t *table, fib_entry_t *entry)
+{
+    bool expires = (entry->lifetime != 0) &&
+                   (entry->lifetime != FIB_LIFETIME_NO_EXPIRE);
+
+    if (expires) {
+        if (entry->heap_pos == 0) {
+            _heap_set(table, table->heap_numof++, entry);
+        }
+        _heap_sift(table, entry->heap_pos - 1);
+    }
+    else if (entry->heap_pos != 0) {
+        unsigned pos = entry->heap_pos - 1;
+        fib_entry_t *last = _heap_get(table, --table->heap_numof);
+
+        entry->heap_pos = 0;
+        if (last != entry) {
+            /* fill the gap with the last entry of the heap */
+            _heap_set(table, pos, last);
+            _heap_sift(table, pos);
+        }
+    }
+    else {
+        return;
+    }
+
+    _expiry_timer_set(table);
+}
+
+/**
+ * @brief removes all entries whose lifetime expired
+ */
+static void fib_expire(fib_table_t *table)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    table->expired = 0;
+    while (table->heap_numof > 0) {
+        fib_entry_t *entry = _heap_get(table, 0);
+
+        if (entry->lifetime > now) {
+            break;
+        }
+        fib_remove(table, entry);
+    }
+}
+
+/**
+ * @brief returns pointer to the entry for the given destination address
+ *
+ * @param[in] table                the FIB table to search in
+ * @param[in] dst                  the destination address
+ * @param[in] dst_size             the destination address size
+ * @param[out] entry_arr           the array to scribe the found match
+ * @param[in, out] entry_arr_size  the number of entries provided by entry_arr (should be always 1)
+ *                                 this value is overwritten with the actual found number
+ *
+ * @return 0 if we found a next-hop prefix
+ *         1 if we found the exact address next-hop
+ *         -EHOSTUNREACH if no fitting next-hop is available
+ */
+static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                          fib_entry_t **entry_arr, size_t *entry_arr_size) {
+    fib_entry_t *match = NULL;
+    unsigned bits = dst_size << 3;
+
+    if (table->expired) {
+        fib_expire(table);
+    }
+
+    fib_radix_node_t *node = table->radix_root;
+
+    while (node != NULL) {
+        if (node->flags & FIB_RADIX_ENTRY) {
+            fib_entry_t *entry = _radix_entry(node);
+            universal_address_container_t *global = entry->global;
+
+            if (_common_len(global->address, global->address_size,
+                            dst, dst_size, node->len) < node->len) {
+                /* no entry below can match either */
+                break;
+            }
+
+            fib_entry_t *found = NULL;
+            for (; entry != NULL; entry = entry->dup) {
+                if (entry->global->address_size != dst_size) {
+                    continue;
+                }
+                if (memcmp(entry->global->address, dst, dst_size) == 0) {
+                    entry_arr[0] = entry;
+                    *entry_arr_size = 1;
+                    /* we will not find a better one so we return */
+                    return 1;
+                }
+                if (found == NULL) {
+                    found = entry;
+                }
+            }
+            if (found != NULL) {
+                /* entries further down have longer prefixes */
+                match = found;
+            }
+        }
+
+        if (node->len >= bits) {
+            break;
+        }
+        node = node->child[_bit(dst, dst_size, node->len)];
+    }
+
+    if (match == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
+    }
+
+    DEBUG("[fib_find_entry] found prefix on interface %d\n", match->iface_id);
+    entry_arr[0] = match;
+    *entry_arr_size = 1;
+    return 0;
+}
+#else
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -188,10 +666,12 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     *entry_arr_size = count;
     return ret;
 }
+#endif
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table containing the entry
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +681,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -222,6 +702,12 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
 
+#ifdef MODULE_FIB_RADIX
+    _heap_update(table, entry);
+#else
+    (void)table;
+#endif
+
     return 0;
 }
 
@@ -268,6 +754,10 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+#ifdef MODULE_FIB_RADIX
+                _radix_add(table, &table->data.entries[i]);
+                _heap_update(table, &table->data.entries[i]);
+#endif
                 return 0;
             }
         }
@@ -279,12 +769,19 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table containing the entry
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+#ifdef MODULE_FIB_RADIX
+    _radix_remove(table, entry);
+#else
+    (void)table;
+#endif
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -301,6 +798,10 @@ static int fib_remove(fib_entry_t *entry)
     entry->iface_id = KERNEL_PID_UNDEF;
     entry->lifetime = 0;
 
+#ifdef MODULE_FIB_RADIX
+    _heap_update(table, entry);
+#endif
+
     return 0;
 }
 
@@ -403,7 +904,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +934,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +958,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +978,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,6 +1097,14 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_RADIX
+        table->radix_root = NULL;
+        table->heap_numof = 0;
+        table->expiry_time = 0;
+        table->expired = 0;
+        table->expiry_timer.callback = _expiry_cb;
+        table->expiry_timer.arg = table;
+#endif
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -621,6 +1130,13 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_RADIX
+        xtimer_remove(&table->expiry_timer);
+        table->radix_root = NULL;
+        table->heap_numof = 0;
+        table->expiry_time = 0;
+        table->expired = 0;
+#endif
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
@@ -12,6 +12,7 @@
  * @file
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "od.h"
@@ -60,6 +61,40 @@ void sixlowpan_print(uint8_t *data, size_t size)
                     size - sizeof(sixlowpan_frag_n_t),
                     OD_WIDTH_DEFAULT);
     }
+    else if (sixlowpan_sfr_rfrag_is(data)) {
+        sixlowpan_sfr_rfrag_t *hdr = (sixlowpan_sfr_rfrag_t *)data;
+        unsigned seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+
+        puts("Recoverable Fragment Header");
+        printf("ECN: %u, ack request: %u\n",
+               (unsigned)(hdr->disp_ecn & SIXLOWPAN_SFR_ECN),
+               (unsigned)sixlowpan_sfr_rfrag_ack_req(hdr));
+        printf("tag: 0x%02x\n", (unsigned)hdr->tag);
+        printf("sequence: %u\n", seq);
+        printf("fragment size: %u\n",
+               (unsigned)sixlowpan_sfr_rfrag_get_size(hdr));
+        printf("%s: %u\n", (seq == 0) ? "datagram size" : "offset",
+               (unsigned)byteorder_ntohs(hdr->offset));
+
+        if (seq == 0) {
+            /* Print next dispatch */
+            sixlowpan_print(data + sizeof(sixlowpan_sfr_rfrag_t),
+                            size - sizeof(sixlowpan_sfr_rfrag_t));
+        }
+        else {
+            od_hex_dump(data + sizeof(sixlowpan_sfr_rfrag_t),
+                        size - sizeof(sixlowpan_sfr_rfrag_t),
+                        OD_WIDTH_DEFAULT);
+        }
+    }
+    else if (sixlowpan_sfr_ack_is(data)) {
+        sixlowpan_sfr_ack_t *hdr = (sixlowpan_sfr_ack_t *)data;
+
+        puts("Recoverable Fragment Acknowledgment");
+        printf("ECN: %u\n", (unsigned)(hdr->disp_ecn & SIXLOWPAN_SFR_ECN));
+        printf("tag: 0x%02x\n", (unsigned)hdr->tag);
+        printf("bitmap: 0x%08" PRIx32 "\n", byteorder_ntohl(hdr->bitmap));
+    }
     else if ((data[0] & SIXLOWPAN_IPHC1_DISP_MASK) == SIXLOWPAN_IPHC1_DISP) {
         uint8_t offset = SIXLOWPAN_IPHC_HDR_LEN;
         puts("IPHC dispatch");
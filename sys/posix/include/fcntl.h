@@ -42,6 +42,7 @@ extern "C" {
 #define O_CREAT     0x0010  /* Create file if it does not exist */
 #define O_TRUNC     0x0020  /* Truncate flag */
 #define O_EXCL      0x0040  /* Exclusive use flag */
+#define O_NONBLOCK  0x0080  /* Non-blocking mode */
 
 #define F_DUPFD     0       /* Duplicate file descriptor */
 #define F_GETFD     1       /* Get file descriptor flags */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_select
+ * @{
+ *
+ * @file
+ * @brief   POSIX compatible poll.h definitions
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *          The Open Group Base Specification Issue 7, poll.h
+ *      </a>
+ */
+
+/* If building on native we need to use the system header instead */
+#ifdef CPU_NATIVE
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Event flags
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data other than high-priority data may be read without blocking */
+#define POLLPRI     (0x0002)    /**< High-priority data may be read without blocking */
+#define POLLOUT     (0x0004)    /**< Normal data may be written without blocking */
+#define POLLERR     (0x0008)    /**< An error has occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected (revents only) */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member (revents only) */
+#define POLLRDNORM  (POLLIN)    /**< Normal data may be read without blocking */
+#define POLLWRNORM  (POLLOUT)   /**< Equivalent to POLLOUT */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   A file descriptor to poll for
+ */
+struct pollfd {
+    int fd;         /**< The following descriptor being polled */
+    short events;   /**< The input event flags */
+    short revents;  /**< The output event flags */
+};
+
+/**
+ * @brief   Input/output multiplexing
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *          The Open Group Base Specification Issue 7, poll
+ *      </a>
+ *
+ * @param[in,out] fds   The file descriptors to examine. Entries with a
+ *                      negative pollfd::fd are ignored.
+ * @param[in] nfds      Number of elements in @p fds.
+ * @param[in] timeout   Time to wait in milliseconds, -1 to wait without
+ *                      timeout, 0 to return immediately.
+ *
+ * @return  Number of elements in @p fds with non-zero pollfd::revents
+ * @return  0, if the call timed out
+ * @return  -1 on error, errno is set accordingly
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE */
+/** @} */
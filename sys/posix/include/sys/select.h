@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_select
+ * @{
+ *
+ * @file
+ * @brief   POSIX compatible sys/select.h definitions
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_select.h.html">
+ *          The Open Group Base Specification Issue 7, sys/select.h
+ *      </a>
+ */
+
+/* If building on native or newlib we need to use the system header instead */
+#if defined(CPU_NATIVE) || MODULE_NEWLIB
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <sys/select.h>
+#else
+#ifndef SYS_SELECT_H
+#define SYS_SELECT_H
+
+#include <string.h>
+
+#include "bitfield.h"
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of file descriptors in an fd_set
+ */
+#define FD_SETSIZE  (VFS_MAX_OPEN_FILES)
+
+/**
+ * @brief   A set of file descriptors
+ */
+typedef struct {
+    BITFIELD(fds, FD_SETSIZE);  /**< bitfield of the file descriptors */
+} fd_set;
+
+/**
+ * @brief   Removes a file descriptor from a set
+ */
+#define FD_CLR(fd, fdsetp)      bf_unset((fdsetp)->fds, (fd))
+
+/**
+ * @brief   Checks if a file descriptor is in a set
+ */
+#define FD_ISSET(fd, fdsetp)    bf_isset((fdsetp)->fds, (fd))
+
+/**
+ * @brief   Adds a file descriptor to a set
+ */
+#define FD_SET(fd, fdsetp)      bf_set((fdsetp)->fds, (fd))
+
+/**
+ * @brief   Empties a set
+ */
+#define FD_ZERO(fdsetp)         memset((fdsetp), 0, sizeof(fd_set))
+
+struct timeval;
+
+/**
+ * @brief   Synchronous I/O multiplexing
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/select.html">
+ *          The Open Group Base Specification Issue 7, select
+ *      </a>
+ *
+ * @param[in] nfds              The range of file descriptors to be tested.
+ * @param[in,out] readfds       File descriptors to check for being ready to
+ *                              read, replaced by the ready ones. May be NULL.
+ * @param[in,out] writefds      File descriptors to check for being ready to
+ *                              write, replaced by the ready ones. May be NULL.
+ * @param[in,out] errorfds      File descriptors to check for pending error
+ *                              conditions, replaced by the ones having one.
+ *                              May be NULL.
+ * @param[in] timeout           Time to wait, NULL to wait without timeout.
+ *
+ * @return  Total number of bits set in the returned sets
+ * @return  -1 on error, errno is set accordingly
+ */
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_SELECT_H */
+#endif /* CPU_NATIVE || MODULE_NEWLIB */
+/** @} */
@@ -158,7 +158,10 @@ int pthread_mutexattr_settype(pthread_mutexattr_t *attr, int kind);
 
 /**
  * @brief            Query the priority inheritance of the mutex to create.
- * @note             This implementation only supports `PTHREAD_PRIO_NONE` mutexes.
+ * @note             This implementation only supports `PTHREAD_PRIO_NONE` mutexes, or
+ *                   `PTHREAD_PRIO_INHERIT` with the `core_mutex_priority_inheritance`
+ *                   module. As that module applies to all mutexes, they
+ *                   inherit priorities regardless of the protocol then.
  * @param[in]        attr       Attribute set to query
  * @param[out]       protocol   Either #PTHREAD_PRIO_NONE or #PTHREAD_PRIO_INHERIT or #PTHREAD_PRIO_PROTECT.
  * @returns         `0` on success.
@@ -168,7 +171,10 @@ int pthread_mutexattr_getprotocol(const pthread_mutexattr_t *attr, int *protocol
 
 /**
  * @brief            Sets the priority inheritance of the mutex to create.
- * @note             This implementation only supports `PTHREAD_PRIO_NONE` mutexes.
+ * @note             This implementation only supports `PTHREAD_PRIO_NONE` mutexes, or
+ *                   `PTHREAD_PRIO_INHERIT` with the `core_mutex_priority_inheritance`
+ *                   module. As that module applies to all mutexes, they
+ *                   inherit priorities regardless of the protocol then.
  * @param[in,out]    attr       Attribute set to change.
  * @param[in]        protocol   Either #PTHREAD_PRIO_NONE or #PTHREAD_PRIO_INHERIT or #PTHREAD_PRIO_PROTECT.
  * @returns         `0` on success.
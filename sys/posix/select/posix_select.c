@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   poll() and select() on top of @ref vfs_poll()
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/select.h>
+#include <sys/time.h>
+
+#include "thread.h"
+#include "thread_flags.h"
+#include "timex.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _NO_TIMEOUT     (UINT32_MAX)
+
+/**
+ * @brief   Checks the readiness of a set of files
+ *
+ * @param[in] ctx       the set of files
+ * @param[in] waiter    thread to notify on changes, KERNEL_PID_UNDEF to stop
+ *                      notifying
+ *
+ * @return  number of ready files
+ * @return  <0 on error
+ */
+typedef int (*_check_t)(void *ctx, kernel_pid_t waiter);
+
+typedef struct {
+    struct pollfd *fds;
+    nfds_t nfds;
+} _poll_ctx_t;
+
+typedef struct {
+    int nfds;
+    fd_set *readfds;
+    fd_set *writefds;
+    fd_set *errorfds;
+    fd_set in_readfds;
+    fd_set in_writefds;
+    fd_set in_errorfds;
+} _select_ctx_t;
+
+/* waits up to timeout microseconds for one of the files in ctx to become
+ * ready */
+static int _wait(_check_t check, void *ctx, uint32_t timeout)
+{
+    if (timeout != 0) {
+        xtimer_t timer;
+
+        thread_flags_clear(VFS_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+        if (timeout != _NO_TIMEOUT) {
+            xtimer_set_timeout_flag(&timer, timeout);
+        }
+        while (check(ctx, thread_getpid()) == 0) {
+            thread_flags_t flags = thread_flags_wait_any(VFS_POLL_THREAD_FLAG |
+                                                         THREAD_FLAG_TIMEOUT);
+
+            if (flags & THREAD_FLAG_TIMEOUT) {
+                DEBUG("posix_select: timed out\n");
+                break;
+            }
+        }
+        if (timeout != _NO_TIMEOUT) {
+            xtimer_remove(&timer);
+        }
+    }
+    /* stop notifications and report the latest state */
+    return check(ctx, KERNEL_PID_UNDEF);
+}
+
+static int _poll_check(void *arg, kernel_pid_t waiter)
+{
+    _poll_ctx_t *ctx = arg;
+    int ready = 0;
+
+    for (nfds_t i = 0; i < ctx->nfds; i++) {
+        struct pollfd *pfd = &ctx->fds[i];
+        int res;
+
+        if (pfd->fd < 0) {
+            pfd->revents = 0;
+            continue;
+        }
+        res = vfs_poll(pfd->fd, pfd->events & (POLLIN | POLLOUT), waiter);
+        if (res == -EBADF) {
+            res = POLLNVAL;
+        }
+        else if (res < 0) {
+            res = POLLERR;
+        }
+        else {
+            res &= (pfd->events | POLLERR | POLLHUP);
+        }
+        pfd->revents = res;
+        if (res != 0) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+static int _select_check(void *arg, kernel_pid_t waiter)
+{
+    _select_ctx_t *ctx = arg;
+    int ready = 0;
+
+    if (ctx->readfds != NULL) {
+        FD_ZERO(ctx->readfds);
+    }
+    if (ctx->writefds != NULL) {
+        FD_ZERO(ctx->writefds);
+    }
+    if (ctx->errorfds != NULL) {
+        FD_ZERO(ctx->errorfds);
+    }
+    for (int fd = 0; fd < ctx->nfds; fd++) {
+        int events = 0, res;
+
+        if ((ctx->readfds != NULL) && FD_ISSET(fd, &ctx->in_readfds)) {
+            events |= POLLIN;
+        }
+        if ((ctx->writefds != NULL) && FD_ISSET(fd, &ctx->in_writefds)) {
+            events |= POLLOUT;
+        }
+        if ((events == 0) && ((ctx->errorfds == NULL) ||
+                              !FD_ISSET(fd, &ctx->in_errorfds))) {
+            continue;
+        }
+        res = vfs_poll(fd, events, waiter);
+        if (res == -EBADF) {
+            return res;
+        }
+        else if (res < 0) {
+            /* reading or writing does not block but fails */
+            res = events | POLLERR;
+        }
+        else if (res & (POLLERR | POLLHUP)) {
+            res |= events;
+        }
+        if ((events & POLLIN) && (res & POLLIN)) {
+            FD_SET(fd, ctx->readfds);
+            ready++;
+        }
+        if ((events & POLLOUT) && (res & POLLOUT)) {
+            FD_SET(fd, ctx->writefds);
+            ready++;
+        }
+        if ((ctx->errorfds != NULL) && FD_ISSET(fd, &ctx->in_errorfds) &&
+            (res & POLLERR)) {
+            FD_SET(fd, ctx->errorfds);
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    _poll_ctx_t ctx = { .fds = fds, .nfds = nfds };
+    uint32_t timeout_us = _NO_TIMEOUT;
+
+    if (timeout >= 0) {
+        /* longer timeouts are cut to roughly 71 min */
+        timeout_us = ((unsigned)timeout < (_NO_TIMEOUT / US_PER_MS))
+                   ? ((uint32_t)timeout * US_PER_MS)
+                   : (_NO_TIMEOUT - 1);
+    }
+    return _wait(_poll_check, &ctx, timeout_us);
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    _select_ctx_t ctx = { .nfds = nfds, .readfds = readfds,
+                          .writefds = writefds, .errorfds = errorfds };
+    uint32_t timeout_us = _NO_TIMEOUT;
+    int res;
+
+    if ((nfds < 0) || (nfds > FD_SETSIZE)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (timeout != NULL) {
+        uint64_t us;
+
+        if ((timeout->tv_sec < 0) || (timeout->tv_usec < 0) ||
+            (timeout->tv_usec >= (long)US_PER_SEC)) {
+            errno = EINVAL;
+            return -1;
+        }
+        us = ((uint64_t)timeout->tv_sec * US_PER_SEC) + timeout->tv_usec;
+        /* longer timeouts are cut to roughly 71 min */
+        timeout_us = (us < _NO_TIMEOUT) ? (uint32_t)us : (_NO_TIMEOUT - 1);
+    }
+    /* the sets are overwritten with the result, so keep the input */
+    if (readfds != NULL) {
+        ctx.in_readfds = *readfds;
+    }
+    if (writefds != NULL) {
+        ctx.in_writefds = *writefds;
+    }
+    if (errorfds != NULL) {
+        ctx.in_errorfds = *errorfds;
+    }
+    res = _wait(_select_check, &ctx, timeout_us);
+    if (res < 0) {
+        errno = -res;
+        return -1;
+    }
+    return res;
+}
+
+/** @} */
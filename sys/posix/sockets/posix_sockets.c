@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -35,6 +36,14 @@
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
+#if defined(MODULE_POSIX_SELECT) && defined(MODULE_SOCK_ASYNC)
+#include <poll.h>
+#include "net/sock/async.h"
+#include "thread.h"
+
+/* sockets are pollable, if the network stack notifies about new data */
+#define POSIX_SOCKETS_POLL
+#endif
 
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
@@ -79,6 +88,22 @@ typedef struct {
     unsigned queue_array_len;
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
+#ifdef POSIX_SOCKETS_POLL
+    /* a datagram received by poll(), handed out by the next recvfrom() */
+    void *recv_data;
+    void *recv_buf_ctx;
+    size_t recv_len;
+    bool recv_empty;            /* datagram received has no payload */
+    struct _sock_tl_ep recv_remote;
+#ifdef MODULE_SOCK_TCP
+    /* a connection accepted or the first byte of stream data received by
+     * poll(), handed out by the next accept() or recvfrom() */
+    sock_tcp_t *accepted;
+    bool recv_peeked;
+    uint8_t recv_peek;
+#endif
+    kernel_pid_t waiter;        /* thread waiting in poll() */
+#endif
 } socket_t;
 
 static socket_t _socket_pool[_ACTUAL_SOCKET_POOL_SIZE];
@@ -99,6 +124,8 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
 static ssize_t socket_sendto(socket_t *s, const void *buffer, size_t length,
                              int flags, const struct sockaddr *address,
                              socklen_t address_len);
+static int _bind_connect(socket_t *s, const struct sockaddr *address,
+                         socklen_t address_len);
 
 static socket_t *_get_free_socket(void)
 {
@@ -244,6 +271,205 @@ static int _sockaddr_to_ep(const struct sockaddr *address, socklen_t address_len
     return 0;
 }
 
+static inline uint32_t _recv_timeout(socket_t *s, int flags)
+{
+    if ((flags & MSG_DONTWAIT) ||
+        (vfs_fcntl(s->fd, F_GETFL, 0) & O_NONBLOCK)) {
+        return 0;
+    }
+#ifdef POSIX_SETSOCKOPT
+    return s->recv_timeout;
+#else
+    return SOCK_NO_TIMEOUT;
+#endif
+}
+
+#ifdef POSIX_SOCKETS_POLL
+static void _notify(socket_t *s)
+{
+    kernel_pid_t waiter = s->waiter;
+
+    if (waiter != KERNEL_PID_UNDEF) {
+        thread_t *thread = (thread_t *)thread_get(waiter);
+
+        if (thread != NULL) {
+            thread_flags_set(thread, VFS_POLL_THREAD_FLAG);
+        }
+    }
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    (void)flags;
+    _notify(arg);
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    (void)flags;
+    _notify(arg);
+}
+#endif
+
+#ifdef MODULE_SOCK_TCP
+static void _tcp_cb(sock_tcp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    (void)flags;
+    _notify(arg);
+}
+
+static void _tcp_queue_cb(sock_tcp_queue_t *queue, sock_async_flags_t flags,
+                          void *arg)
+{
+    (void)queue;
+    (void)flags;
+    _notify(arg);
+}
+
+/* accepts a connection or receives the first byte of stream data without
+ * blocking, so poll() can tell if accept() or recvfrom() would block */
+static int _tcp_recv_cached(socket_t *s)
+{
+    int res;
+
+    if (s->queue_array != NULL) {
+        if (s->accepted != NULL) {
+            return 1;
+        }
+        res = sock_tcp_accept(&s->sock->tcp.queue, &s->accepted, 0);
+    }
+    else {
+        if (s->recv_peeked) {
+            return 1;
+        }
+        res = sock_tcp_read(&s->sock->tcp.sock, &s->recv_peek, 1, 0);
+        s->recv_peeked = (res > 0);
+    }
+    if (res == -EAGAIN) {
+        return 0;
+    }
+    return (res < 0) ? res : 1;
+}
+
+/* hands out the byte received by poll() and whatever followed it without
+ * blocking */
+static ssize_t _tcp_read_peeked(socket_t *s, uint8_t *buffer, size_t length)
+{
+    ssize_t res;
+
+    if (length == 0) {
+        return 0;
+    }
+    buffer[0] = s->recv_peek;
+    s->recv_peeked = false;
+    if (length == 1) {
+        return 1;
+    }
+    res = sock_tcp_read(&s->sock->tcp.sock, buffer + 1, length - 1, 0);
+    return (res > 0) ? (res + 1) : 1;
+}
+#endif
+
+/* receives a datagram without blocking and keeps it in the network stack's
+ * buffer until the next recvfrom() */
+static int _recv_cached(socket_t *s)
+{
+    int res;
+
+#ifdef MODULE_SOCK_TCP
+    if (s->type == SOCK_STREAM) {
+        return _tcp_recv_cached(s);
+    }
+#endif
+    if ((s->recv_buf_ctx != NULL) || s->recv_empty) {
+        return 1;
+    }
+    do {
+        switch (s->type) {
+#ifdef MODULE_SOCK_IP
+            case SOCK_RAW:
+                res = sock_ip_recv_buf(&s->sock->raw, &s->recv_data,
+                                       &s->recv_buf_ctx, 0,
+                                       (sock_ip_ep_t *)&s->recv_remote);
+                break;
+#endif
+#ifdef MODULE_SOCK_UDP
+            case SOCK_DGRAM:
+                res = sock_udp_recv_buf(&s->sock->udp, &s->recv_data,
+                                        &s->recv_buf_ctx, 0,
+                                        &s->recv_remote);
+                break;
+#endif
+            default:
+                return -EOPNOTSUPP;
+        }
+    /* datagrams from a wrong remote were dropped, try the next one */
+    } while (res == -EPROTO);
+    if (res == -EAGAIN) {
+        return 0;
+    }
+    if (res < 0) {
+        return res;
+    }
+    /* an empty datagram leaves nothing in the network stack's buffer, but is
+     * still pending until recvfrom() hands it out */
+    s->recv_len = res;
+    s->recv_empty = (res == 0);
+    return 1;
+}
+
+static void _release_cached(socket_t *s)
+{
+    s->recv_empty = false;
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            if (s->recv_buf_ctx != NULL) {
+                sock_ip_recv_buf(&s->sock->raw, &s->recv_data,
+                                 &s->recv_buf_ctx, 0, NULL);
+            }
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            if (s->accepted != NULL) {
+                sock_tcp_disconnect(s->accepted);
+                s->accepted = NULL;
+            }
+            s->recv_peeked = false;
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            if (s->recv_buf_ctx != NULL) {
+                sock_udp_recv_buf(&s->sock->udp, &s->recv_data,
+                                  &s->recv_buf_ctx, 0, NULL);
+            }
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+static void _init_cached(socket_t *s)
+{
+    s->recv_buf_ctx = NULL;
+    s->recv_empty = false;
+#ifdef MODULE_SOCK_TCP
+    s->accepted = NULL;
+    s->recv_peeked = false;
+#endif
+    s->waiter = KERNEL_PID_UNDEF;
+}
+#endif /* POSIX_SOCKETS_POLL */
+
 static int socket_close(vfs_file_t *filp)
 {
     socket_t *s = filp->private_data.ptr;
@@ -253,6 +479,10 @@ static int socket_close(vfs_file_t *filp)
     mutex_lock(&_socket_pool_mutex);
     if (s->sock != NULL) {
         int idx = _get_sock_idx(s->sock);
+#ifdef POSIX_SOCKETS_POLL
+        _release_cached(s);
+        s->waiter = KERNEL_PID_UNDEF;
+#endif
         switch (s->type) {
 #ifdef MODULE_SOCK_UDP
             case SOCK_DGRAM:
@@ -316,13 +546,79 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+static int socket_fcntl(vfs_file_t *filp, int cmd, int arg)
+{
+    switch (cmd) {
+        /* F_GETFL is handled directly by vfs_fcntl */
+        case F_SETFL:
+            /* only O_NONBLOCK has an effect on sockets, the access mode
+             * can't be changed */
+            filp->flags = (filp->flags & O_ACCMODE) | (arg & ~O_ACCMODE);
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
+#ifdef POSIX_SOCKETS_POLL
+static int socket_poll(vfs_file_t *filp, int events, kernel_pid_t waiter)
+{
+    socket_t *s = filp->private_data.ptr;
+    int res = 0, revents = 0;
+
+#ifdef MODULE_SOCK_TCP
+    if (s->type == SOCK_STREAM) {
+        if (s->sock == NULL) {
+            /* neither connected nor listening */
+            return POLLHUP;
+        }
+        if (s->queue_array == NULL) {
+            /* sock_tcp_write() only blocks until the data is queued */
+            revents = events & POLLOUT;
+        }
+    }
+    else
+#endif
+    {
+        /* sending does not block for datagram sockets */
+        revents = events & POLLOUT;
+        if ((events & POLLIN) && (s->sock == NULL) && s->bound) {
+            /* bind implicitly, as recvfrom() would */
+            if (_bind_connect(s, NULL, 0) < 0) {
+                return revents | POLLERR;
+            }
+        }
+    }
+    /* set waiter before checking, so no datagram arriving in between is
+     * missed */
+    s->waiter = waiter;
+    if ((events & POLLIN) && (s->sock != NULL)) {
+        res = _recv_cached(s);
+    }
+    if (res > 0) {
+        revents |= POLLIN;
+    }
+    else if ((res < 0) && (s->type == SOCK_STREAM)) {
+        /* connection is closed, recvfrom() does not block anymore */
+        revents |= POLLIN | POLLHUP;
+    }
+    else if (res < 0) {
+        revents |= POLLERR;
+    }
+    return revents;
+}
+#endif
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
-    .fcntl = NULL,          /* TODO: provide when needed */
+    .fcntl = socket_fcntl,
     .fstat = socket_fstat,
     .lseek = socket_lseek,
     .read = socket_read,
     .write = socket_write,
+#ifdef POSIX_SOCKETS_POLL
+    .poll = socket_poll,
+#endif
 };
 
 int socket(int domain, int type, int protocol)
@@ -364,6 +660,9 @@ int socket(int domain, int type, int protocol)
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
 #endif
+#ifdef POSIX_SOCKETS_POLL
+            _init_cached(s);
+#endif
 #ifdef MODULE_SOCK_TCP
             if (type == SOCK_STREAM)  {
                 s->queue_array = NULL;
@@ -405,11 +704,7 @@ int accept(int socket, struct sockaddr *restrict address,
         return -1;
     }
 
-#ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
-#else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
-#endif
+    const uint32_t recv_timeout = _recv_timeout(s, 0);
 
     switch (s->type) {
         case SOCK_STREAM:
@@ -420,8 +715,20 @@ int accept(int socket, struct sockaddr *restrict address,
                 break;
             }
             sock = (sock_tcp_t *)new_s->sock;
-            if ((res = sock_tcp_accept(&s->sock->tcp.queue, &sock,
-                                       recv_timeout)) < 0) {
+#ifdef POSIX_SOCKETS_POLL
+            if (s->accepted != NULL) {
+                /* hand out the connection accepted by poll() */
+                sock = s->accepted;
+                s->accepted = NULL;
+                res = 0;
+            }
+            else
+#endif
+            {
+                res = sock_tcp_accept(&s->sock->tcp.queue, &sock,
+                                      recv_timeout);
+            }
+            if (res < 0) {
                 errno = -res;
                 res = -1;
                 break;
@@ -456,8 +763,16 @@ int accept(int socket, struct sockaddr *restrict address,
                 new_s->type = s->type;
                 new_s->protocol = s->protocol;
                 new_s->bound = true;
+                new_s->sock = (socket_sock_t *)sock;
                 new_s->queue_array = NULL;
                 new_s->queue_array_len = 0;
+#ifdef POSIX_SETSOCKOPT
+                new_s->recv_timeout = SOCK_NO_TIMEOUT;
+#endif
+#ifdef POSIX_SOCKETS_POLL
+                _init_cached(new_s);
+                sock_tcp_set_cb(sock, _tcp_cb, new_s);
+#endif
                 memset(&s->local, 0, sizeof(sock_tcp_ep_t));
             }
             break;
@@ -590,6 +905,28 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         mutex_unlock(&_socket_pool_mutex);
         return -1;
     }
+#ifdef POSIX_SOCKETS_POLL
+    /* wake up poll() when data arrives */
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_set_cb(&sock->raw, _ip_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            sock_tcp_set_cb(&sock->tcp.sock, _tcp_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_set_cb(&sock->udp, _udp_cb, s);
+            break;
+#endif
+        default:
+            break;
+    }
+#endif
     s->sock = sock;
     return 0;
 }
@@ -789,6 +1126,10 @@ int listen(int socket, int backlog)
             break;
     }
     if (res == 0) {
+#ifdef POSIX_SOCKETS_POLL
+        /* wake up poll() when a connection arrives */
+        sock_tcp_queue_set_cb(&sock->tcp.queue, _tcp_queue_cb, s);
+#endif
         s->sock = sock;
     }
     else {
@@ -815,7 +1156,6 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
     int res = 0;
     struct _sock_tl_ep ep = { .port = 0 };
 
-    (void)flags;
     if (s == NULL) {
         return -ENOTSOCK;
     }
@@ -831,12 +1171,31 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
         }
     }
 
-#ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
-#else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
-#endif
+    const uint32_t recv_timeout = _recv_timeout(s, flags);
 
+#ifdef POSIX_SOCKETS_POLL
+    if ((s->recv_buf_ctx != NULL) || s->recv_empty) {
+        /* hand out the datagram received by poll() */
+        if (s->recv_len > length) {
+            res = -ENOBUFS;
+        }
+        else {
+            if (s->recv_len > 0) {
+                memcpy(buffer, s->recv_data, s->recv_len);
+            }
+            res = s->recv_len;
+        }
+        ep = s->recv_remote;
+        _release_cached(s);
+    }
+#ifdef MODULE_SOCK_TCP
+    else if ((s->type == SOCK_STREAM) && s->recv_peeked) {
+        /* hand out the data received by poll() */
+        res = _tcp_read_peeked(s, buffer, length);
+    }
+#endif
+    else
+#endif
     switch (s->type) {
 #ifdef MODULE_SOCK_IP
         case SOCK_RAW:
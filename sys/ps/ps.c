@@ -15,7 +15,10 @@
  * @}
  */
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "thread.h"
 #include "sched.h"
@@ -26,6 +29,9 @@
 #include "tlsf.h"
 #include "tlsf-malloc.h"
 #endif
+#ifdef MODULE_XTIMER_SLACK
+#include "xtimer.h"
+#endif
 
 /* list of states copied from tcb.h */
 static const char *state_names[] = {
@@ -50,6 +56,8 @@ void ps(void)
     const char queued_name[] = {'_', 'Q'};
 #ifdef DEVELHELP
     int overall_stacksz = 0, overall_used = 0;
+    bool overall_known = true;
+    char used[12];
 #endif
 
     printf("\tpid | "
@@ -101,8 +109,20 @@ void ps(void)
 #ifdef DEVELHELP
             int stacksz = p->stack_size;                                           /* get stack size */
             overall_stacksz += stacksz;
-            stacksz -= thread_measure_stack_free(p->stack_start);
-            overall_used += stacksz;
+#ifdef MODULE_CORE_STACK_WATERMARK
+            uintptr_t stackfree = thread_stack_watermark_free(p);
+#else
+            uintptr_t stackfree = thread_measure_stack_free(p->stack_start);
+#endif
+            if (stackfree != THREAD_STACK_FREE_UNKNOWN) {
+                stacksz -= stackfree;
+                overall_used += stacksz;
+                snprintf(used, sizeof(used), "%i", stacksz);
+            }
+            else {
+                overall_known = false;
+                strcpy(used, "n/a");
+            }
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
             /* multiply with 100 for percentage and to avoid floats/doubles */
@@ -117,7 +137,7 @@ void ps(void)
 #endif
                    " | %-8s %.1s | %3i"
 #ifdef DEVELHELP
-                   " | %6i (%5i) | %10p | %10p "
+                   " | %6i (%5s) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
@@ -129,7 +149,7 @@ void ps(void)
 #endif
                    sname, queued, p->priority
 #ifdef DEVELHELP
-                   , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
+                   , p->stack_size, used, (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
@@ -139,8 +159,14 @@ void ps(void)
     }
 
 #ifdef DEVELHELP
-    printf("\t%5s %-21s|%13s%6s %6i (%5i)\n", "|", "SUM", "|", "|",
-           overall_stacksz, overall_used);
+    if (overall_known) {
+        snprintf(used, sizeof(used), "%i", overall_used);
+    }
+    else {
+        strcpy(used, "n/a");
+    }
+    printf("\t%5s %-21s|%13s%6s %6i (%5s)\n", "|", "SUM", "|", "|",
+           overall_stacksz, used);
 #   ifdef MODULE_TLSF_MALLOC
     puts("\nHeap usage:");
     tlsf_size_container_t sizes = { .free = 0, .used = 0 };
@@ -149,4 +175,12 @@ void ps(void)
     printf("\tTotal used size: %u\n", sizes.used);
 #   endif
 #endif
+#ifdef MODULE_XTIMER_SLACK
+    xtimer_stats_t xtimer_stats;
+    xtimer_get_stats(&xtimer_stats);
+    puts("\nxtimer:");
+    printf("\tIndividual fires: %" PRIu32 "\n",
+           xtimer_stats.fired - xtimer_stats.coalesced);
+    printf("\tCoalesced fires: %" PRIu32 "\n", xtimer_stats.coalesced);
+#endif
 }
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_round_robin
+ * @{
+ *
+ * @file
+ * @brief       Round-robin scheduling implementation
+ *
+ * @}
+ */
+
+#include "sched.h"
+#include "sched_round_robin.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static void _slice_expired(void *arg);
+
+static xtimer_t _timer = { .callback = _slice_expired };
+
+static void _slice_expired(void *arg)
+{
+    (void)arg;
+    /* we're in interrupt context, so the scheduler can't interfere */
+    thread_t *active = (thread_t *)sched_active_thread;
+
+    if ((active != NULL) && (active->status == STATUS_RUNNING)) {
+        clist_node_t *runqueue = &sched_runqueues[active->priority];
+
+        /* only rotate if the active thread is at the head of a runqueue with
+         * more than one thread */
+        if ((clist_lpeek(runqueue) == &active->rq_entry) &&
+            (active->rq_entry.next != &active->rq_entry)) {
+            DEBUG("sched_round_robin: preempting %" PRIkernel_pid "\n",
+                  active->pid);
+            sched_runq_advance(active->priority);
+            thread_yield_higher();
+        }
+    }
+
+    xtimer_set(&_timer, SCHED_RR_TIMEBASE);
+}
+
+void sched_round_robin_init(void)
+{
+    xtimer_set(&_timer, SCHED_RR_TIMEBASE);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the kernel event trace
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ktrace.h"
+#ifdef MODULE_KTRACE_NATIVE
+#include "ktrace_native.h"
+#endif
+
+#define DUMP_LINE_LEN   (32U)
+
+static unsigned _dump_col;
+
+static void _dump(const void *data, size_t len, void *arg)
+{
+    const uint8_t *p = data;
+
+    (void)arg;
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", p[i]);
+        if (++_dump_col == DUMP_LINE_LEN) {
+            puts("");
+            _dump_col = 0;
+        }
+    }
+}
+
+static void _usage(const char *cmd)
+{
+    printf("usage: %s {start|stop|clear|dump", cmd);
+#ifdef MODULE_KTRACE_NATIVE
+    printf("|save <file>");
+#endif
+    puts("}");
+}
+
+int _ktrace_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        _usage(argv[0]);
+        return 1;
+    }
+    if (strcmp(argv[1], "start") == 0) {
+        ktrace_start();
+    }
+    else if (strcmp(argv[1], "stop") == 0) {
+        ktrace_stop();
+    }
+    else if (strcmp(argv[1], "clear") == 0) {
+        ktrace_clear();
+    }
+    else if (strcmp(argv[1], "dump") == 0) {
+        /* dumping would trace the shell's own output otherwise */
+        ktrace_stop();
+        _dump_col = 0;
+        puts("ktrace: begin");
+        ktrace_export(_dump, NULL);
+        if (_dump_col) {
+            puts("");
+        }
+        puts("ktrace: end");
+    }
+#ifdef MODULE_KTRACE_NATIVE
+    else if ((strcmp(argv[1], "save") == 0) && (argc > 2)) {
+        ktrace_stop();
+        if (ktrace_native_save(argv[2]) < 0) {
+            printf("ktrace: unable to write %s\n", argv[2]);
+            return 1;
+        }
+        printf("ktrace: %u events written to %s\n", ktrace_numof(), argv[2]);
+    }
+#endif
+    else {
+        _usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
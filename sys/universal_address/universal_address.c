@@ -46,6 +46,15 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+/**
+ * @brief Number of hash buckets used to index the containers
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_BUCKETS
+#define UNIVERSAL_ADDRESS_HASH_BUCKETS  ((UNIVERSAL_ADDRESS_MAX_ENTRIES / 2) + 1)
+#endif
+#endif
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -61,6 +70,52 @@ static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_M
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+/**
+ * @brief first container (1-based index, 0 for none) of each bucket
+ */
+static uint16_t _buckets[UNIVERSAL_ADDRESS_HASH_BUCKETS];
+
+/**
+ * @brief next container (1-based index, 0 for none) in the same bucket
+ */
+static uint16_t _next[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+static uint16_t *_bucket(const uint8_t *addr, size_t addr_size)
+{
+    /* FNV-1a */
+    uint32_t h = 2166136261U ^ addr_size;
+
+    for (size_t i = 0; i < addr_size; i++) {
+        h = (h ^ addr[i]) * 16777619U;
+    }
+    return &_buckets[h % UNIVERSAL_ADDRESS_HASH_BUCKETS];
+}
+
+static void _link(universal_address_container_t *entry)
+{
+    uint16_t *bucket = _bucket(entry->address, entry->address_size);
+    uint16_t idx = (entry - universal_address_table) + 1;
+
+    _next[idx - 1] = *bucket;
+    *bucket = idx;
+}
+
+static void _unlink(universal_address_container_t *entry)
+{
+    uint16_t *link = _bucket(entry->address, entry->address_size);
+    uint16_t idx = (entry - universal_address_table) + 1;
+
+    /* containers are only linked once universal_address_init() ran */
+    while ((*link != 0) && (*link != idx)) {
+        link = &_next[*link - 1];
+    }
+    if (*link != 0) {
+        *link = _next[idx - 1];
+    }
+}
+#endif
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,6 +127,18 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    for (uint16_t idx = *_bucket(addr, addr_size); idx != 0; idx = _next[idx - 1]) {
+        universal_address_container_t *entry = &universal_address_table[idx - 1];
+
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+#else
     /* cppcheck-suppress unsignedLessThanZero
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
      * code is optimized out) */
@@ -84,6 +151,7 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
     }
 
     return NULL;
+#endif
 }
 
 /**
@@ -125,6 +193,11 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        /* the container is indexed by its former (stale) address */
+        _unlink(pEntry);
+#endif
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -137,6 +210,9 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        _link(pEntry);
+#endif
     }
 
     pEntry->use_count++;
@@ -311,6 +387,15 @@ void universal_address_init(void)
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    /* every container is always indexed by its current content, so the
+     * cleared ones all end up in the bucket of the empty address */
+    memset(_buckets, 0, sizeof(_buckets));
+    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
+        _link(&universal_address_table[i]);
+    }
+#endif
+
     mutex_unlock(&mtx_access);
 }
 
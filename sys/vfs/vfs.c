@@ -174,6 +174,22 @@ int vfs_fcntl(int fd, int cmd, int arg)
     return -EINVAL;
 }
 
+int vfs_poll(int fd, int events, kernel_pid_t waiter)
+{
+    DEBUG_NOT_STDOUT(fd, "vfs_poll: %d, 0x%x, %" PRIkernel_pid "\n", fd,
+                     events, waiter);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->poll == NULL) {
+        /* driver does not block, so the file is always ready */
+        return events;
+    }
+    return filp->f_op->poll(filp, events, waiter);
+}
+
 int vfs_fstat(int fd, struct stat *buf)
 {
     DEBUG_NOT_STDOUT(fd, "vfs_fstat: %d, %p\n", fd, (void *)buf);
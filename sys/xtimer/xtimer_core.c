@@ -46,12 +46,19 @@ static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
+#ifdef MODULE_XTIMER_SLACK
+static xtimer_stats_t _stats;
+#endif
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
+static xtimer_t *_pop_head(xtimer_t **list_head);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
 static uint32_t _time_left(uint32_t target, uint32_t reference);
+static void _set(xtimer_t *timer, uint32_t offset, uint32_t slack);
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack);
 
 static void _timer_callback(void);
 static void _periph_timer_callback(void *arg, int chan);
@@ -63,6 +70,19 @@ static inline int _is_set(xtimer_t *timer)
     return (timer->target || timer->long_target);
 }
 
+/* earliest time in the current period at which a timer in the current
+ * period's list may fire */
+static inline uint32_t _earliest(xtimer_t *timer)
+{
+    uint32_t target = _xtimer_lltimer_mask(timer->target);
+
+#ifdef MODULE_XTIMER_SLACK
+    return (timer->slack < target) ? (target - timer->slack) : 0;
+#else
+    return target;
+#endif
+}
+
 static inline void xtimer_spin_until(uint32_t target)
 {
 #if XTIMER_MASK
@@ -108,10 +128,26 @@ uint64_t _xtimer_now64(void)
 
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 {
+    _xtimer_set_slack64(timer, offset, long_offset, 0);
+}
+
+void _xtimer_set_slack64(xtimer_t *timer, uint32_t offset, uint32_t long_offset,
+                         uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    /* timers are sorted by the end of their window */
+    offset += slack;
+    if (offset < slack) {
+        long_offset++;
+    }
+#else
+    slack = 0;
+#endif
+
     DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
     if (!long_offset) {
         /* timer fits into the short timer */
-        _xtimer_set(timer, (uint32_t)offset);
+        _set(timer, offset, slack);
     }
     else {
         int state = irq_disable();
@@ -125,6 +161,9 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
         if (timer->target < offset) {
             timer->long_target++;
         }
+#ifdef MODULE_XTIMER_SLACK
+        timer->slack = slack;
+#endif
 
         _add_timer_to_long_list(&long_list_head, timer);
         irq_restore(state);
@@ -134,6 +173,11 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _set(timer, offset, 0);
+}
+
+static void _set(xtimer_t *timer, uint32_t offset, uint32_t slack)
 {
     DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
           offset, xtimer_now().ticks32, _xtimer_lltimer_now());
@@ -145,12 +189,12 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     xtimer_remove(timer);
 
     if (offset < XTIMER_BACKOFF) {
-        _xtimer_spin(offset);
+        _xtimer_spin(offset - slack);
         _shoot(timer);
     }
     else {
         uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+        _set_absolute(timer, target, slack);
     }
 }
 
@@ -176,12 +220,15 @@ static inline void _lltimer_set(uint32_t target)
 }
 
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    return _set_absolute(timer, target, 0);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
 
-    timer->next = NULL;
-
     /* Ensure that offset is bigger than 'XTIMER_BACKOFF',
      * 'target - now' will allways be the offset no matter if target < or > now.
      *
@@ -212,6 +259,11 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     timer->target = target;
     timer->long_target = _long_cnt;
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = slack;
+#else
+    (void)slack;
+#endif
 
     /* Ensure timer is fired in right timer period.
      * Backoff condition above ensures that 'target - XTIMER_OVERHEAD` is later
@@ -252,6 +304,147 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
+#ifdef MODULE_XTIMER_PAIRING_HEAP
+/*
+ * With the pairing heap backend, each of the timer lists is a pairing heap
+ * ordered by (long_target, target). Its root is the list head, `next` links
+ * siblings, `child` points to the first child and `prev` to the previous
+ * sibling or, for a first child, to the parent.
+ */
+static inline int _before(const xtimer_t *a, const xtimer_t *b)
+{
+    return (a->long_target < b->long_target) ||
+           ((a->long_target == b->long_target) && (a->target <= b->target));
+}
+
+/**
+ * @brief meld two detached heaps, return the root of the new heap
+ */
+static xtimer_t *_meld(xtimer_t *a, xtimer_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (!_before(a, b)) {
+        xtimer_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/**
+ * @brief meld a list of siblings into a single heap (two pass pairing)
+ */
+static xtimer_t *_merge_pairs(xtimer_t *first)
+{
+    xtimer_t *pairs = NULL;
+    xtimer_t *root = NULL;
+
+    /* meld pairs of siblings from left to right, stacking the results */
+    while (first) {
+        xtimer_t *a = first;
+        xtimer_t *b = a->next;
+
+        first = b ? b->next : NULL;
+        a->prev = a->next = NULL;
+        if (b) {
+            b->prev = b->next = NULL;
+        }
+        a = _meld(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* meld the stacked pairs from right to left */
+    while (pairs) {
+        xtimer_t *pair = pairs;
+
+        pairs = pair->next;
+        pair->next = NULL;
+        root = _meld(root, pair);
+    }
+
+    return root;
+}
+
+static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->child = NULL;
+    *list_head = _meld(*list_head, timer);
+}
+
+static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    _add_timer_to_list(list_head, timer);
+}
+
+static xtimer_t *_pop_head(xtimer_t **list_head)
+{
+    xtimer_t *head = *list_head;
+
+    *list_head = _merge_pairs(head->child);
+    head->child = NULL;
+
+    return head;
+}
+
+static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    if (!timer->prev) {
+        /* only the root has no predecessor */
+        if (*list_head != timer) {
+            return 0;
+        }
+        _pop_head(list_head);
+        return 1;
+    }
+
+    /* Replace the timer by the heap of its children. They all expire after
+     * the timer's parent, so this works without knowing the heap's root. */
+    xtimer_t *sub = _merge_pairs(timer->child);
+    xtimer_t *prev = timer->prev;
+    xtimer_t *next = timer->next;
+
+    if (sub) {
+        sub->prev = prev;
+        sub->next = next;
+        if (next) {
+            next->prev = sub;
+        }
+    }
+    else {
+        sub = next;
+        if (next) {
+            next->prev = prev;
+        }
+    }
+    if (prev->child == timer) {
+        prev->child = sub;
+    }
+    else {
+        prev->next = sub;
+    }
+
+    timer->prev = timer->next = timer->child = NULL;
+
+    return 1;
+}
+#else
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -274,6 +467,15 @@ static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
     *list_head = timer;
 }
 
+static xtimer_t *_pop_head(xtimer_t **list_head)
+{
+    xtimer_t *head = *list_head;
+
+    *list_head = head->next;
+
+    return head;
+}
+
 static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head) {
@@ -286,12 +488,13 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 
     return 0;
 }
+#endif
 
 static void _remove(xtimer_t *timer)
 {
     if (timer_list_head == timer) {
         uint32_t next;
-        timer_list_head = timer->next;
+        _pop_head(&timer_list_head);
         if (timer_list_head) {
             /* schedule callback on next timer target time */
             next = timer_list_head->target - XTIMER_OVERHEAD;
@@ -320,6 +523,15 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+#ifdef MODULE_XTIMER_SLACK
+void xtimer_get_stats(xtimer_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+#endif
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -346,6 +558,20 @@ static inline int _this_high_period(uint32_t target)
 #endif
 }
 
+#ifdef MODULE_XTIMER_PAIRING_HEAP
+/**
+ * @brief move the long timers that will expire in the current short timer
+ *        period to the current timer list
+ */
+static void _select_long_timers(void)
+{
+    while (long_list_head
+           && (long_list_head->long_target <= _long_cnt)
+           && _this_high_period(long_list_head->target)) {
+        _add_timer_to_list(&timer_list_head, _pop_head(&long_list_head));
+    }
+}
+#else
 /**
  * @brief compare two timers' target values, return the one with lower value.
  *
@@ -435,6 +661,7 @@ static void _select_long_timers(void)
         }
     }
 }
+#endif
 
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
@@ -467,6 +694,9 @@ static void _timer_callback(void)
 {
     uint32_t next_target;
     uint32_t reference;
+#ifdef MODULE_XTIMER_SLACK
+    unsigned fired = 0;
+#endif
 
     _in_handler = 1;
 
@@ -498,21 +728,26 @@ static void _timer_callback(void)
     }
 
 overflow:
-    /* check if next timers are close to expiring */
-    while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < XTIMER_ISR_BACKOFF)) {
+    /* check if next timers are close to expiring, timers with slack are
+     * fired as soon as their window has begun */
+    while (timer_list_head && (_time_left(_earliest(timer_list_head), reference) < XTIMER_ISR_BACKOFF)) {
         /* make sure we don't fire too early */
-        while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
-
-        /* pick first timer in list */
-        xtimer_t *timer = timer_list_head;
+        while (_time_left(_earliest(timer_list_head), reference)) {}
 
-        /* advance list */
-        timer_list_head = timer->next;
+        /* pick first timer in list and advance list */
+        xtimer_t *timer = _pop_head(&timer_list_head);
 
         /* make sure timer is recognized as being already fired */
         timer->target = 0;
         timer->long_target = 0;
 
+#ifdef MODULE_XTIMER_SLACK
+        if (fired++) {
+            _stats.coalesced++;
+        }
+        _stats.fired++;
+#endif
+
         /* fire timer */
         _shoot(timer);
     }
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       FIB lookup benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/fib.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+#define TABLE_SIZE          (1024U)
+#define NEXT_HOPS_NUMOF     (8U)
+#define PREFIXES_NUMOF      (4U)
+#define IFACE               (6U)
+#define LIFETIME            (3600U * MS_PER_SEC)
+
+static const unsigned _routes_numof[] = { 16, 128, 512, 1024 };
+
+static fib_entry_t _entries[TABLE_SIZE];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = TABLE_SIZE,
+                              .mtx_access = MUTEX_INIT,
+                              .notify_rp_pos = 0 };
+
+/* Like the table of a RPL root in storing mode, most routes are host routes
+ * 2001:db8::i/128 with a finite lifetime. The first routes are the default
+ * route and some /64 prefixes without lifetime. */
+static uint32_t _route(ipv6_addr_t *dst, unsigned i, uint32_t *lifetime)
+{
+    ipv6_addr_from_str(dst, "2001:db8::");
+    *lifetime = (uint32_t)FIB_LIFETIME_NO_EXPIRE;
+    if (i == 0) {
+        ipv6_addr_set_unspecified(dst);
+        return 0;
+    }
+    if (i <= PREFIXES_NUMOF) {
+        dst->u16[3] = byteorder_htons(i);
+        return 64 << FIB_FLAG_NET_PREFIX_SHIFT;
+    }
+    dst->u16[6] = byteorder_htons(i >> 16);
+    dst->u16[7] = byteorder_htons(i & 0xffff);
+    *lifetime = LIFETIME + i;
+    return 0;
+}
+
+static void _next_hop(ipv6_addr_t *next_hop, unsigned i)
+{
+    ipv6_addr_from_str(next_hop, "fe80::1");
+    next_hop->u8[15] += i % NEXT_HOPS_NUMOF;
+}
+
+static void _run(unsigned routes)
+{
+    ipv6_addr_t dst, next_hop;
+    uint32_t lifetime;
+    unsigned errors = 0;
+
+    fib_init(&_table);
+    for (unsigned i = 0; i < routes; i++) {
+        uint32_t flags = _route(&dst, i, &lifetime);
+
+        _next_hop(&next_hop, i);
+        if (fib_add_entry(&_table, IFACE, dst.u8, sizeof(dst), flags,
+                          next_hop.u8, sizeof(next_hop), 0, lifetime) < 0) {
+            printf("unable to add route %u\n", i);
+            return;
+        }
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        kernel_pid_t iface;
+        size_t next_hop_size = sizeof(next_hop);
+        uint32_t next_hop_flags;
+        /* spread the destinations over all routes */
+        unsigned route = (i * 7919U) % routes;
+
+        _route(&dst, route, &lifetime);
+        if (route <= PREFIXES_NUMOF) {
+            /* some host in the prefix or anywhere for the default route */
+            dst.u8[15] = 1;
+        }
+        if ((fib_get_next_hop(&_table, &iface, next_hop.u8, &next_hop_size,
+                              &next_hop_flags, dst.u8, sizeof(dst), 0) < 0) ||
+            (next_hop.u8[15] != 1 + (route % NEXT_HOPS_NUMOF))) {
+            errors++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    fib_deinit(&_table);
+
+    printf("{ \"routes\" : %u, \"lookups\" : %u, \"errors\" : %u, "
+           "\"usec\" : %" PRIu32 " }\n", routes, TEST_LOOKUPS, errors,
+           duration);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < sizeof(_routes_numof) / sizeof(_routes_numof[0]); i++) {
+        _run(_routes_numof[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
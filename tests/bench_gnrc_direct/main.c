@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       UDP echo benchmark for GNRC's packet dispatching
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gnrc/netif.h"
+#ifdef MODULE_GNRC_PCAP
+#include "net/gnrc/pcap.h"
+#endif
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BENCH_PORT          (9999U)
+#define BENCH_SIZE_MAX      (1024U)
+#define BENCH_TIMEOUT       (100U * US_PER_MS)
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[BENCH_SIZE_MAX];
+static uint8_t _client_buf[BENCH_SIZE_MAX];
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    (void)arg;
+    local.port = BENCH_PORT;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("unable to create server sock");
+        return NULL;
+    }
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, _server_buf, sizeof(_server_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+
+        if (res >= 0) {
+            sock_udp_send(&sock, _server_buf, res, &remote);
+        }
+    }
+
+    return NULL;
+}
+
+static int _bench(int argc, char **argv)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = BENCH_PORT };
+    sock_udp_t sock;
+    unsigned count = 1000, size = 64, lost = 0;
+    uint32_t rtt_min = UINT32_MAX, rtt_max = 0, rtt_sum = 0;
+
+    if (argc < 2) {
+        printf("usage: %s <addr> [<count> [<size>]]\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        puts("unable to parse address");
+        return 1;
+    }
+    if (argc > 2) {
+        count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        size = atoi(argv[3]);
+    }
+    if ((count == 0) || (size == 0) || (size > BENCH_SIZE_MAX)) {
+        printf("count must be > 0 and size in [1, %u]\n", BENCH_SIZE_MAX);
+        return 1;
+    }
+    if (ipv6_addr_is_link_local((ipv6_addr_t *)&remote.addr.ipv6)) {
+        /* use the first interface for link-local addresses */
+        remote.netif = gnrc_netif_iter(NULL)->pid;
+    }
+    if (sock_udp_create(&sock, NULL, &remote, 0) < 0) {
+        puts("unable to create client sock");
+        return 1;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < count; i++) {
+        uint32_t sent;
+        ssize_t res;
+
+        memset(_client_buf, i & 0xff, size);
+        sent = xtimer_now_usec();
+        if (sock_udp_send(&sock, _client_buf, size, NULL) < 0) {
+            lost++;
+            continue;
+        }
+        /* skip echoes of earlier requests that arrived after their timeout */
+        do {
+            res = sock_udp_recv(&sock, _client_buf, sizeof(_client_buf),
+                                BENCH_TIMEOUT, NULL);
+        } while ((res > 0) && (_client_buf[0] != (i & 0xff)));
+        if (res != (ssize_t)size) {
+            lost++;
+            continue;
+        }
+
+        uint32_t rtt = xtimer_now_usec() - sent;
+
+        rtt_sum += rtt;
+        if (rtt < rtt_min) {
+            rtt_min = rtt;
+        }
+        if (rtt > rtt_max) {
+            rtt_max = rtt;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    sock_udp_close(&sock);
+
+    if (lost == count) {
+        rtt_min = 0;
+    }
+    printf("{ \"echoes\" : %u, \"lost\" : %u, \"size\" : %u, "
+           "\"rtt_min\" : %" PRIu32 ", \"rtt_avg\" : %" PRIu32 ", "
+           "\"rtt_max\" : %" PRIu32 ", \"usec\" : %" PRIu32 " }\n",
+           count - lost, lost, size, rtt_min,
+           (lost < count) ? rtt_sum / (count - lost) : 0, rtt_max, duration);
+#ifdef MODULE_GNRC_PCAP
+    gnrc_pcap_stats_t stats;
+
+    gnrc_pcap_get_stats(&stats);
+    printf("{ \"captured\" : %" PRIu32 ", \"dropped\" : %" PRIu32 ", "
+           "\"written\" : %" PRIu32 " }\n", stats.captured, stats.dropped,
+           stats.written);
+#endif
+
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "bench", "send UDP echo requests to another node", _bench },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "echo server");
+
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+COUNT = 100
+SIZE = 64
+
+
+def testfunc(child):
+    # echo over the loopback address, so no second node is needed
+    child.sendline("bench ::1 {} {}".format(COUNT, SIZE))
+    child.expect(r'{ "echoes" : (\d+), "lost" : (\d+), "size" : (\d+), ')
+    assert int(child.match.group(1)) == COUNT
+    assert int(child.match.group(2)) == 0
+    assert int(child.match.group(3)) == SIZE
+    print("OK")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       NIB forwarding table lookup benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+#define NEXT_HOPS_NUMOF     (8U)
+#define IFACE               (6U)
+
+static const unsigned _routes_numof[] = { 16, 256, 1024 };
+
+/* Route i is 2001:db8:i::/48 for even i and a more specific
+ * 2001:db8:i-1:1::/64 within the route before for odd i. */
+static unsigned _route(ipv6_addr_t *pfx, unsigned i)
+{
+    ipv6_addr_from_str(pfx, "2001:db8::");
+    pfx->u16[2] = byteorder_htons(i & ~1U);
+    if (i & 1) {
+        pfx->u16[3] = byteorder_htons(1);
+        return 64;
+    }
+    return 48;
+}
+
+static void _next_hop(ipv6_addr_t *next_hop, unsigned i)
+{
+    ipv6_addr_from_str(next_hop, "fe80::1");
+    next_hop->u8[15] += i % NEXT_HOPS_NUMOF;
+}
+
+static void _run(unsigned routes)
+{
+    ipv6_addr_t pfx, next_hop;
+    gnrc_ipv6_nib_ft_t fte;
+    unsigned errors = 0;
+
+    for (unsigned i = 0; i < routes; i++) {
+        unsigned pfx_len = _route(&pfx, i);
+
+        _next_hop(&next_hop, i);
+        if (gnrc_ipv6_nib_ft_add(&pfx, pfx_len, &next_hop, IFACE, 0) < 0) {
+            printf("unable to add route %u\n", i);
+            return;
+        }
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        ipv6_addr_t dst;
+        /* spread the destinations over all routes */
+        unsigned route = (i * 7919U) % routes;
+        unsigned pfx_len = _route(&dst, route);
+
+        dst.u8[15] = 1;
+        if ((gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) < 0) ||
+            (fte.dst_len != pfx_len)) {
+            errors++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    for (unsigned i = 0; i < routes; i++) {
+        unsigned pfx_len = _route(&pfx, i);
+
+        gnrc_ipv6_nib_ft_del(&pfx, pfx_len);
+    }
+
+    printf("{ \"routes\" : %u, \"lookups\" : %u, \"errors\" : %u, "
+           "\"usec\" : %" PRIu32 " }\n", routes, TEST_LOOKUPS, errors,
+           duration);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < sizeof(_routes_numof) / sizeof(_routes_numof[0]); i++) {
+        _run(_routes_numof[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
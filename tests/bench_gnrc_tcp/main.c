@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Measures the GNRC TCP throughput against a peer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#define CHUNK_SIZE  (1024U)
+
+#ifdef MODULE_GNRC_TCP_SACK
+#define SACK_STATE  "on"
+#else
+#define SACK_STATE  "off"
+#endif
+
+static uint8_t _buf[CHUNK_SIZE];
+
+static void _print_result(const char *dir, uint32_t bytes, uint32_t usec)
+{
+    uint32_t kbits = (uint32_t)(((uint64_t)bytes * 8U * US_PER_MS) /
+                                ((usec > 0) ? usec : 1));
+
+    printf("%s: %" PRIu32 " bytes in %" PRIu32 " us, %" PRIu32 " kbit/s\n",
+           dir, bytes, usec, kbits);
+}
+
+static int _connect(gnrc_tcp_tcb_t *tcb, uint16_t port)
+{
+    /* gnrc_tcp_open_active() removes the interface identifier from the
+     * address, so it gets a fresh copy each time */
+    char target_addr[] = TARGET_ADDR;
+    int res;
+
+    gnrc_tcp_tcb_init(tcb);
+    res = gnrc_tcp_open_active(tcb, AF_INET6, target_addr, port, 0);
+    if (res < 0) {
+        printf("error: can't connect to [%s]:%u (%d)\n", TARGET_ADDR,
+               (unsigned)port, res);
+    }
+    return res;
+}
+
+static void _upload(void)
+{
+    gnrc_tcp_tcb_t tcb;
+    uint32_t sent = 0;
+    uint32_t start;
+
+    if (_connect(&tcb, UPLOAD_PORT) < 0) {
+        return;
+    }
+    memset(_buf, 0x55, sizeof(_buf));
+    start = xtimer_now_usec();
+    while (sent < BENCH_BYTES) {
+        size_t len = ((BENCH_BYTES - sent) < sizeof(_buf)) ?
+                     (BENCH_BYTES - sent) : sizeof(_buf);
+        int res = gnrc_tcp_send(&tcb, _buf, len, 0);
+
+        if (res < 0) {
+            printf("error: gnrc_tcp_send() failed after %" PRIu32 " bytes (%d)\n",
+                   sent, res);
+            gnrc_tcp_abort(&tcb);
+            return;
+        }
+        sent += res;
+    }
+    /* returns when the peer acknowledged all data */
+    gnrc_tcp_close(&tcb);
+    _print_result("upload", sent, xtimer_now_usec() - start);
+}
+
+static void _download(void)
+{
+    gnrc_tcp_tcb_t tcb;
+    uint32_t rcvd = 0;
+    uint32_t start;
+
+    if (_connect(&tcb, DOWNLOAD_PORT) < 0) {
+        return;
+    }
+    start = xtimer_now_usec();
+    while (rcvd < BENCH_BYTES) {
+        int res = gnrc_tcp_recv(&tcb, _buf, sizeof(_buf),
+                                GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+
+        if (res < 0) {
+            printf("error: gnrc_tcp_recv() failed after %" PRIu32 " bytes (%d)\n",
+                   rcvd, res);
+            gnrc_tcp_abort(&tcb);
+            return;
+        }
+        rcvd += res;
+    }
+    _print_result("download", rcvd, xtimer_now_usec() - start);
+    gnrc_tcp_close(&tcb);
+}
+
+int main(void)
+{
+    printf("GNRC TCP throughput: %u bytes to [%s]:%u and from [%s]:%u\n",
+           (unsigned)BENCH_BYTES, TARGET_ADDR, (unsigned)UPLOAD_PORT,
+           TARGET_ADDR, (unsigned)DOWNLOAD_PORT);
+    printf("window: %u bytes, send queue: %u segments, SACK: " SACK_STATE "\n",
+           (unsigned)GNRC_TCP_DEFAULT_WINDOW, (unsigned)GNRC_TCP_SND_QUEUE_SIZE);
+    _upload();
+    _download();
+    puts("done");
+    return 0;
+}
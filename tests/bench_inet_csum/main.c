@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Internet checksum throughput benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define BUF_SIZE            (1280U + 1U)
+
+typedef uint16_t (*csum_t)(uint16_t sum, const uint8_t *buf, uint16_t len,
+                           size_t accum_len);
+
+static const uint16_t _sizes[] = { 8, 40, 64, 128, 256, 512, 1280 };
+
+volatile unsigned _flag = 0;
+volatile uint16_t _sink;
+
+static uint8_t _buf[BUF_SIZE];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+/* one 16-bit word per iteration, which is how inet_csum_slice() used to work */
+static uint16_t _wordwise(uint16_t sum, const uint8_t *buf, uint16_t len,
+                          size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _run(const char *name, csum_t csum, unsigned offset)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        uint32_t n = 0;
+
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            _sink = csum(0, _buf + offset, _sizes[i], 0);
+            n++;
+        }
+
+        printf("{ \"csum\" : \"%s\", \"offset\" : %u, \"len\" : %u, "
+               "\"result\" : %" PRIu32 " }\n", name, offset,
+               (unsigned)_sizes[i], n);
+    }
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        _buf[i] = i * 7;
+    }
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        if (_wordwise(0, _buf, _sizes[i], 0) !=
+            inet_csum_slice(0, _buf, _sizes[i], 0)) {
+            puts("FAILED: checksums differ");
+            return 1;
+        }
+    }
+
+    /* payloads are not necessarily word aligned in the packet buffer */
+    for (unsigned offset = 0; offset < 2; offset++) {
+        _run("wordwise", _wordwise, offset);
+        _run("inet_csum", inet_csum_slice, offset);
+    }
+
+    return 0;
+}
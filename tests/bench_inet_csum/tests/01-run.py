@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for offset in (0, 1):
+        for csum in ("wordwise", "inet_csum"):
+            for length in (8, 40, 64, 128, 256, 512, 1280):
+                child.expect(r"{ \"csum\" : \"%s\", \"offset\" : %d, "
+                             r"\"len\" : %d, \"result\" : \d+ }"
+                             % (csum, offset, length))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Bulk message throughput benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define BURST_MAX           (64U)
+
+volatile unsigned _flag = 0;
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _queue[BURST_MAX];
+
+static void _timer_callback(void*arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+    static msg_t msgs[BURST_MAX];
+
+    msg_init_queue(_queue, BURST_MAX);
+
+    while(1) {
+        msg_receive_bulk(msgs, BURST_MAX);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    printf("main starting\n");
+
+    kernel_pid_t other = thread_create(_stack,
+                                       sizeof(_stack),
+                                       (THREAD_PRIORITY_MAIN - 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _second_thread,
+                                       NULL,
+                                       "second_thread");
+
+    xtimer_t timer;
+    timer.callback = _timer_callback;
+
+    static msg_t test[BURST_MAX];
+
+    for (unsigned burst = 1; burst <= BURST_MAX; burst <<= 1) {
+        uint32_t n = 0;
+
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while(!_flag) {
+            n += msg_send_bulk(test, burst, other);
+        }
+
+        printf("{ \"burst\" : %u, \"result\" : %"PRIu32" }\n", burst, n);
+    }
+
+    return 0;
+}
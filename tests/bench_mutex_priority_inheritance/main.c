@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Mutex priority inversion latency benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifndef ROUNDS
+#define ROUNDS              (8U)
+#endif
+
+#ifndef HOLD_TIME
+#define HOLD_TIME           (1000U)
+#endif
+
+#ifndef BUSY_STEP
+#define BUSY_STEP           (1000U)
+#endif
+
+#define FLAG_GO             (0x1)
+
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+static char _stack_inter[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+static char _stack_high[THREAD_STACKSIZE_DEFAULT];
+
+static thread_t *_main, *_low, *_inter, *_mid, *_high;
+static mutex_t _mutex_a = MUTEX_INIT;
+static mutex_t _mutex_b = MUTEX_INIT;
+
+static unsigned _transitive;
+static uint32_t _busy;
+static uint32_t _min, _max, _sum;
+
+static void *_low_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_GO);
+        mutex_lock(&_mutex_a);
+        if (_transitive) {
+            /* blocks on _mutex_a while holding _mutex_b */
+            thread_flags_set(_inter, FLAG_GO);
+        }
+        thread_flags_set(_high, FLAG_GO);
+        thread_flags_set(_mid, FLAG_GO);
+        xtimer_spin(xtimer_ticks_from_usec(HOLD_TIME));
+        mutex_unlock(&_mutex_a);
+    }
+
+    return NULL;
+}
+
+static void *_inter_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_GO);
+        mutex_lock(&_mutex_b);
+        mutex_lock(&_mutex_a);
+        mutex_unlock(&_mutex_a);
+        mutex_unlock(&_mutex_b);
+    }
+
+    return NULL;
+}
+
+static void *_mid_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_GO);
+        xtimer_spin(xtimer_ticks_from_usec(_busy));
+    }
+
+    return NULL;
+}
+
+static void *_high_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_GO);
+        mutex_t *mutex = _transitive ? &_mutex_b : &_mutex_a;
+
+        uint32_t start = xtimer_now_usec();
+        mutex_lock(mutex);
+        uint32_t wait = xtimer_now_usec() - start;
+        mutex_unlock(mutex);
+
+        if (wait < _min) {
+            _min = wait;
+        }
+        if (wait > _max) {
+            _max = wait;
+        }
+        _sum += wait;
+
+        thread_flags_set(_main, FLAG_GO);
+    }
+
+    return NULL;
+}
+
+static thread_t *_create(char *stack, size_t size, uint8_t prio,
+                         thread_task_func_t func, const char *name)
+{
+    kernel_pid_t pid = thread_create(stack, size, prio,
+                                     THREAD_CREATE_STACKTEST, func, NULL,
+                                     name);
+
+    return (thread_t *)thread_get(pid);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    _main = (thread_t *)thread_get(thread_getpid());
+    _low = _create(_stack_low, sizeof(_stack_low), THREAD_PRIORITY_MAIN - 1,
+                   _low_thread, "low");
+    _inter = _create(_stack_inter, sizeof(_stack_inter),
+                     THREAD_PRIORITY_MAIN - 2, _inter_thread, "inter");
+    _mid = _create(_stack_mid, sizeof(_stack_mid), THREAD_PRIORITY_MAIN - 3,
+                   _mid_thread, "mid");
+    _high = _create(_stack_high, sizeof(_stack_high), THREAD_PRIORITY_MAIN - 4,
+                    _high_thread, "high");
+
+    for (_transitive = 0; _transitive < 2; _transitive++) {
+        _min = UINT32_MAX;
+        _max = 0;
+        _sum = 0;
+
+        for (unsigned i = 0; i < ROUNDS; i++) {
+            _busy = (i + 1) * BUSY_STEP;
+            thread_flags_set(_low, FLAG_GO);
+            /* main has the lowest priority, so all others are done when
+             * this returns */
+            thread_flags_wait_any(FLAG_GO);
+        }
+
+        printf("{ \"phase\" : \"%s\", \"min\" : %" PRIu32 ", \"avg\" : %"
+               PRIu32 ", \"max\" : %" PRIu32 " }\n",
+               _transitive ? "transitive" : "direct",
+               _min, _sum / ROUNDS, _max);
+    }
+
+    return 0;
+}
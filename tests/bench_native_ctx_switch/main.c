@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Context switch benchmark for native's switching backends
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifdef MODULE_NATIVE_FAST_CTX
+#define BACKEND             "fast"
+#else
+#define BACKEND             "ucontext"
+#endif
+
+static volatile unsigned _flag;
+static char _yield_stack[THREAD_STACKSIZE_MAIN];
+static char _msg_stack[THREAD_STACKSIZE_MAIN];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void *_yield_thread(void *arg)
+{
+    (void)arg;
+
+    while (!_flag) {
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+static void *_msg_thread(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+    }
+
+    return NULL;
+}
+
+static uint32_t _run(void (*func)(kernel_pid_t), kernel_pid_t pid)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        func(pid);
+        n++;
+    }
+
+    return n;
+}
+
+static void _yield(kernel_pid_t pid)
+{
+    (void)pid;
+    thread_yield();
+}
+
+static void _send(kernel_pid_t pid)
+{
+    msg_t m;
+
+    msg_send(&m, pid);
+}
+
+int main(void)
+{
+    printf("main starting, backend: %s\n", BACKEND);
+
+    kernel_pid_t yield_pid = thread_create(_yield_stack, sizeof(_yield_stack),
+                                           THREAD_PRIORITY_MAIN,
+                                           THREAD_CREATE_STACKTEST,
+                                           _yield_thread, NULL, "yield");
+    printf("{ \"yield\" : %"PRIu32" }\n", _run(_yield, yield_pid));
+    /* let the yield thread see the flag and exit */
+    thread_yield();
+
+    kernel_pid_t msg_pid = thread_create(_msg_stack, sizeof(_msg_stack),
+                                         THREAD_PRIORITY_MAIN - 1,
+                                         THREAD_CREATE_STACKTEST,
+                                         _msg_thread, NULL, "msg");
+    printf("{ \"msg\" : %"PRIu32" }\n", _run(_send, msg_pid));
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive throughput benchmark for netdev_tap
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/ethernet.h"
+#include "netdev_tap.h"
+#include "netdev_tap_params.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define RX_QUEUE_SIZE       (8)
+#define MSG_TYPE_ISR        (0x4242)
+
+typedef struct {
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t isrs;
+    uint32_t errors;
+    uint32_t first_usec;
+    uint32_t last_usec;
+} _stats_t;
+
+static netdev_tap_t _dev;
+static kernel_pid_t _rx_pid;
+static char _rx_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _rx_queue[RX_QUEUE_SIZE];
+static uint8_t _frame[ETHERNET_FRAME_LEN];
+static _stats_t _stats;
+
+static void _recv(netdev_t *netdev)
+{
+    int len = netdev->driver->recv(netdev, NULL, 0, NULL);
+
+    if ((len <= 0) || (len > (int)sizeof(_frame))) {
+        _stats.errors++;
+        if (len > 0) {
+            /* drop the frame */
+            netdev->driver->recv(netdev, NULL, len, NULL);
+        }
+        return;
+    }
+    len = netdev->driver->recv(netdev, _frame, len, NULL);
+    if (len <= 0) {
+        _stats.errors++;
+        return;
+    }
+    _stats.last_usec = xtimer_now_usec();
+    if (_stats.frames == 0) {
+        _stats.first_usec = _stats.last_usec;
+    }
+    _stats.frames++;
+    _stats.bytes += len;
+}
+
+static void _event_cb(netdev_t *netdev, netdev_event_t event)
+{
+    switch (event) {
+        case NETDEV_EVENT_ISR: {
+            msg_t msg = { .type = MSG_TYPE_ISR, .content.ptr = netdev };
+
+            if (msg_send(&msg, _rx_pid) <= 0) {
+                puts("error: lost interrupt");
+            }
+            break;
+        }
+        case NETDEV_EVENT_RX_COMPLETE:
+            _recv(netdev);
+            break;
+        default:
+            break;
+    }
+}
+
+static void *_rx_thread(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_rx_queue, RX_QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_ISR) {
+            netdev_t *netdev = msg.content.ptr;
+
+            _stats.isrs++;
+            netdev->driver->isr(netdev);
+        }
+    }
+    return NULL;
+}
+
+static int _stats_cmd(int argc, char **argv)
+{
+    uint32_t usec = _stats.last_usec - _stats.first_usec;
+
+    (void)argc;
+    (void)argv;
+    printf("received %" PRIu32 " frames, %" PRIu32 " bytes in %" PRIu32
+           " us (%" PRIu32 " errors)\n", _stats.frames, _stats.bytes, usec,
+           _stats.errors);
+    printf("%" PRIu32 " interrupts", _stats.isrs);
+    if (_stats.isrs > 0) {
+        printf(", %" PRIu32 ".%02" PRIu32 " frames per interrupt",
+               _stats.frames / _stats.isrs,
+               ((_stats.frames % _stats.isrs) * 100) / _stats.isrs);
+    }
+    puts("");
+    if (usec > 0) {
+        printf("rate: %" PRIu32 " frames/s\n",
+               (uint32_t)(((uint64_t)(_stats.frames - 1) * US_PER_SEC) / usec));
+    }
+    return 0;
+}
+
+static int _reset_cmd(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    _stats = (_stats_t){ 0 };
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "stats", "print receive statistics", _stats_cmd },
+    { "reset", "reset receive statistics", _reset_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    netdev_t *netdev = (netdev_t *)&_dev;
+    bool promisc = true;
+
+    _rx_pid = thread_create(_rx_stack, sizeof(_rx_stack),
+                            THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                            _rx_thread, NULL, "rx");
+    netdev_tap_setup(&_dev, &netdev_tap_params[0]);
+    netdev->event_callback = _event_cb;
+    netdev->driver->init(netdev);
+    /* count every frame the host sends, regardless of its destination */
+    netdev->driver->set(netdev, NETOPT_PROMISCUOUSMODE, &promisc,
+                        sizeof(promisc));
+    printf("Counting frames received on %s\n", _dev.tap_name);
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Network registry dispatch benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_DISPATCHES
+#define TEST_DISPATCHES     (10000U)
+#endif
+
+#define REGS_MAX            (100U)
+
+/* first demultiplexing context, chosen like the dynamic port range */
+#define DEMUX_CTX_BASE      (49152U)
+
+static const unsigned _regs_numof[] = { 0, 10, 50, 100 };
+
+static gnrc_netreg_entry_t _entries[REGS_MAX + 1];
+static gnrc_netreg_entry_cbd_t _cbd;
+static unsigned _received;
+
+static void _receive(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)ctx;
+    _received++;
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _run(unsigned regs, gnrc_pktsnip_t *pkt)
+{
+    /* the receiver of the benchmarked packets */
+    gnrc_netreg_entry_init_cb(&_entries[0], DEMUX_CTX_BASE, &_cbd);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[0]);
+    /* registered later, so they are in front of it in a linked list */
+    for (unsigned i = 1; i <= regs; i++) {
+        gnrc_netreg_entry_init_cb(&_entries[i], DEMUX_CTX_BASE + i, &_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[i]);
+    }
+
+    _received = 0;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_DISPATCHES; i++) {
+        gnrc_pktbuf_hold(pkt, 1);
+        gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UNDEF, DEMUX_CTX_BASE, pkt);
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    for (unsigned i = 0; i <= regs; i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &_entries[i]);
+    }
+
+    printf("{ \"registrations\" : %u, \"dispatches\" : %u, "
+           "\"usec\" : %" PRIu32 " }\n", regs, _received, duration);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    _cbd.cb = _receive;
+    _cbd.ctx = NULL;
+
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_UNDEF);
+
+    if (pkt == NULL) {
+        puts("unable to allocate packet");
+        return 1;
+    }
+    for (unsigned i = 0; i < sizeof(_regs_numof) / sizeof(_regs_numof[0]); i++) {
+        _run(_regs_numof[i], pkt);
+    }
+    gnrc_pktbuf_release(pkt);
+
+    puts("done");
+
+    return 0;
+}
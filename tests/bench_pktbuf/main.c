@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Packet buffer stress benchmark
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_OPS
+#define TEST_OPS            (20000U)
+#endif
+
+/* number of packets held at the same time */
+#define SLOTS               (16U)
+
+/* maximum size of a link layer frame in the mixed workload */
+#define FRAME_MAX           (1280U)
+
+typedef struct {
+    const char *name;
+    unsigned large_percent;     /**< share of Ethernet sized frames */
+} workload_t;
+
+static const workload_t _workloads[] = {
+    { .name = "ieee802154", .large_percent = 0 },
+    { .name = "mixed", .large_percent = 10 },
+    { .name = "ethernet", .large_percent = 50 },
+};
+
+static gnrc_pktsnip_t *_slots[SLOTS];
+static bool _forwarded[SLOTS];
+static uint8_t _frame[FRAME_MAX];
+static uint32_t _rand_state;
+
+/* xorshift, so that all implementations see the same sequence */
+static uint32_t _rand(void)
+{
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static size_t _frame_size(const workload_t *workload)
+{
+    if ((_rand() % 100) < workload->large_percent) {
+        return 128 + (_rand() % (FRAME_MAX - 128));
+    }
+    return 8 + (_rand() % 120);
+}
+
+/* receive a frame and parse some headers off it, as the stack would */
+static unsigned _receive(gnrc_pktsnip_t **slot, const workload_t *workload)
+{
+    size_t size = _frame_size(workload);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _frame, size,
+                                          GNRC_NETTYPE_UNDEF);
+
+    if (pkt == NULL) {
+        return 1;
+    }
+    for (unsigned i = 0; i < 2; i++) {
+        size_t hdr = 2 + (_rand() % 20);
+        if ((hdr < pkt->size) &&
+            (gnrc_pktbuf_mark(pkt, hdr, GNRC_NETTYPE_UNDEF) == NULL)) {
+            gnrc_pktbuf_release(pkt);
+            return 1;
+        }
+    }
+    *slot = pkt;
+    return 0;
+}
+
+/* prepend a header to a received packet once, as when forwarding it */
+static unsigned _forward(unsigned slot)
+{
+    if (_forwarded[slot]) {
+        return 0;
+    }
+
+    gnrc_pktsnip_t *hdr = gnrc_pktbuf_add(_slots[slot], _frame, 40,
+                                          GNRC_NETTYPE_UNDEF);
+
+    if (hdr == NULL) {
+        return 1;
+    }
+    _slots[slot] = hdr;
+    _forwarded[slot] = true;
+    return 0;
+}
+
+static void _run(const workload_t *workload)
+{
+    unsigned failed = 0;
+
+    _rand_state = 0x2545F491;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned op = 0; op < TEST_OPS; op++) {
+        unsigned slot = _rand() % SLOTS;
+
+        if (_slots[slot] == NULL) {
+            failed += _receive(&_slots[slot], workload);
+        }
+        else if (_rand() & 1) {
+            gnrc_pktbuf_release(_slots[slot]);
+            _slots[slot] = NULL;
+            _forwarded[slot] = false;
+        }
+        else {
+            failed += _forward(slot);
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    for (unsigned i = 0; i < SLOTS; i++) {
+        gnrc_pktbuf_release(_slots[i]);
+        _slots[i] = NULL;
+        _forwarded[i] = false;
+    }
+
+    printf("{ \"workload\" : \"%s\", \"ops\" : %u, \"failed\" : %u, "
+           "\"usec\" : %" PRIu32 " }\n", workload->name, TEST_OPS, failed,
+           duration);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < sizeof(_workloads) / sizeof(_workloads[0]); i++) {
+        gnrc_pktbuf_init();
+        _run(&_workloads[i]);
+#ifdef DEVELHELP
+        gnrc_pktbuf_stats();
+#endif
+    }
+
+    puts("done");
+
+    return 0;
+}
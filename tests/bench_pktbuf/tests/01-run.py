@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for workload in ("ieee802154", "mixed", "ethernet"):
+        child.expect(r"{ \"workload\" : \"%s\", \"ops\" : \d+, "
+                     r"\"failed\" : \d+, \"usec\" : \d+ }" % workload)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
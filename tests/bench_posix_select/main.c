@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   UDP echo server serving several sockets from a single thread
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8)
+#define ECHO_BUFFER_SIZE    (1280)
+
+typedef struct {
+    uint32_t datagrams;
+    uint32_t bytes;
+} _stats_t;
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _buf[ECHO_BUFFER_SIZE];
+static struct pollfd _fds[ECHO_SOCKETS];
+static _stats_t _stats[ECHO_SOCKETS];
+static uint32_t _first_usec, _last_usec;
+static uint32_t _wakeups;
+
+static int _open(unsigned i)
+{
+    struct sockaddr_in6 local = { .sin6_family = AF_INET6,
+                                  .sin6_port = htons(ECHO_PORT + i) };
+    int fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (fd < 0) {
+        printf("error: can't open socket %u\n", i);
+        return -1;
+    }
+    if (bind(fd, (struct sockaddr *)&local, sizeof(local)) < 0) {
+        printf("error: can't bind socket %u to port %u\n", i, ECHO_PORT + i);
+        return -1;
+    }
+    return fd;
+}
+
+static void _echo(unsigned i)
+{
+    struct sockaddr_in6 remote;
+    socklen_t remote_len = sizeof(remote);
+    ssize_t res;
+
+    /* poll() reported the socket as readable, so this does not block */
+    res = recvfrom(_fds[i].fd, _buf, sizeof(_buf), MSG_DONTWAIT,
+                   (struct sockaddr *)&remote, &remote_len);
+    if (res < 0) {
+        return;
+    }
+    if (sendto(_fds[i].fd, _buf, res, 0, (struct sockaddr *)&remote,
+               remote_len) < 0) {
+        printf("error: can't echo on port %u\n", ECHO_PORT + i);
+        return;
+    }
+    _last_usec = xtimer_now_usec();
+    if (_first_usec == 0) {
+        _first_usec = _last_usec;
+    }
+    _stats[i].datagrams++;
+    _stats[i].bytes += res;
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < ECHO_SOCKETS; i++) {
+        if ((_fds[i].fd = _open(i)) < 0) {
+            return NULL;
+        }
+        _fds[i].events = POLLIN;
+    }
+    printf("Serving %u sockets on ports %u-%u from one thread\n",
+           ECHO_SOCKETS, ECHO_PORT, ECHO_PORT + ECHO_SOCKETS - 1);
+    while (1) {
+        if (poll(_fds, ECHO_SOCKETS, -1) < 0) {
+            puts("error: poll() failed");
+            return NULL;
+        }
+        _wakeups++;
+        for (unsigned i = 0; i < ECHO_SOCKETS; i++) {
+            if (_fds[i].revents & POLLIN) {
+                _echo(i);
+            }
+        }
+    }
+    return NULL;
+}
+
+static int _stats_cmd(int argc, char **argv)
+{
+    uint32_t datagrams = 0, bytes = 0;
+    uint32_t usec = _last_usec - _first_usec;
+
+    (void)argc;
+    (void)argv;
+    for (unsigned i = 0; i < ECHO_SOCKETS; i++) {
+        printf("port %u: %" PRIu32 " datagrams, %" PRIu32 " bytes\n",
+               ECHO_PORT + i, _stats[i].datagrams, _stats[i].bytes);
+        datagrams += _stats[i].datagrams;
+        bytes += _stats[i].bytes;
+    }
+    printf("total: %" PRIu32 " datagrams, %" PRIu32 " bytes in %" PRIu32
+           " us, %" PRIu32 " poll() wakeups\n", datagrams, bytes, usec,
+           _wakeups);
+    if (usec > 0) {
+        printf("rate: %" PRIu32 " datagrams/s\n",
+               (uint32_t)(((uint64_t)datagrams * US_PER_SEC) / usec));
+    }
+    printf("stack: 1 thread with %u bytes instead of %u threads with "
+           "%u bytes\n", (unsigned)sizeof(_server_stack), ECHO_SOCKETS,
+           (unsigned)sizeof(_server_stack));
+    return 0;
+}
+
+static int _reset_cmd(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    memset(_stats, 0, sizeof(_stats));
+    _first_usec = 0;
+    _last_usec = 0;
+    _wakeups = 0;
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "stats", "print echo statistics", _stats_cmd },
+    { "reset", "reset echo statistics", _reset_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "echo");
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Ring buffer throughput benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "lfrb.h"
+#include "ringbuffer.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#define BUF_SIZE            (512U)
+#define CHUNK_MAX           (256U)
+
+typedef size_t (*transfer_t)(const uint8_t *src, uint8_t *dst, size_t n);
+
+volatile unsigned _flag = 0;
+
+static char _buf[BUF_SIZE];
+static ringbuffer_t _ringbuffer;
+static lfrb_t _lfrb;
+static lfrb_mpsc_t _mpsc;
+
+static uint8_t _src[CHUNK_MAX];
+static uint8_t _dst[CHUNK_MAX];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static size_t _bytewise(const uint8_t *src, uint8_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        lfrb_add_one(&_lfrb, src[i]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = lfrb_get_one(&_lfrb);
+    }
+    return n;
+}
+
+static size_t _ringbuffer_transfer(const uint8_t *src, uint8_t *dst, size_t n)
+{
+    ringbuffer_add(&_ringbuffer, (const char *)src, n);
+    return ringbuffer_get(&_ringbuffer, (char *)dst, n);
+}
+
+static size_t _lfrb_transfer(const uint8_t *src, uint8_t *dst, size_t n)
+{
+    lfrb_add(&_lfrb, src, n);
+    return lfrb_get(&_lfrb, dst, n);
+}
+
+static size_t _lfrb_zerocopy(const uint8_t *src, uint8_t *dst, size_t n)
+{
+    size_t done = 0;
+
+    /* the producer fills the buffer in place, the consumer reads in place */
+    while (done < n) {
+        void *wr;
+        size_t len = lfrb_reserve(&_lfrb, &wr);
+        if (len > n - done) {
+            len = n - done;
+        }
+        memcpy(wr, src + done, len);
+        lfrb_commit(&_lfrb, len);
+        done += len;
+    }
+    done = 0;
+    while (done < n) {
+        const void *rd;
+        size_t len = lfrb_peek_region(&_lfrb, &rd);
+        memcpy(dst + done, rd, len);
+        lfrb_consume(&_lfrb, len);
+        done += len;
+    }
+    return n;
+}
+
+static size_t _mpsc_transfer(const uint8_t *src, uint8_t *dst, size_t n)
+{
+    lfrb_mpsc_add(&_mpsc, src, n);
+    return lfrb_get(&_mpsc.rb, dst, n);
+}
+
+static void _run(const char *name, transfer_t transfer)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+
+    /* start each run with an offset so that chunks wrap around the end */
+    ringbuffer_init(&_ringbuffer, _buf, sizeof(_buf));
+    lfrb_init(&_lfrb, _buf, sizeof(_buf));
+    lfrb_mpsc_init(&_mpsc, _buf, sizeof(_buf));
+    transfer(_src, _dst, 3);
+
+    for (unsigned chunk = 1; chunk <= CHUNK_MAX; chunk <<= 1) {
+        uint32_t n = 0;
+
+        _flag = 0;
+        xtimer_set(&timer, TEST_DURATION);
+        while (!_flag) {
+            n += transfer(_src, _dst, chunk);
+        }
+
+        printf("{ \"buffer\" : \"%s\", \"chunk\" : %u, \"result\" : %" PRIu32
+               " }\n", name, chunk, n);
+    }
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < CHUNK_MAX; i++) {
+        _src[i] = i;
+    }
+
+    _run("bytewise", _bytewise);
+    _run("ringbuffer", _ringbuffer_transfer);
+    _run("lfrb", _lfrb_transfer);
+    _run("lfrb_zerocopy", _lfrb_zerocopy);
+    _run("lfrb_mpsc", _mpsc_transfer);
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for buffer in ("bytewise", "ringbuffer", "lfrb", "lfrb_zerocopy",
+                   "lfrb_mpsc"):
+        for chunk in (1, 2, 4, 8, 16, 32, 64, 128, 256):
+            child.expect(r"{ \"buffer\" : \"%s\", \"chunk\" : %d, "
+                         r"\"result\" : \d+ }" % (buffer, chunk))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
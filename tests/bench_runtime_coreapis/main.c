@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 
+#include "irq.h"
 #include "mutex.h"
 #include "benchmark.h"
 #include "thread.h"
@@ -34,6 +35,12 @@ static thread_t *t;
 static thread_flags_t _flag = 0x0001;
 static msg_t _msg;
 
+static void _irq_disable_restore(void)
+{
+    unsigned state = irq_disable();
+    irq_restore(state);
+}
+
 static void _mutex_lockunlock(void)
 {
     mutex_lock(&_lock);
@@ -66,6 +73,9 @@ int main(void)
 
     BENCHMARK_FUNC("nop loop", BENCH_RUNS, __asm__ volatile ("nop"));
     puts("");
+    BENCHMARK_FUNC("irq_disable()/irq_restore()", BENCH_RUNS,
+                   _irq_disable_restore());
+    puts("");
     BENCHMARK_FUNC("mutex_init()", BENCH_RUNS, mutex_init(&_lock));
     BENCHMARK_FUNC("mutex lock/unlock", BENCH_RUNS, _mutex_lockunlock());
     puts("");
@@ -53,5 +53,18 @@ int main(void)
 
     printf("{ \"result\" : %"PRIu32" }\n", n);
 
+    /* thread_yield() skips the context switch if there is no other thread to
+     * schedule, so force it to also measure context save / restore */
+    n = 0;
+    _flag = 0;
+
+    xtimer_set(&timer, TEST_DURATION);
+    while(!_flag) {
+        thread_yield_higher();
+        n++;
+    }
+
+    printf("{ \"yield_higher\" : %"PRIu32" }\n", n);
+
     return 0;
 }
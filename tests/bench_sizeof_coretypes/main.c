@@ -94,7 +94,8 @@ int main(void)
     P(flags);
 #endif
     P(rq_entry);
-#if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) || defined(MODULE_CORE_MBOX)
+#if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) || defined(MODULE_CORE_MBOX) \
+    || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
     P(wait_data);
 #endif
 #ifdef MODULE_CORE_MSG
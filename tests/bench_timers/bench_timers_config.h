@@ -241,6 +241,19 @@ extern "C" {
 /* estimate_cpu_overhead will loop for this many iterations to get a proper estimate */
 #define ESTIMATE_CPU_ITERATIONS 2048
 
+/* Number of background xtimers kept armed during the xtimer test, used to
+ * benchmark the xtimer backend with many concurrent timers, 0 to disable */
+#ifndef TEST_XTIMER_STRESS
+#define TEST_XTIMER_STRESS 0
+#endif
+/* Range of the timeouts used for the background timers (TUT ticks) */
+#ifndef TEST_XTIMER_STRESS_MIN
+#define TEST_XTIMER_STRESS_MIN 1000
+#endif
+#ifndef TEST_XTIMER_STRESS_MAX
+#define TEST_XTIMER_STRESS_MAX 1000000
+#endif
+
 #if TEST_XTIMER
 #define READ_TUT() _xtimer_now()
 #else
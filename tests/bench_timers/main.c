@@ -369,6 +369,60 @@ static void nop(void *arg)
     (void)arg;
 }
 
+#if TEST_XTIMER_STRESS
+static xtimer_t stress_timers[TEST_XTIMER_STRESS];
+
+static void cb_stress(void *arg)
+{
+    /* keep the timer list busy by rearming with a new random timeout */
+    _xtimer_set(arg, random_uint32_range(TEST_XTIMER_STRESS_MIN,
+                                         TEST_XTIMER_STRESS_MAX));
+}
+
+static void print_stress_result(const char *what, uint32_t ticks)
+{
+    print_str(what);
+    print_u32_dec(ticks / TEST_XTIMER_STRESS);
+    print_str(".");
+    print_u32_dec(((ticks % TEST_XTIMER_STRESS) * 10) / TEST_XTIMER_STRESS);
+    print_str(" ref ticks/op\n");
+}
+
+static void start_stress(void)
+{
+    print_str("xtimer stress: ");
+    print_u32_dec(TEST_XTIMER_STRESS);
+    print_str(" timers\n");
+    uint32_t begin = timer_read(TIM_REF_DEV);
+    for (unsigned i = 0; i < TEST_XTIMER_STRESS; i++) {
+        stress_timers[i].callback = cb_stress;
+        stress_timers[i].arg = &stress_timers[i];
+        _xtimer_set(&stress_timers[i],
+                    random_uint32_range(TEST_XTIMER_STRESS_MIN,
+                                        TEST_XTIMER_STRESS_MAX));
+    }
+    print_stress_result("set: ", timer_read(TIM_REF_DEV) - begin);
+    /* replacing an armed timer removes it from the list first */
+    begin = timer_read(TIM_REF_DEV);
+    for (unsigned i = 0; i < TEST_XTIMER_STRESS; i++) {
+        _xtimer_set(&stress_timers[i],
+                    random_uint32_range(TEST_XTIMER_STRESS_MIN,
+                                        TEST_XTIMER_STRESS_MAX));
+    }
+    print_stress_result("resched: ", timer_read(TIM_REF_DEV) - begin);
+    begin = timer_read(TIM_REF_DEV);
+    for (unsigned i = 0; i < TEST_XTIMER_STRESS; i++) {
+        xtimer_remove(&stress_timers[i]);
+    }
+    print_stress_result("remove: ", timer_read(TIM_REF_DEV) - begin);
+    for (unsigned i = 0; i < TEST_XTIMER_STRESS; i++) {
+        _xtimer_set(&stress_timers[i],
+                    random_uint32_range(TEST_XTIMER_STRESS_MIN,
+                                        TEST_XTIMER_STRESS_MAX));
+    }
+}
+#endif /* TEST_XTIMER_STRESS */
+
 static void run_test(test_ctx_t *ctx, uint32_t interval, unsigned int variant)
 {
     interval += TEST_MIN;
@@ -737,6 +791,10 @@ int main(void)
     print_u32_dec(spin_max);
     print("\n", 1);
     estimate_cpu_overhead();
+#if TEST_XTIMER && TEST_XTIMER_STRESS
+    /* the background timers are left running during the accuracy test */
+    start_stress();
+#endif
 #ifdef MODULE_PERIPH_RTT
     rtt_begin = rtt_get_counter();
 #endif
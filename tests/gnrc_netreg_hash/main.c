@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Runs the tests-netreg unittests against the gnrc_netreg_hash backend
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-netreg.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_netreg();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Runs the tests-pktbuf unittests against gnrc_pktbuf_slab
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-pktbuf.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_pktbuf();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests acknowledgments and retransmissions of selective
+ *              fragment recovery
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MSG_QUEUE_SIZE      (8U)
+#define FRAG_SIZE           (32U)
+#define HDR_SIZE            (20U)
+#define PAYLOAD_SIZE        (60U)
+/* uncompressed size of the datagram sent, passed through only */
+#define DATAGRAM_SIZE       (100U)
+/* size of the datagram received */
+#define RCV_DATAGRAM_SIZE   (70U)
+#define RCV_TAG             (0x42)
+#define WAIT                (2 * GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT)
+
+#define SEQ_BIT(seq)        (0x80000000UL >> (seq))
+
+static uint8_t _loc_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static uint8_t _rem_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static gnrc_netif_t _netif;
+static gnrc_netreg_entry_t _ipv6_reg;
+
+static gnrc_pktsnip_t *_netif_hdr(uint8_t *src, uint8_t *dst)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(src, sizeof(_loc_l2),
+                                                 dst, sizeof(_rem_l2));
+
+    if (netif != NULL) {
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid = thread_getpid();
+    }
+    return netif;
+}
+
+static void _set_up(void)
+{
+    msg_t msg;
+
+    /* drop everything left over from a failed test */
+    while (msg_try_receive(&msg) > 0) {
+        if ((msg.type == GNRC_NETAPI_MSG_TYPE_SND) ||
+            (msg.type == GNRC_NETAPI_MSG_TYPE_RCV)) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    _netif.sixlo.max_frag_size = sizeof(sixlowpan_sfr_rfrag_t) + FRAG_SIZE;
+}
+
+/* sends a datagram of three fragments to _rem_l2 */
+static void _send(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    pkt = gnrc_pktbuf_add(pkt, NULL, HDR_SIZE, GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    netif = _netif_hdr(_loc_l2, _rem_l2);
+    TEST_ASSERT_NOT_NULL(netif);
+    netif->next = pkt;
+    TEST_ASSERT(gnrc_sixlowpan_frag_sfr_send(netif, DATAGRAM_SIZE, &_netif));
+}
+
+/* receives the next packet sent, returns its 6LoWPAN header */
+static gnrc_pktsnip_t *_sent(void)
+{
+    msg_t msg;
+
+    if ((msg_try_receive(&msg) < 0) || (msg.type != GNRC_NETAPI_MSG_TYPE_SND)) {
+        return NULL;
+    }
+    return msg.content.ptr;
+}
+
+/* checks that the next packet sent is the given RFRAG, returns its tag */
+static int _expect_rfrag(unsigned seq, bool ack_req)
+{
+    gnrc_pktsnip_t *pkt = _sent();
+    sixlowpan_sfr_rfrag_t *rfrag;
+    int tag;
+
+    if (pkt == NULL) {
+        return -1;
+    }
+    rfrag = pkt->next->data;
+    if (!sixlowpan_sfr_rfrag_is(pkt->next->data) ||
+        (sixlowpan_sfr_rfrag_get_seq(rfrag) != seq) ||
+        (sixlowpan_sfr_rfrag_ack_req(rfrag) != ack_req)) {
+        tag = -1;
+    }
+    else {
+        tag = rfrag->tag;
+    }
+    gnrc_pktbuf_release(pkt);
+    return tag;
+}
+
+/* checks that the next packet sent is an RFRAG-ACK with the given bitmap */
+static bool _expect_ack(uint8_t tag, uint32_t bitmap)
+{
+    gnrc_pktsnip_t *pkt = _sent();
+    sixlowpan_sfr_ack_t *ack;
+    bool res;
+
+    if (pkt == NULL) {
+        return false;
+    }
+    ack = pkt->next->data;
+    res = sixlowpan_sfr_ack_is(pkt->next->data) && (ack->tag == tag) &&
+          (byteorder_ntohl(ack->bitmap) == bitmap);
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+/* hands an RFRAG-ACK from _rem_l2 to 6LoWPAN */
+static void _recv_ack(uint8_t tag, uint32_t bitmap)
+{
+    gnrc_pktsnip_t *pkt;
+    sixlowpan_sfr_ack_t *ack;
+
+    pkt = gnrc_pktbuf_add(_netif_hdr(_rem_l2, _loc_l2), NULL, sizeof(*ack),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    ack = pkt->data;
+    ack->disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    ack->tag = tag;
+    ack->bitmap = byteorder_htonl(bitmap);
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+}
+
+/* hands an RFRAG of a RCV_DATAGRAM_SIZE bytes datagram from _rem_l2 to
+ * 6LoWPAN. Fragment 0 carries 30 bytes after the uncompressed dispatch,
+ * fragment 1 30 and fragment 2 10 bytes. */
+static void _recv_rfrag(unsigned seq, bool ack_req)
+{
+    static const uint16_t offsets[] = { RCV_DATAGRAM_SIZE, 31, 61 };
+    static const uint16_t sizes[] = { 31, 30, 10 };
+    gnrc_pktsnip_t *pkt;
+    uint8_t *data;
+
+    pkt = gnrc_pktbuf_add(_netif_hdr(_rem_l2, _loc_l2), NULL,
+                          sizeof(sixlowpan_sfr_rfrag_t) + sizes[seq],
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    sixlowpan_sfr_rfrag_set(pkt->data, RCV_TAG, seq, sizes[seq], offsets[seq],
+                            ack_req);
+    data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_sfr_rfrag_t);
+    memset(data, seq, sizes[seq]);
+    if (seq == 0) {
+        data[0] = SIXLOWPAN_UNCOMP;
+    }
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+}
+
+/* waits for the next retransmission timeout */
+static bool _wait_arq(msg_t *msg)
+{
+    return (xtimer_msg_receive_timeout(msg, WAIT) >= 0) &&
+           (msg->type == GNRC_SIXLOWPAN_MSG_FRAG_SFR_ARQ);
+}
+
+/*
+ * All fragments are sent in one go, only the last one requests an
+ * acknowledgment. A full RFRAG-ACK releases the datagram.
+ */
+static void test_sfr_send(void)
+{
+    int tag;
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    TEST_ASSERT_NULL(_sent());
+    _recv_ack(tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Only fragments missing from all RFRAG-ACKs so far are sent again, and the
+ * datagram is complete once all of them acknowledged every fragment.
+ */
+static void test_sfr_ack__partial(void)
+{
+    msg_t msg;
+    int tag;
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+
+    _recv_ack(tag, SEQ_BIT(0) | SEQ_BIT(2));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, true));
+    TEST_ASSERT_NULL(_sent());
+
+    _recv_ack(tag, SEQ_BIT(1));
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* the retransmission timer is stopped */
+    TEST_ASSERT(xtimer_msg_receive_timeout(&msg, WAIT) < 0);
+}
+
+static void test_sfr_ack__abort(void)
+{
+    int tag;
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    _recv_ack(tag, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Without acknowledgment, the datagram is sent again on every timeout, until
+ * it is given up.
+ */
+static void test_sfr_arq__retries(void)
+{
+    msg_t msg;
+    int tag;
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_RETRIES; i++) {
+        TEST_ASSERT(_wait_arq(&msg));
+        gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.value);
+        TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(0, false));
+        TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+        TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    }
+    TEST_ASSERT(_wait_arq(&msg));
+    gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.value);
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * A timeout queued before an RFRAG-ACK triggered the next round is ignored.
+ */
+static void test_sfr_arq__stale_round(void)
+{
+    msg_t msg;
+    int tag;
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    TEST_ASSERT(_wait_arq(&msg));
+
+    _recv_ack(tag, SEQ_BIT(0));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.value);
+    TEST_ASSERT_NULL(_sent());
+
+    _recv_ack(tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * A timeout of an acknowledged datagram does not affect the next datagram
+ * in the same fragmentation buffer entry.
+ */
+static void test_sfr_arq__stale_datagram(void)
+{
+    msg_t msg;
+    int tag;
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    TEST_ASSERT(_wait_arq(&msg));
+    _recv_ack(tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+
+    _send();
+    tag = _expect_rfrag(0, false);
+    TEST_ASSERT(tag >= 0);
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(1, false));
+    TEST_ASSERT_EQUAL_INT(tag, _expect_rfrag(2, true));
+    gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.value);
+    TEST_ASSERT_NULL(_sent());
+    _recv_ack(tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * The receiver acknowledges the fragments it has so far on request, and a
+ * completed datagram right away.
+ */
+static void test_sfr_recv(void)
+{
+    msg_t msg;
+
+    _recv_rfrag(0, false);
+    TEST_ASSERT_NULL(_sent());
+    _recv_rfrag(2, true);
+    TEST_ASSERT(_expect_ack(RCV_TAG, SEQ_BIT(0) | SEQ_BIT(2)));
+    _recv_rfrag(1, false);
+    TEST_ASSERT(_expect_ack(RCV_TAG, SIXLOWPAN_SFR_ACK_BITMAP_FULL));
+
+    TEST_ASSERT(xtimer_msg_receive_timeout(&msg, WAIT) >= 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    TEST_ASSERT_EQUAL_INT(RCV_DATAGRAM_SIZE,
+                          ((gnrc_pktsnip_t *)msg.content.ptr)->size);
+    gnrc_pktbuf_release(msg.content.ptr);
+}
+
+/*
+ * Fragments of a datagram reassembled already are acknowledged again, so a
+ * lost RFRAG-ACK does not time the datagram out at the sender.
+ */
+static void test_sfr_recv__reack(void)
+{
+    msg_t msg;
+
+    test_sfr_recv();
+    _recv_rfrag(2, true);
+    TEST_ASSERT(_expect_ack(RCV_TAG, SIXLOWPAN_SFR_ACK_BITMAP_FULL));
+    _recv_rfrag(1, false);
+    TEST_ASSERT_NULL(_sent());
+    /* the datagram is not delivered again */
+    TEST_ASSERT(xtimer_msg_receive_timeout(&msg, WAIT) < 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_sixlowpan_frag_sfr(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sfr_send),
+        new_TestFixture(test_sfr_ack__partial),
+        new_TestFixture(test_sfr_ack__abort),
+        new_TestFixture(test_sfr_arq__retries),
+        new_TestFixture(test_sfr_arq__stale_round),
+        new_TestFixture(test_sfr_arq__stale_datagram),
+        new_TestFixture(test_sfr_recv__reack),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_entry_init_pid(&_ipv6_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_sfr());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Node of the multi-hop 6LoWPAN fragment forwarding test
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "shell.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
+
+#define MAIN_QUEUE_SIZE     (8)
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static int _vrb(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    printf("forwarded fragments: %" PRIu32 "\n",
+           gnrc_sixlowpan_frag_vrb_forwarded());
+#else
+    puts("forwarded fragments: n/a");
+#endif
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "vrb", "print the number of fragments forwarded by the VRB", _vrb },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    /* the shell's ping6 needs a message queue */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("6LoWPAN fragment forwarding test node");
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import sys
+import time
+
+import pexpect
+
+# ZEP ports of the nodes' interfaces: (local, remote). The second interface of
+# the end nodes has no peer.
+TOPOLOGY = {
+    "a": [(17760, 17761), (17764, 17765)],
+    "r": [(17761, 17760), (17762, 17763)],
+    "b": [(17763, 17762), (17766, 17767)],
+}
+PROMPT = r"\r?\n> "
+VRB = os.environ.get("VRB", "1") == "1"
+COUNT = int(os.environ.get("COUNT", 20))
+PAYLOAD_LEN = int(os.environ.get("PAYLOAD_LEN", 400))
+
+
+def spawn(elf, ports):
+    args = []
+    for local, remote in ports:
+        args += ["-z", "[::1]:{},[::1]:{}".format(local, remote)]
+    child = pexpect.spawnu(elf, args, timeout=10)
+    child.logfile = sys.stdout
+    child.expect_exact("6LoWPAN fragment forwarding test node")
+    child.expect_exact("> ")
+    return child
+
+
+def cmd(child, line, timeout=10):
+    child.sendline(line)
+    child.expect(PROMPT, timeout=timeout)
+    return child.before
+
+
+def ifaces(child):
+    """Returns (PID, link-local address) of each interface, in the order of
+    the ZEP sockets"""
+    res = []
+    for block in re.split(r"Iface\s+", cmd(child, "ifconfig"))[1:]:
+        addr = re.search(r"inet6 addr: (fe80:[0-9a-f:]+)", block)
+        res.append((int(block.split()[0]), addr.group(1)))
+    return sorted(res)
+
+
+def testfunc(elf):
+    nodes = {name: spawn(elf, ports) for name, ports in TOPOLOGY.items()}
+    try:
+        a, r, b = (ifaces(nodes[n]) for n in "arb")
+
+        cmd(nodes["a"], "ifconfig {} add 2001:db8:a::1/64".format(a[0][0]))
+        cmd(nodes["b"], "ifconfig {} add 2001:db8:b::1/64".format(b[0][0]))
+        cmd(nodes["a"], "nib route add {} default {}".format(a[0][0], r[0][1]))
+        cmd(nodes["b"], "nib route add {} default {}".format(b[0][0], r[1][1]))
+        cmd(nodes["r"], "nib route add {} 2001:db8:a::/64 {}"
+                        .format(r[0][0], a[0][1]))
+        cmd(nodes["r"], "nib route add {} 2001:db8:b::/64 {}"
+                        .format(r[1][0], b[0][1]))
+        time.sleep(1)
+
+        out = cmd(nodes["a"], "ping6 {} 2001:db8:b::1 {} 100"
+                              .format(COUNT, PAYLOAD_LEN),
+                  timeout=COUNT + 10)
+        stats = re.search(r"(\d+) packets transmitted, (\d+) received", out)
+        rtt = re.search(r"rtt min/avg/max = ([0-9./]+) ms", out)
+        assert stats is not None
+        assert int(stats.group(2)) > 0, "no echo reply over two hops"
+
+        forwarded = re.search(r"forwarded fragments: (\d+|n/a)",
+                              cmd(nodes["r"], "vrb"))
+        assert forwarded is not None
+        if VRB:
+            assert forwarded.group(1) != "n/a", "VRB not built in"
+            assert int(forwarded.group(1)) > 0, "r reassembled all datagrams"
+        else:
+            assert forwarded.group(1) == "n/a", "VRB built in with VRB=0"
+        print("\n{{ \"payload\": {}, \"sent\": {}, \"received\": {}, "
+              "\"rtt\": \"{}\" }}".format(PAYLOAD_LEN, stats.group(1),
+                                          stats.group(2), rtt.group(1)))
+    finally:
+        for child in nodes.values():
+            child.terminate(force=True)
+
+
+if __name__ == "__main__":
+    testfunc(os.environ["ELFFILE"])
+    print("SUCCESS")
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the kernel event trace
+ *
+ * Exercises message passing, mutex contention and thread flags while tracing
+ * and checks that the exported trace contains the expected events.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ktrace.h"
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#define MSG_NUMOF           (4U)
+#define EXPORT_MAXLEN       (16U + (KERNEL_PID_LAST * 16U) + \
+                             (KTRACE_BUFSIZE * 12U))
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _lock = MUTEX_INIT;
+static uint8_t _export[EXPORT_MAXLEN];
+static size_t _export_len;
+static unsigned _counts[KTRACE_ISR_EXIT + 1];
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+    msg_t m, reply;
+
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        msg_receive(&m);
+        reply.type = m.type + 1;
+        msg_reply(&m, &reply);
+    }
+
+    mutex_lock(&_lock);
+    mutex_unlock(&_lock);
+
+    thread_flags_wait_any(0x1);
+
+    return NULL;
+}
+
+static void _write(const void *data, size_t len, void *arg)
+{
+    (void)arg;
+    if (_export_len + len <= sizeof(_export)) {
+        memcpy(&_export[_export_len], data, len);
+    }
+    _export_len += len;
+}
+
+int main(void)
+{
+    msg_t m, reply;
+
+    puts("ktrace test");
+
+    ktrace_clear();
+    ktrace_start();
+
+    /* the created thread runs until it blocks on msg_receive() */
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _thread, NULL, "ktrace");
+
+    /* after the last reply, the thread blocks on the mutex held by us */
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        m.type = i;
+        msg_send_receive(&m, &reply, pid);
+    }
+    mutex_unlock(&_lock);
+
+    thread_flags_set((thread_t *)thread_get(pid), 0x1);
+
+    ktrace_stop();
+
+    unsigned numof = ktrace_numof();
+    printf("%u events recorded\n", numof);
+
+    ktrace_export(_write, NULL);
+    if (_export_len > sizeof(_export) || memcmp(_export, "KTRC", 4) != 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    uint16_t threads = _export[6] | (_export[7] << 8);
+    const uint8_t *entry = &_export[16 + (threads * (2 + KTRACE_NAME_LEN))];
+
+    for (unsigned i = 0; i < numof; i++, entry += 12) {
+        if (entry[4] <= KTRACE_ISR_EXIT) {
+            _counts[entry[4]]++;
+        }
+    }
+
+    printf("switch: %u, msg send: %u, msg recv: %u, mutex block: %u, "
+           "mutex unblock: %u, flags set: %u\n",
+           _counts[KTRACE_SWITCH], _counts[KTRACE_MSG_SEND],
+           _counts[KTRACE_MSG_RECV], _counts[KTRACE_MUTEX_BLOCK],
+           _counts[KTRACE_MUTEX_UNBLOCK], _counts[KTRACE_FLAGS_SET]);
+
+    if ((_counts[KTRACE_SWITCH] == 0) ||
+        (_counts[KTRACE_MSG_SEND] < 2 * MSG_NUMOF) ||
+        (_counts[KTRACE_MSG_RECV] < MSG_NUMOF) ||
+        (_counts[KTRACE_MUTEX_BLOCK] != 1) ||
+        (_counts[KTRACE_MUTEX_UNBLOCK] != 1) ||
+        (_counts[KTRACE_FLAGS_SET] != 1)) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
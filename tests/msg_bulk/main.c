@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief Test application for msg_send_bulk() and msg_receive_bulk()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+
+#define MSG_QUEUE_LENGTH                (8)
+#define MSG_NUMOF                       (2 * MSG_QUEUE_LENGTH)
+
+static msg_t _main_queue[MSG_QUEUE_LENGTH];
+static msg_t _rcv_queue[MSG_QUEUE_LENGTH];
+static char _rcv_stack[THREAD_STACKSIZE_MAIN];
+static msg_t _msgs[MSG_NUMOF];
+static volatile unsigned _received;
+static volatile int _in_order = 1;
+
+static void *_rcv_thread(void *arg)
+{
+    (void)arg;
+    msg_t msgs[MSG_NUMOF];
+
+    msg_init_queue(_rcv_queue, MSG_QUEUE_LENGTH);
+
+    while (1) {
+        int n = msg_receive_bulk(msgs, MSG_NUMOF);
+        for (int i = 0; i < n; i++) {
+            if (msgs[i].type != _received++) {
+                _in_order = 0;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t got[MSG_NUMOF];
+
+    msg_init_queue(_main_queue, MSG_QUEUE_LENGTH);
+
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        _msgs[i].type = i;
+    }
+
+    puts("[START]");
+
+    /* sending to ourselves only fills the queue */
+    if ((msg_send_bulk(_msgs, MSG_NUMOF, thread_getpid()) != MSG_QUEUE_LENGTH) ||
+        (msg_avail() != MSG_QUEUE_LENGTH)) {
+        puts("[FAILED] send to self");
+        return 1;
+    }
+    if (msg_receive_bulk(got, MSG_NUMOF) != MSG_QUEUE_LENGTH) {
+        puts("[FAILED] receive from self");
+        return 1;
+    }
+    for (unsigned i = 0; i < MSG_QUEUE_LENGTH; i++) {
+        if ((got[i].type != i) || (got[i].sender_pid != thread_getpid())) {
+            puts("[FAILED] message order");
+            return 1;
+        }
+    }
+
+    /* a higher priority receiver gets the first message directly and the
+     * remaining ones through its queue */
+    kernel_pid_t rcv_pid = thread_create(_rcv_stack, sizeof(_rcv_stack),
+                                         THREAD_PRIORITY_MAIN - 1,
+                                         THREAD_CREATE_STACKTEST,
+                                         _rcv_thread, NULL, "rcv");
+    if (msg_send_bulk(_msgs, MSG_QUEUE_LENGTH + 1, rcv_pid) !=
+        MSG_QUEUE_LENGTH + 1) {
+        puts("[FAILED] send to receiver");
+        return 1;
+    }
+    if ((_received != MSG_QUEUE_LENGTH + 1) || !_in_order) {
+        puts("[FAILED] receiver");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+    return 0;
+}
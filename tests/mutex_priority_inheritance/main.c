@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test priority inheritance with nested mutexes, waiters that
+ *              time out and mutexes used as signals by xtimer_usleep()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PRIO_MAIN       (THREAD_PRIORITY_MAIN)
+#define PRIO_MEDIUM     (THREAD_PRIORITY_MAIN - 1)
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 2)
+
+#define LOCK_TIMEOUT    (10U * US_PER_MS)
+#define SLEEP_COUNT     (100U)
+#define SLEEP_TIME      (1U * US_PER_MS)
+
+static char _stack_medium[THREAD_STACKSIZE_DEFAULT];
+static char _stack_high[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _m1 = MUTEX_INIT;
+static mutex_t _m2 = MUTEX_INIT;
+
+static volatile int _timed_out;
+
+static void *_lock_unlock(void *arg)
+{
+    mutex_t *mutex = arg;
+
+    mutex_lock(mutex);
+    mutex_unlock(mutex);
+    return NULL;
+}
+
+static void *_lock_timeout(void *arg)
+{
+    mutex_t *mutex = arg;
+
+    if (xtimer_mutex_lock_timeout(mutex, LOCK_TIMEOUT) == 0) {
+        mutex_unlock(mutex);
+    }
+    else {
+        _timed_out = 1;
+    }
+    return NULL;
+}
+
+static void _spawn(char *stack, uint8_t prio, thread_task_func_t func,
+                   mutex_t *mutex)
+{
+    /* the new thread runs right away and blocks on mutex */
+    thread_create(stack, THREAD_STACKSIZE_DEFAULT, prio, THREAD_CREATE_STACKTEST,
+                  func, mutex, "waiter");
+}
+
+static int _check(const char *step, uint8_t expected)
+{
+    uint8_t prio = thread_get(thread_getpid())->priority;
+
+    printf("%s: prio %u\n", step, (unsigned)prio);
+    if (prio != expected) {
+        printf("FAILED: expected prio %u\n", (unsigned)expected);
+        return 0;
+    }
+    return 1;
+}
+
+static int _test_nested_unlock(void)
+{
+    puts("nested mutexes, unlocked in locking order");
+    mutex_lock(&_m1);
+    mutex_lock(&_m2);
+    _spawn(_stack_high, PRIO_HIGH, _lock_unlock, &_m1);
+    if (!_check("high waits for m1", PRIO_HIGH)) {
+        return 0;
+    }
+    /* high still waits for m1, so the boost must stay */
+    mutex_unlock(&_m2);
+    if (!_check("unlocked m2", PRIO_HIGH)) {
+        return 0;
+    }
+    mutex_unlock(&_m1);
+    return _check("unlocked m1", PRIO_MAIN);
+}
+
+static int _test_nested_waiters(void)
+{
+    puts("nested mutexes with a waiter each");
+    mutex_lock(&_m1);
+    mutex_lock(&_m2);
+    _spawn(_stack_medium, PRIO_MEDIUM, _lock_unlock, &_m2);
+    _spawn(_stack_high, PRIO_HIGH, _lock_unlock, &_m1);
+    if (!_check("medium waits for m2, high for m1", PRIO_HIGH)) {
+        return 0;
+    }
+    /* medium still waits for m2 */
+    mutex_unlock(&_m1);
+    if (!_check("unlocked m1", PRIO_MEDIUM)) {
+        return 0;
+    }
+    mutex_unlock(&_m2);
+    return _check("unlocked m2", PRIO_MAIN);
+}
+
+static int _test_timeout(void)
+{
+    puts("waiter times out");
+    mutex_lock(&_m1);
+    _spawn(_stack_high, PRIO_HIGH, _lock_timeout, &_m1);
+    if (!_check("high waits for m1", PRIO_HIGH)) {
+        return 0;
+    }
+    xtimer_usleep(5 * LOCK_TIMEOUT);
+    if (!_timed_out) {
+        puts("FAILED: high did not time out");
+        return 0;
+    }
+    /* main still holds m1, but nobody waits for it anymore */
+    if (!_check("high timed out", PRIO_MAIN)) {
+        return 0;
+    }
+    mutex_unlock(&_m1);
+    return _check("unlocked m1", PRIO_MAIN);
+}
+
+static int _test_sleep(void)
+{
+    puts("repeated xtimer_usleep()");
+    /* xtimer_usleep() blocks on a mutex on its stack that the timer ISR
+     * unlocks, the sleeping thread must not end up owning it */
+    for (unsigned i = 0; i < SLEEP_COUNT; i++) {
+        xtimer_usleep(SLEEP_TIME);
+    }
+    if (thread_get(thread_getpid())->mutexes_held.next != NULL) {
+        puts("FAILED: main still holds a mutex");
+        return 0;
+    }
+    mutex_lock(&_m1);
+    _spawn(_stack_high, PRIO_HIGH, _lock_unlock, &_m1);
+    if (!_check("high waits for m1", PRIO_HIGH)) {
+        return 0;
+    }
+    mutex_unlock(&_m1);
+    return _check("unlocked m1", PRIO_MAIN);
+}
+
+int main(void)
+{
+    puts("Mutex priority inheritance test");
+
+    if (_test_nested_unlock() && _test_nested_waiters() && _test_timeout() &&
+        _test_sleep()) {
+        puts("SUCCESS");
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for native's virtual time
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_HOURS          (24U)
+#define TICKER_PERIOD       (60U * US_PER_SEC)
+
+static char _ticker_stack[THREAD_STACKSIZE_MAIN];
+static unsigned _ticks;
+
+static void *_ticker(void *arg)
+{
+    xtimer_ticks32_t last = xtimer_now();
+
+    (void)arg;
+    while (1) {
+        xtimer_periodic_wakeup(&last, TICKER_PERIOD);
+        _ticks++;
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    uint64_t start = xtimer_now_usec64();
+    uint64_t elapsed;
+
+    thread_create(_ticker_stack, sizeof(_ticker_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _ticker, NULL, "ticker");
+    printf("Sleeping %u hours of virtual time\n", TEST_HOURS);
+    for (unsigned i = 1; i <= TEST_HOURS; i++) {
+        xtimer_sleep(60U * 60U);
+        printf("hour %u: %u ticks\n", i, _ticks);
+    }
+    elapsed = xtimer_now_usec64() - start;
+    printf("elapsed: %" PRIu32 " s\n", (uint32_t)(elapsed / US_PER_SEC));
+    puts((_ticks == TEST_HOURS * 60U) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Sleeping 24 hours of virtual time")
+    for hour in range(1, 25):
+        child.expect_exact("hour {}: {} ticks".format(hour, hour * 60))
+    child.expect(r"elapsed: (\d+) s")
+    assert int(child.match.group(1)) == 24 * 60 * 60
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    # a day of virtual time must pass within the default timeout
+    sys.exit(run(testfunc))
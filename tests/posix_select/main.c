@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Tests for poll() and select() on UDP sockets
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "embUnit.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_PORT           (61616U)
+#define TEST_DELAY          (10U * US_PER_MS)
+#define TEST_TIMEOUT_MS     (1000)
+
+static const char _data[] = "ABCDEFGH";
+static char _sender_stack[THREAD_STACKSIZE_DEFAULT];
+static int _rx[2] = { -1, -1 };
+static int _tx = -1;
+
+static void _addr(struct sockaddr_in6 *addr, uint16_t port)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sin6_family = AF_INET6;
+    addr->sin6_port = htons(port);
+    addr->sin6_addr = in6addr_loopback;
+}
+
+static ssize_t _send(unsigned idx)
+{
+    struct sockaddr_in6 dst;
+
+    _addr(&dst, TEST_PORT + idx);
+    return sendto(_tx, _data, sizeof(_data), 0, (struct sockaddr *)&dst,
+                  sizeof(dst));
+}
+
+static void *_sender(void *arg)
+{
+    (void)arg;
+    xtimer_usleep(TEST_DELAY);
+    _send(0);
+    return NULL;
+}
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < 2; i++) {
+        struct sockaddr_in6 local;
+
+        _addr(&local, TEST_PORT + i);
+        local.sin6_addr = in6addr_any;
+        _rx[i] = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+        bind(_rx[i], (struct sockaddr *)&local, sizeof(local));
+    }
+    _tx = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < 2; i++) {
+        close(_rx[i]);
+        _rx[i] = -1;
+    }
+    if (_tx >= 0) {
+        close(_tx);
+        _tx = -1;
+    }
+}
+
+static void test_poll__timeout(void)
+{
+    struct pollfd pfd = { .fd = _rx[0], .events = POLLIN };
+    uint32_t start = xtimer_now_usec();
+
+    TEST_ASSERT(_rx[0] >= 0);
+    TEST_ASSERT_EQUAL_INT(0, poll(&pfd, 1, 0));
+    TEST_ASSERT_EQUAL_INT(0, poll(&pfd, 1, TEST_DELAY / US_PER_MS));
+    TEST_ASSERT_EQUAL_INT(0, pfd.revents);
+    TEST_ASSERT((xtimer_now_usec() - start) >= TEST_DELAY);
+}
+
+static void test_poll__pollout(void)
+{
+    struct pollfd pfd = { .fd = _rx[0], .events = POLLIN | POLLOUT };
+
+    TEST_ASSERT_EQUAL_INT(1, poll(&pfd, 1, 0));
+    TEST_ASSERT_EQUAL_INT(POLLOUT, pfd.revents);
+}
+
+static void test_poll__pollnval(void)
+{
+    struct pollfd pfd = { .fd = _tx, .events = POLLIN };
+
+    close(_tx);
+    _tx = -1;
+    TEST_ASSERT_EQUAL_INT(1, poll(&pfd, 1, 0));
+    TEST_ASSERT_EQUAL_INT(POLLNVAL, pfd.revents);
+}
+
+static void test_poll__pollin(void)
+{
+    struct pollfd pfd = { .fd = _rx[0], .events = POLLIN };
+    struct sockaddr_in6 src;
+    socklen_t src_len = sizeof(src);
+    char buf[sizeof(_data) + 1];
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_data), _send(0));
+    TEST_ASSERT_EQUAL_INT(1, poll(&pfd, 1, TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_INT(POLLIN, pfd.revents);
+    /* the datagram read ahead by poll() is handed out by recvfrom() */
+    TEST_ASSERT_EQUAL_INT(sizeof(_data), recvfrom(_rx[0], buf, sizeof(buf), 0,
+                                                  (struct sockaddr *)&src,
+                                                  &src_len));
+    TEST_ASSERT_EQUAL_STRING((const char *)_data, (const char *)buf);
+    TEST_ASSERT_EQUAL_INT(AF_INET6, src.sin6_family);
+    TEST_ASSERT(memcmp(&in6addr_loopback, &src.sin6_addr,
+                       sizeof(src.sin6_addr)) == 0);
+    TEST_ASSERT_EQUAL_INT(0, poll(&pfd, 1, 0));
+}
+
+static void test_poll__pollin_empty(void)
+{
+    struct pollfd pfd = { .fd = _rx[0], .events = POLLIN };
+    struct sockaddr_in6 dst;
+    char buf[sizeof(_data)];
+
+    _addr(&dst, TEST_PORT);
+    TEST_ASSERT_EQUAL_INT(0, sendto(_tx, _data, 0, 0, (struct sockaddr *)&dst,
+                                    sizeof(dst)));
+    TEST_ASSERT_EQUAL_INT(1, poll(&pfd, 1, TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_INT(POLLIN, pfd.revents);
+    /* an empty datagram stays pending until recvfrom() hands it out */
+    TEST_ASSERT_EQUAL_INT(1, poll(&pfd, 1, 0));
+    TEST_ASSERT_EQUAL_INT(0, recvfrom(_rx[0], buf, sizeof(buf), 0, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(0, poll(&pfd, 1, 0));
+}
+
+static void test_poll__wakeup(void)
+{
+    struct pollfd pfd[] = {
+        { .fd = _rx[1], .events = POLLIN },
+        { .fd = _rx[0], .events = POLLIN },
+    };
+
+    thread_create(_sender_stack, sizeof(_sender_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _sender, NULL, "sender");
+    /* blocks until the sender thread sent to _rx[0] */
+    TEST_ASSERT_EQUAL_INT(1, poll(pfd, 2, -1));
+    TEST_ASSERT_EQUAL_INT(0, pfd[0].revents);
+    TEST_ASSERT_EQUAL_INT(POLLIN, pfd[1].revents);
+}
+
+static void test_select(void)
+{
+    struct timeval timeout = { .tv_sec = 0, .tv_usec = 0 };
+    fd_set readfds;
+    int nfds = ((_rx[0] > _rx[1]) ? _rx[0] : _rx[1]) + 1;
+
+    FD_ZERO(&readfds);
+    FD_SET(_rx[0], &readfds);
+    FD_SET(_rx[1], &readfds);
+    TEST_ASSERT_EQUAL_INT(0, select(nfds, &readfds, NULL, NULL, &timeout));
+    TEST_ASSERT(!FD_ISSET(_rx[0], &readfds));
+    TEST_ASSERT(!FD_ISSET(_rx[1], &readfds));
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_data), _send(1));
+    FD_SET(_rx[0], &readfds);
+    FD_SET(_rx[1], &readfds);
+    TEST_ASSERT_EQUAL_INT(1, select(nfds, &readfds, NULL, NULL, NULL));
+    TEST_ASSERT(!FD_ISSET(_rx[0], &readfds));
+    TEST_ASSERT(FD_ISSET(_rx[1], &readfds));
+}
+
+static void test_fcntl__nonblock(void)
+{
+    char buf[sizeof(_data)];
+    int flags = fcntl(_rx[0], F_GETFL, 0);
+
+    TEST_ASSERT(flags >= 0);
+    /* the access mode can't be changed */
+    TEST_ASSERT_EQUAL_INT(0, fcntl(_rx[0], F_SETFL, flags | O_NONBLOCK | O_WRONLY));
+    TEST_ASSERT_EQUAL_INT(flags | O_NONBLOCK, fcntl(_rx[0], F_GETFL, 0));
+    TEST_ASSERT_EQUAL_INT(-1, recv(_rx[0], buf, sizeof(buf), 0));
+    TEST_ASSERT_EQUAL_INT(EAGAIN, errno);
+    TEST_ASSERT_EQUAL_INT(0, fcntl(_rx[0], F_SETFL, flags));
+    TEST_ASSERT_EQUAL_INT(flags, fcntl(_rx[0], F_GETFL, 0));
+}
+
+static Test *tests_posix_select(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_poll__timeout),
+        new_TestFixture(test_poll__pollout),
+        new_TestFixture(test_poll__pollnval),
+        new_TestFixture(test_poll__pollin),
+        new_TestFixture(test_poll__pollin_empty),
+        new_TestFixture(test_poll__wakeup),
+        new_TestFixture(test_select),
+        new_TestFixture(test_fcntl__nonblock),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_posix_select());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for round-robin scheduling
+ *
+ * Two threads of the same priority busy loop without ever yielding. Only
+ * with time slicing both of them get to run.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define THREAD_NUMOF        (2U)
+#define TEST_DURATION       (1U)
+
+static char _stacks[THREAD_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t _counters[THREAD_NUMOF];
+
+static void *_busy(void *arg)
+{
+    volatile uint32_t *counter = arg;
+
+    while (1) {
+        (*counter)++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Round-robin scheduling test");
+
+    for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]),
+                      THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                      _busy, (void *)&_counters[i], "busy");
+    }
+
+    xtimer_sleep(TEST_DURATION);
+
+    for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+        printf("thread %u: %" PRIu32 " iterations\n", i, _counters[i]);
+        if (_counters[i] == 0) {
+            puts("[FAILED]");
+            return 1;
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the per-thread stack watermarks
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "thread.h"
+
+#define DEPTH   (512U)
+
+static char stack[THREAD_STACKSIZE_DEFAULT + DEPTH];
+
+static void _deep(void)
+{
+    volatile char buf[DEPTH];
+
+    memset((char *)buf, 0, sizeof(buf));
+    /* get suspended with DEPTH more bytes on the stack */
+    thread_sleep();
+    buf[0]++;
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        _deep();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Stack watermark test");
+
+    kernel_pid_t pid = thread_create(stack, sizeof(stack),
+                                     THREAD_PRIORITY_MAIN - 1, 0,
+                                     _thread, NULL, "deep");
+    thread_t *t = (thread_t *)thread_get(pid);
+
+    uintptr_t before = thread_stack_watermark_free(t);
+    printf("free before: %u\n", (unsigned)before);
+
+    /* wake the thread up once to get it suspended deep in _deep(), and
+     * once more to have it resumed (and thus sampled) from there */
+    thread_wakeup(pid);
+    thread_wakeup(pid);
+
+    uintptr_t after = thread_stack_watermark_free(t);
+    printf("free after: %u\n", (unsigned)after);
+
+    if (before - after >= DEPTH) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE");
+    }
+
+    return 0;
+}
@@ -976,6 +976,39 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing that entries are removed once their lifetime expired
+*/
+static void test_fib_21_expire_entry(void)
+{
+    char addr_dst[] = "Test address211";
+    char addr_nxt[] = "Test address212";
+    char addr_nxt_hop[16];
+    size_t add_buf_size = 16;
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                          (uint8_t *)addr_dst, add_buf_size - 1, 0x123,
+                          (uint8_t *)addr_nxt, add_buf_size - 1, 0x23, 10));
+
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                          (uint8_t *)addr_nxt_hop, &add_buf_size,
+                          &next_hop_flags, (uint8_t *)addr_dst,
+                          sizeof(addr_dst) - 1, 0x123));
+
+    xtimer_usleep(20 * US_PER_MS);
+    add_buf_size = 16;
+
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, fib_get_next_hop(&test_fib_table,
+                          &iface_id, (uint8_t *)addr_nxt_hop, &add_buf_size,
+                          &next_hop_flags, (uint8_t *)addr_dst,
+                          sizeof(addr_dst) - 1, 0x123));
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&test_fib_table));
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1033,7 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_expire_entry),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#include "internal/common.h"
+#include "internal/cc.h"
+#include "internal/pkt.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define SEG_LEN     (100U)
+#define SEG_NUMOF   (4U)
+#define ISS         (999U)
+
+static gnrc_tcp_tcb_t _tcb;
+
+static void set_up(void)
+{
+    xtimer_remove(&_tcb.tim_tout);
+    memset(&_tcb, 0, sizeof(_tcb));
+    gnrc_pktbuf_init();
+
+    _tcb.mss = SEG_LEN;
+    _tcb.iss = ISS;
+    _tcb.snd_una = ISS + 1;
+    _tcb.snd_nxt = ISS + 1;
+    _tcb.srtt = RTO_UNINITIALIZED;
+    _tcb.rtt_var = RTO_UNINITIALIZED;
+    _cc_init(&_tcb);
+
+    /* Fill the retransmission queue with SEG_NUMOF segments in flight */
+    for (unsigned i = 0; i < SEG_NUMOF; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(&_tcb, _tcb.snd_queue_len++);
+        seg->pkt = gnrc_pktbuf_add(NULL, NULL, SEG_LEN, GNRC_NETTYPE_UNDEF);
+        seg->seq = _tcb.snd_nxt;
+        seg->len = SEG_LEN;
+        seg->flags = 0;
+        _tcb.snd_nxt += SEG_LEN;
+    }
+}
+
+static void tear_down(void)
+{
+    xtimer_remove(&_tcb.tim_tout);
+}
+
+static void _ack(uint32_t ack)
+{
+    uint32_t acked = ack - _tcb.snd_una;
+
+    _tcb.snd_una = ack;
+    _pkt_acknowledge(&_tcb, ack);
+    _cc_ack(&_tcb, acked);
+}
+
+static void test_cc_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SEG_LEN, _cc_get_smss(&_tcb));
+    TEST_ASSERT_EQUAL_INT(4 * SEG_LEN, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, _tcb.ssthresh);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT_NOT_NULL(_pkt_get_snd_seg(&_tcb, SEG_NUMOF - 1)->pkt);
+}
+
+/*
+ * Fewer than GNRC_TCP_DUP_ACK_THRESHOLD duplicate ACKs change nothing, the next one triggers
+ * a fast retransmit of the first unacknowledged segment.
+ */
+static void test_cc_dup_ack__fast_retransmit(void)
+{
+    for (unsigned i = 1; i < GNRC_TCP_DUP_ACK_THRESHOLD; ++i) {
+        _cc_dup_ack(&_tcb);
+        TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+        TEST_ASSERT_EQUAL_INT(4 * SEG_LEN, _tcb.cwnd);
+        TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 0)->flags);
+    }
+    _cc_dup_ack(&_tcb);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(2 * SEG_LEN, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(2 * SEG_LEN + GNRC_TCP_DUP_ACK_THRESHOLD * SEG_LEN, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(_tcb.snd_nxt - 1, _tcb.recover);
+    TEST_ASSERT_EQUAL_INT(SEG_RETRANSMITTED, _pkt_get_snd_seg(&_tcb, 0)->flags);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 1)->flags);
+
+    /* Further duplicate ACKs inflate the window */
+    _cc_dup_ack(&_tcb);
+    TEST_ASSERT_EQUAL_INT(2 * SEG_LEN + (GNRC_TCP_DUP_ACK_THRESHOLD + 1) * SEG_LEN, _tcb.cwnd);
+}
+
+/*
+ * Duplicate ACKs for data sent before the last recovery do not start a new one (RFC 6582).
+ */
+static void test_cc_dup_ack__no_reentry(void)
+{
+    _tcb.recover = _tcb.snd_nxt - 1;
+    for (unsigned i = 0; i < GNRC_TCP_DUP_ACK_THRESHOLD; ++i) {
+        _cc_dup_ack(&_tcb);
+    }
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 0)->flags);
+}
+
+/*
+ * A partial ACK retransmits the next segment and stays in fast recovery, the ACK covering
+ * `recover` leaves it with a deflated window.
+ */
+static void test_cc_ack__partial_and_full(void)
+{
+    uint32_t cwnd;
+
+    for (unsigned i = 0; i < GNRC_TCP_DUP_ACK_THRESHOLD; ++i) {
+        _cc_dup_ack(&_tcb);
+    }
+    cwnd = _tcb.cwnd;
+
+    _ack(ISS + 1 + SEG_LEN);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(SEG_NUMOF - 1, _tcb.snd_queue_len);
+    TEST_ASSERT_EQUAL_INT(ISS + 1 + SEG_LEN, _pkt_get_snd_seg(&_tcb, 0)->seq);
+    TEST_ASSERT_EQUAL_INT(SEG_RETRANSMITTED, _pkt_get_snd_seg(&_tcb, 0)->flags);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 1)->flags);
+    TEST_ASSERT_EQUAL_INT(cwnd, _tcb.cwnd);
+
+    _ack(_tcb.snd_nxt);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.snd_queue_len);
+    TEST_ASSERT_EQUAL_INT(2 * SEG_LEN, _tcb.cwnd);
+}
+
+/*
+ * A timeout collapses the window and marks everything but SACKed segments lost.
+ */
+static void test_cc_timeout(void)
+{
+    _pkt_get_snd_seg(&_tcb, 2)->flags = SEG_SACKED;
+    _cc_timeout(&_tcb);
+    TEST_ASSERT_EQUAL_INT(SEG_LEN, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(2 * SEG_LEN, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(SEG_LOST, _pkt_get_snd_seg(&_tcb, 0)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_LOST, _pkt_get_snd_seg(&_tcb, 1)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_SACKED, _pkt_get_snd_seg(&_tcb, 2)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_LOST, _pkt_get_snd_seg(&_tcb, 3)->flags);
+
+    /* The next new ACK resends as many lost segments as the window allows */
+    _ack(ISS + 1 + SEG_LEN);
+    TEST_ASSERT_EQUAL_INT(2 * SEG_LEN, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(SEG_RETRANSMITTED, _pkt_get_snd_seg(&_tcb, 0)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_SACKED, _pkt_get_snd_seg(&_tcb, 1)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_RETRANSMITTED, _pkt_get_snd_seg(&_tcb, 2)->flags);
+}
+
+Test *tests_gnrc_tcp_cc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_cc_init),
+        new_TestFixture(test_cc_dup_ack__fast_retransmit),
+        new_TestFixture(test_cc_dup_ack__no_reentry),
+        new_TestFixture(test_cc_ack__partial_and_full),
+        new_TestFixture(test_cc_timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+/** @} */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/tcp.h"
+
+#include "internal/common.h"
+#include "internal/option.h"
+#include "internal/pkt.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define SEG_LEN     (100U)
+#define SEG_NUMOF   (4U)
+#define SEQ_START   (1000U)
+
+/* Header with room for the largest SACK option, word aligned */
+static uint32_t _hdr_buf[(sizeof(tcp_hdr_t) / 4) + 1 + 2 * OPTION_SACK_BLOCKS_MAX];
+static gnrc_tcp_tcb_t _tcb;
+
+static void set_up(void)
+{
+    memset(&_tcb, 0, sizeof(_tcb));
+    memset(_hdr_buf, 0, sizeof(_hdr_buf));
+    gnrc_pktbuf_init();
+
+    _tcb.status = STATUS_SACK_PERMITTED;
+    _tcb.snd_una = SEQ_START;
+    _tcb.snd_nxt = SEQ_START;
+    for (unsigned i = 0; i < SEG_NUMOF; ++i) {
+        gnrc_tcp_seg_t *seg = _pkt_get_snd_seg(&_tcb, _tcb.snd_queue_len++);
+        seg->pkt = gnrc_pktbuf_add(NULL, NULL, SEG_LEN, GNRC_NETTYPE_UNDEF);
+        seg->seq = _tcb.snd_nxt;
+        seg->len = SEG_LEN;
+        _tcb.snd_nxt += SEG_LEN;
+    }
+}
+
+/* Builds an ACK carrying a SACK option with the given block edges */
+static tcp_hdr_t *_sack_hdr(const uint32_t *edges, unsigned blocks)
+{
+    tcp_hdr_t *hdr = (tcp_hdr_t *)_hdr_buf;
+    uint8_t *opt = (uint8_t *)(hdr + 1);
+    network_uint32_t val;
+
+    hdr->off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN + 1 + 2 * blocks,
+                                                                MSK_ACK));
+    val = byteorder_htonl(_option_build_sack(blocks));
+    memcpy(opt, &val, sizeof(val));
+    opt += sizeof(val);
+    for (unsigned i = 0; i < 2 * blocks; ++i) {
+        val = byteorder_htonl(edges[i]);
+        memcpy(opt, &val, sizeof(val));
+        opt += sizeof(val);
+    }
+    return hdr;
+}
+
+static void test_option_parse__mss(void)
+{
+    tcp_hdr_t *hdr = (tcp_hdr_t *)_hdr_buf;
+    network_uint32_t val = byteorder_htonl(_option_build_mss(536));
+
+    hdr->off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN + 1, MSK_SYN));
+    memcpy(hdr + 1, &val, sizeof(val));
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+    TEST_ASSERT_EQUAL_INT(536, _tcb.mss);
+}
+
+/*
+ * Every block marks the segments it covers completely.
+ */
+static void test_option_parse__sack(void)
+{
+    static const uint32_t edges[] = {
+        SEQ_START + SEG_LEN, SEQ_START + 2 * SEG_LEN,
+        SEQ_START + 3 * SEG_LEN, SEQ_START + 4 * SEG_LEN,
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _sack_hdr(edges, 2)));
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 0)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_SACKED, _pkt_get_snd_seg(&_tcb, 1)->flags);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 2)->flags);
+    TEST_ASSERT_EQUAL_INT(SEG_SACKED, _pkt_get_snd_seg(&_tcb, 3)->flags);
+}
+
+/*
+ * Blocks that cover a segment partially or lie outside of [snd_una, snd_nxt] are ignored.
+ */
+static void test_option_parse__sack_ignored_blocks(void)
+{
+    static const uint32_t edges[] = {
+        SEQ_START + 2 * SEG_LEN, SEQ_START + 2 * SEG_LEN + SEG_LEN / 2,
+        SEQ_START - SEG_LEN, SEQ_START + SEG_LEN,
+        SEQ_START + 3 * SEG_LEN, SEQ_START + 5 * SEG_LEN,
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _sack_hdr(edges, 3)));
+    for (unsigned i = 0; i < SEG_NUMOF; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, i)->flags);
+    }
+}
+
+/*
+ * SACK options are ignored, if SACK was not negotiated.
+ */
+static void test_option_parse__sack_not_permitted(void)
+{
+    static const uint32_t edges[] = { SEQ_START + SEG_LEN, SEQ_START + 2 * SEG_LEN };
+
+    _tcb.status = 0;
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _sack_hdr(edges, 1)));
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 1)->flags);
+}
+
+/*
+ * SACK permitted is only accepted on SYN segments.
+ */
+static void test_option_parse__sack_perm(void)
+{
+    tcp_hdr_t *hdr = (tcp_hdr_t *)_hdr_buf;
+    network_uint32_t val = byteorder_htonl(_option_build_sack_perm());
+
+    _tcb.status = 0;
+    memcpy(hdr + 1, &val, sizeof(val));
+    hdr->off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN + 1, MSK_ACK));
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+    TEST_ASSERT(!(_tcb.status & STATUS_SACK_PERMITTED));
+    hdr->off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN + 1, MSK_SYN));
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+    TEST_ASSERT(_tcb.status & STATUS_SACK_PERMITTED);
+}
+
+/*
+ * Malformed SACK options are rejected without touching the queue.
+ */
+static void test_option_parse__sack_invalid_length(void)
+{
+    static const uint32_t edges[] = { SEQ_START, SEQ_START + SEG_LEN };
+    tcp_hdr_t *hdr = _sack_hdr(edges, 1);
+    uint8_t *len = (uint8_t *)(hdr + 1) + 3;
+
+    *len = 9;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, hdr));
+    /* exceeds the option space */
+    *len = 18;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, hdr));
+    TEST_ASSERT_EQUAL_INT(0, _pkt_get_snd_seg(&_tcb, 0)->flags);
+}
+
+/*
+ * Unknown options with an invalid length must not stall or overrun the parser.
+ */
+static void test_option_parse__unknown_invalid_length(void)
+{
+    tcp_hdr_t *hdr = (tcp_hdr_t *)_hdr_buf;
+    uint8_t *opt = (uint8_t *)(hdr + 1);
+
+    hdr->off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN + 1, MSK_ACK));
+    opt[0] = 0xfe;
+    opt[1] = 0;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, hdr));
+    opt[1] = 5;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, hdr));
+    opt[1] = 4;
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+}
+
+Test *tests_gnrc_tcp_option_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_option_parse__mss),
+        new_TestFixture(test_option_parse__sack),
+        new_TestFixture(test_option_parse__sack_ignored_blocks),
+        new_TestFixture(test_option_parse__sack_not_permitted),
+        new_TestFixture(test_option_parse__sack_perm),
+        new_TestFixture(test_option_parse__sack_invalid_length),
+        new_TestFixture(test_option_parse__unknown_invalid_length),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+/** @} */
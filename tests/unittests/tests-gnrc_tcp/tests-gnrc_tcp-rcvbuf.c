@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "ringbuffer.h"
+
+#include "internal/common.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define RCV_NXT     (100U)
+#define SEG_LEN     (10U)
+
+static gnrc_tcp_tcb_t _tcb;
+
+static void set_up(void)
+{
+    memset(&_tcb, 0, sizeof(_tcb));
+    gnrc_pktbuf_init();
+    _rcvbuf_init();
+    _rcvbuf_get_buffer(&_tcb);
+    _tcb.rcv_nxt = RCV_NXT;
+    _tcb.rcv_wnd = GNRC_TCP_RCV_BUF_SIZE;
+}
+
+static void tear_down(void)
+{
+    _rcvbuf_release_buffer(&_tcb);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/* Builds a segment payload, every byte holds the lower bits of its sequence number */
+static gnrc_pktsnip_t *_seg(uint32_t seq)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, SEG_LEN, GNRC_NETTYPE_UNDEF);
+    uint8_t *data = pkt->data;
+
+    for (unsigned i = 0; i < SEG_LEN; ++i) {
+        data[i] = (uint8_t)(seq + i);
+    }
+    return pkt;
+}
+
+static int _ooo_add(uint32_t seq)
+{
+    gnrc_pktsnip_t *pkt = _seg(seq);
+    int res = _rcvbuf_ooo_add(&_tcb, pkt, seq, SEG_LEN);
+
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static void test_rcvbuf_get_buffer(void)
+{
+    TEST_ASSERT_NOT_NULL(_tcb.rcv_buf_raw);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, ringbuffer_get_free(&_tcb.rcv_buf));
+}
+
+/*
+ * Segments that fill the gap in front of queued out-of-order segments deliver those as well.
+ */
+static void test_rcvbuf_ooo__reassembly(void)
+{
+    uint8_t data[3 * SEG_LEN];
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + 2 * SEG_LEN));
+    TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + SEG_LEN));
+    TEST_ASSERT_EQUAL_INT(RCV_NXT, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_get(&_tcb.rcv_buf, (char *)data, sizeof(data)));
+
+    pkt = _seg(RCV_NXT);
+    _rcvbuf_add(&_tcb, pkt, RCV_NXT);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(RCV_NXT + 3 * SEG_LEN, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), ringbuffer_get(&_tcb.rcv_buf, (char *)data, sizeof(data)));
+    for (unsigned i = 0; i < sizeof(data); ++i) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(RCV_NXT + i), data[i]);
+    }
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        TEST_ASSERT_NULL(_tcb.rcv_ooo[i].pkt);
+    }
+}
+
+/*
+ * Overlapping data is only taken once.
+ */
+static void test_rcvbuf_add__overlap(void)
+{
+    uint8_t data[SEG_LEN + SEG_LEN / 2];
+    gnrc_pktsnip_t *pkt;
+
+    pkt = _seg(RCV_NXT);
+    _rcvbuf_add(&_tcb, pkt, RCV_NXT);
+    gnrc_pktbuf_release(pkt);
+    pkt = _seg(RCV_NXT + SEG_LEN / 2);
+    _rcvbuf_add(&_tcb, pkt, RCV_NXT + SEG_LEN / 2);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(RCV_NXT + sizeof(data), _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), ringbuffer_get(&_tcb.rcv_buf, (char *)data, sizeof(data)));
+    for (unsigned i = 0; i < sizeof(data); ++i) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(RCV_NXT + i), data[i]);
+    }
+}
+
+static void test_rcvbuf_ooo_add__EALREADY(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + SEG_LEN));
+    TEST_ASSERT_EQUAL_INT(-EALREADY, _ooo_add(RCV_NXT + SEG_LEN));
+}
+
+static void test_rcvbuf_ooo_add__ENOSPC(void)
+{
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, _ooo_add(RCV_NXT + GNRC_TCP_RCV_BUF_SIZE));
+}
+
+/*
+ * A full queue only takes segments closer to rcv_nxt, those replace the last one.
+ */
+static void test_rcvbuf_ooo_add__full(void)
+{
+    uint32_t last = RCV_NXT + (GNRC_TCP_RCV_OOO_SIZE + 1) * 2 * SEG_LEN;
+
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, _ooo_add(last - 2 * i * SEG_LEN));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _ooo_add(last + 2 * SEG_LEN));
+    TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + SEG_LEN));
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_SIZE; ++i) {
+        TEST_ASSERT(_tcb.rcv_ooo[i].seq != last);
+    }
+}
+
+#ifdef MODULE_GNRC_TCP_SACK
+/*
+ * Adjacent segments merge into one block, the most recent block comes first.
+ */
+static void test_rcvbuf_get_sack_blocks(void)
+{
+    uint32_t blocks[2 * GNRC_TCP_RCV_OOO_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_sack_blocks(&_tcb, blocks, GNRC_TCP_RCV_OOO_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + 2 * SEG_LEN));
+    TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + SEG_LEN));
+    TEST_ASSERT_EQUAL_INT(1, _rcvbuf_get_sack_blocks(&_tcb, blocks, GNRC_TCP_RCV_OOO_SIZE));
+    TEST_ASSERT_EQUAL_INT(RCV_NXT + SEG_LEN, blocks[0]);
+    TEST_ASSERT_EQUAL_INT(RCV_NXT + 3 * SEG_LEN, blocks[1]);
+
+    if (GNRC_TCP_RCV_OOO_SIZE > 2) {
+        TEST_ASSERT_EQUAL_INT(0, _ooo_add(RCV_NXT + 5 * SEG_LEN));
+        TEST_ASSERT_EQUAL_INT(2, _rcvbuf_get_sack_blocks(&_tcb, blocks, GNRC_TCP_RCV_OOO_SIZE));
+        TEST_ASSERT_EQUAL_INT(RCV_NXT + 5 * SEG_LEN, blocks[0]);
+        TEST_ASSERT_EQUAL_INT(RCV_NXT + SEG_LEN, blocks[2]);
+    }
+}
+#endif
+
+Test *tests_gnrc_tcp_rcvbuf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rcvbuf_get_buffer),
+        new_TestFixture(test_rcvbuf_ooo__reassembly),
+        new_TestFixture(test_rcvbuf_add__overlap),
+        new_TestFixture(test_rcvbuf_ooo_add__EALREADY),
+        new_TestFixture(test_rcvbuf_ooo_add__ENOSPC),
+        new_TestFixture(test_rcvbuf_ooo_add__full),
+#ifdef MODULE_GNRC_TCP_SACK
+        new_TestFixture(test_rcvbuf_get_sack_blocks),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+/** @} */
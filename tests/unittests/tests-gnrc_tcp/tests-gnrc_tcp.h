@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``gnrc_tcp`` module internals
+ */
+#ifndef TESTS_GNRC_TCP_H
+#define TESTS_GNRC_TCP_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_gnrc_tcp(void);
+
+/**
+ * @brief   Generates tests for the congestion control
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_tcp_cc_tests(void);
+
+/**
+ * @brief   Generates tests for the option parser
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_tcp_option_tests(void);
+
+/**
+ * @brief   Generates tests for the receive buffer and out-of-order queue
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_tcp_rcvbuf_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_GNRC_TCP_H */
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,129 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* byte-wise implementation inet_csum_slice() was derived from */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _rand_state = 0x2545f491;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, so the sequence is the same on every platform */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void test_inet_csum__equals_bytewise(void)
+{
+    static uint8_t data[300];
+
+    for (unsigned run = 0; run < 1000; run++) {
+        /* every alignment, length and parity of the accumulated length */
+        unsigned offset = run % 8;
+        uint16_t len = _rand() % (sizeof(data) - offset + 1);
+        size_t accum_len = _rand() % 4;
+        uint16_t sum = _rand();
+        uint8_t fill = (run % 3) ? 0 : 0xff;
+
+        for (unsigned i = 0; i < sizeof(data); i++) {
+            /* mix in runs of 0x00 / 0xff to hit the carry corner cases */
+            data[i] = (_rand() % 4) ? (uint8_t)_rand() : fill;
+        }
+        TEST_ASSERT_EQUAL_INT(_ref_csum_slice(sum, data + offset, len, accum_len),
+                              inet_csum_slice(sum, data + offset, len, accum_len));
+    }
+}
+
+static void test_inet_csum__equals_bytewise_extremes(void)
+{
+    static uint8_t data[1500];
+    static const uint16_t sums[] = { 0x0000, 0x0001, 0xfffe, 0xffff };
+
+    for (unsigned s = 0; s < sizeof(sums) / sizeof(sums[0]); s++) {
+        for (unsigned offset = 0; offset < 4; offset++) {
+            uint16_t len = sizeof(data) - offset;
+
+            memset(data, 0xff, sizeof(data));
+            TEST_ASSERT_EQUAL_INT(_ref_csum_slice(sums[s], data + offset, len, offset),
+                                  inet_csum_slice(sums[s], data + offset, len, offset));
+            memset(data, 0x00, sizeof(data));
+            TEST_ASSERT_EQUAL_INT(_ref_csum_slice(sums[s], data + offset, len, offset),
+                                  inet_csum_slice(sums[s], data + offset, len, offset));
+        }
+    }
+}
+
+static void test_inet_csum__update(void)
+{
+    /* IPv4 header from test_inet_csum__calculate_csum() with checksum 0xb861 */
+    uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0xb8, 0x61, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7,
+    };
+
+    /* decrement TTL: word 0x4011 becomes 0x3f11 */
+    uint16_t csum = inet_csum_update(0xb861, 0x4011, 0x3f11);
+
+    data[8] = 0x3f;
+    data[10] = 0x00;
+    data[11] = 0x00;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)), csum);
+    TEST_ASSERT_EQUAL_INT(0xb961, csum);
+}
+
+static void test_inet_csum__update_buf(void)
+{
+    static uint8_t data[128];
+
+    for (unsigned run = 0; run < 200; run++) {
+        uint8_t old_part[16];
+        uint16_t csum, updated;
+        unsigned offset = (_rand() % ((sizeof(data) - sizeof(old_part)) / 2)) * 2;
+        uint16_t len = 1 + (_rand() % sizeof(old_part));
+
+        for (unsigned i = 0; i < sizeof(data); i++) {
+            data[i] = _rand();
+        }
+        csum = ~inet_csum(0, data, sizeof(data));
+        /* rewrite a field, e.g. an address, at an even offset */
+        memcpy(old_part, data + offset, len);
+        for (unsigned i = 0; i < len; i++) {
+            data[offset + i] = (run & 1) ? _rand() : 0;
+        }
+        updated = inet_csum_update_buf(csum, old_part, data + offset, len);
+        /* 0 and 0xffff are both representations of 0 */
+        TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)) % 0xffff,
+                              updated % 0xffff);
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +300,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__equals_bytewise),
+        new_TestFixture(test_inet_csum__equals_bytewise_extremes),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__update_buf),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
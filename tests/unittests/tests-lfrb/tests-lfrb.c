@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "lfrb.h"
+
+#include "tests-lfrb.h"
+
+#define BUF_SIZE    (8U)
+
+static uint8_t buf[BUF_SIZE];
+static lfrb_t rb;
+static lfrb_mpsc_t mpsc;
+
+static const uint8_t data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+static void set_up(void)
+{
+    memset(buf, 0xff, sizeof(buf));
+    lfrb_init(&rb, buf, sizeof(buf));
+    lfrb_mpsc_init(&mpsc, buf, sizeof(buf));
+}
+
+static void test_lfrb_add_get(void)
+{
+    uint8_t out[BUF_SIZE];
+
+    TEST_ASSERT(lfrb_empty(&rb));
+    TEST_ASSERT_EQUAL_INT(5, lfrb_add(&rb, data, 5));
+    TEST_ASSERT_EQUAL_INT(5, lfrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(3, lfrb_free(&rb));
+    TEST_ASSERT_EQUAL_INT(5, lfrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, 5));
+    TEST_ASSERT(lfrb_empty(&rb));
+}
+
+static void test_lfrb_add_get_wrap(void)
+{
+    uint8_t out[BUF_SIZE];
+
+    lfrb_add(&rb, data, 5);
+    lfrb_drop(&rb, 5);
+    /* write and read across the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, lfrb_add(&rb, data, sizeof(data)));
+    TEST_ASSERT(lfrb_full(&rb));
+    TEST_ASSERT_EQUAL_INT(-1, lfrb_add_one(&rb, 0));
+    TEST_ASSERT_EQUAL_INT(3, lfrb_peek(&rb, out, 3));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, lfrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, lfrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(-1, lfrb_get_one(&rb));
+}
+
+static void test_lfrb_add_get_one(void)
+{
+    for (unsigned i = 0; i < 2 * BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, lfrb_add_one(&rb, data[i % sizeof(data)]));
+        TEST_ASSERT_EQUAL_INT(data[i % sizeof(data)], lfrb_get_one(&rb));
+    }
+}
+
+static void test_lfrb_reserve_commit(void)
+{
+    void *region;
+
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, lfrb_reserve(&rb, &region));
+    TEST_ASSERT(region == buf);
+    memcpy(region, data, 6);
+    lfrb_commit(&rb, 6);
+    TEST_ASSERT_EQUAL_INT(6, lfrb_avail(&rb));
+    lfrb_drop(&rb, 4);
+    /* only the part up to the end of the buffer is contiguous */
+    TEST_ASSERT_EQUAL_INT(2, lfrb_reserve(&rb, &region));
+    TEST_ASSERT(region == &buf[6]);
+    lfrb_commit(&rb, 2);
+    TEST_ASSERT_EQUAL_INT(4, lfrb_reserve(&rb, &region));
+    TEST_ASSERT(region == buf);
+}
+
+static void test_lfrb_peek_region_consume(void)
+{
+    const void *region;
+
+    TEST_ASSERT_EQUAL_INT(0, lfrb_peek_region(&rb, &region));
+    lfrb_add(&rb, data, 6);
+    lfrb_drop(&rb, 4);
+    lfrb_add(&rb, &data[6], 4);
+    TEST_ASSERT_EQUAL_INT(4, lfrb_peek_region(&rb, &region));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, &data[4], 4));
+    lfrb_consume(&rb, 4);
+    TEST_ASSERT_EQUAL_INT(2, lfrb_peek_region(&rb, &region));
+    TEST_ASSERT(region == buf);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, &data[8], 2));
+    lfrb_consume(&rb, 2);
+    TEST_ASSERT(lfrb_empty(&rb));
+}
+
+static void test_lfrb_mpsc_add(void)
+{
+    uint8_t out[BUF_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(5, lfrb_mpsc_add(&mpsc, data, 5));
+    /* writes are added as a whole or not at all */
+    TEST_ASSERT_EQUAL_INT(0, lfrb_mpsc_add(&mpsc, &data[5], 4));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_mpsc_add_one(&mpsc, data[5]));
+    TEST_ASSERT_EQUAL_INT(2, lfrb_mpsc_add(&mpsc, &data[6], 2));
+    TEST_ASSERT_EQUAL_INT(-1, lfrb_mpsc_add_one(&mpsc, 0));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, lfrb_get(&mpsc.rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, BUF_SIZE));
+    /* wrap around */
+    TEST_ASSERT_EQUAL_INT(6, lfrb_mpsc_add(&mpsc, data, 6));
+    TEST_ASSERT_EQUAL_INT(6, lfrb_get(&mpsc.rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, 6));
+}
+
+static void test_lfrb_mpsc_reserve_commit(void)
+{
+    uint8_t out[BUF_SIZE];
+    unsigned pos1, pos2;
+
+    TEST_ASSERT_EQUAL_INT(0, lfrb_mpsc_reserve(&mpsc, 3, &pos1));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_mpsc_reserve(&mpsc, 4, &pos2));
+    TEST_ASSERT_EQUAL_INT(-1, lfrb_mpsc_reserve(&mpsc, 2, &pos2));
+    lfrb_mpsc_write(&mpsc, pos2, &data[3], 2);
+    lfrb_mpsc_write(&mpsc, pos2 + 2, &data[5], 2);
+    /* the second writer finished first, its bytes wait for the first one */
+    lfrb_mpsc_commit(&mpsc, 4);
+    TEST_ASSERT(lfrb_empty(&mpsc.rb));
+    lfrb_mpsc_write(&mpsc, pos1, data, 3);
+    lfrb_mpsc_commit(&mpsc, 3);
+    TEST_ASSERT_EQUAL_INT(7, lfrb_get(&mpsc.rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, 7));
+    /* write across the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(0, lfrb_mpsc_reserve(&mpsc, 5, &pos1));
+    lfrb_mpsc_write(&mpsc, pos1, data, 5);
+    lfrb_mpsc_commit(&mpsc, 5);
+    TEST_ASSERT_EQUAL_INT(5, lfrb_get(&mpsc.rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, 5));
+}
+
+Test *tests_lfrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_lfrb_add_get),
+        new_TestFixture(test_lfrb_add_get_wrap),
+        new_TestFixture(test_lfrb_add_get_one),
+        new_TestFixture(test_lfrb_reserve_commit),
+        new_TestFixture(test_lfrb_peek_region_consume),
+        new_TestFixture(test_lfrb_mpsc_add),
+        new_TestFixture(test_lfrb_mpsc_reserve_commit),
+    };
+
+    EMB_UNIT_TESTCALLER(lfrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&lfrb_tests;
+}
+
+void tests_lfrb(void)
+{
+    TESTS_RUN(tests_lfrb_tests());
+}
+/** @} */
@@ -202,6 +202,7 @@ static void test_pktbuf_add__memfull(void)
 }
 #endif
 
+#ifndef MODULE_GNRC_PKTBUF_SLAB     /* gnrc_pktbuf_slab has few blocks of that size */
 static void test_pktbuf_add__success(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
@@ -225,6 +226,7 @@ static void test_pktbuf_add__success(void)
     }
     TEST_ASSERT(gnrc_pktbuf_is_sane());
 }
+#endif
 
 static void test_pktbuf_add__packed_struct(void)
 {
@@ -245,7 +247,9 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC   /* alignment-handling left to malloc, so no certainty here */
+/* alignment-handling left to malloc, so no certainty here, gnrc_pktbuf_slab
+ * aligns all blocks */
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -655,11 +659,15 @@ static void test_pktbuf_realloc_data__success3(void)
 
 static void test_pktbuf_merge_data__memfull(void)
 {
-    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 4),
-                                          GNRC_NETTYPE_TEST);
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    /* the merged data does not fit into the largest block */
+    const size_t size = GNRC_PKTBUF_SLAB_LARGE_SIZE / 2;
+#else
+    const size_t size = GNRC_PKTBUF_SIZE / 4;
+#endif
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_TEST);
 
-    pkt = gnrc_pktbuf_add(pkt, NULL, (GNRC_PKTBUF_SIZE / 4) + 1,
-                          GNRC_NETTYPE_TEST);
+    pkt = gnrc_pktbuf_add(pkt, NULL, size + 1, GNRC_NETTYPE_TEST);
     TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_merge(pkt));
     gnrc_pktbuf_release(pkt);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -867,8 +875,12 @@ static void test_pktbuf_get_iovec__null(void)
 static void test_pktbuf_reverse_snips__too_full(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_next, *pkt_huge;
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    gnrc_pktsnip_t *tmp;
+#else
     const size_t pkt_huge_size = GNRC_PKTBUF_SIZE - (3 * 8) -
                                  (3 * sizeof(gnrc_pktsnip_t)) - 4;
+#endif
 
     pkt_next = gnrc_pktbuf_add(NULL, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
     TEST_ASSERT_NOT_NULL(pkt_next);
@@ -876,8 +888,16 @@ static void test_pktbuf_reverse_snips__too_full(void)
     gnrc_pktbuf_hold(pkt_next, 1);
     pkt = gnrc_pktbuf_add(pkt_next, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
     TEST_ASSERT_NOT_NULL(pkt);
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    /* taking all remaining packet snips */
+    pkt_huge = NULL;
+    while ((tmp = gnrc_pktbuf_add(pkt_huge, NULL, 0, GNRC_NETTYPE_UNDEF)) != NULL) {
+        pkt_huge = tmp;
+    }
+#else
     /* filling up rest of packet buffer */
     pkt_huge = gnrc_pktbuf_add(NULL, NULL, pkt_huge_size, GNRC_NETTYPE_UNDEF);
+#endif
     TEST_ASSERT_NOT_NULL(pkt_huge);
     TEST_ASSERT_NULL(gnrc_pktbuf_reverse_snips(pkt));
     gnrc_pktbuf_release(pkt_huge);
@@ -915,9 +935,11 @@ Test *tests_pktbuf_tests(void)
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_add__memfull),
 #endif
+#ifndef MODULE_GNRC_PKTBUF_SLAB
         new_TestFixture(test_pktbuf_add__success),
+#endif
         new_TestFixture(test_pktbuf_add__packed_struct),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
 #endif
         new_TestFixture(test_pktbuf_add__0_sized_release),
@@ -44,6 +44,10 @@
 #define MESH_DISP       (0xB3)  /* 10 11 00 11 */
 #define FRAG1_DISP      (0xC5)  /* 11 00 01 01 */
 #define FRAGN_DISP      (0xE5)  /* 11 10 01 01 */
+#define RFRAG_DISP      (0xE8)  /* 11 10 10 00 */
+#define RFRAG_ECN_DISP  (0xE9)  /* 11 10 10 01 */
+#define RFRAG_ACK_DISP  (0xEA)  /* 11 10 10 10 */
+#define IPHC_DISP       (0x7A)  /* 01 11 10 10 */
 
 
 /* Test with 6LoWPAN dispatch byte indicating a none-LoWPAN frame (NALP = Not a
@@ -147,6 +151,57 @@ static void test_sixlowpan_nalp_is_6lowpan_frame_12(void)
     TEST_ASSERT(!sixlowpan_nalp(FRAGN_DISP));
 }
 
+/* Test recoverable fragment dispatches
+ * see https://tools.ietf.org/html/rfc8931#section-5 */
+static void test_sixlowpan_sfr_rfrag_is(void)
+{
+    uint8_t disp[] = { RFRAG_DISP, RFRAG_ECN_DISP };
+
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is(&disp[0]));
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is(&disp[1]));
+    TEST_ASSERT(!sixlowpan_sfr_ack_is(&disp[0]));
+    TEST_ASSERT(sixlowpan_sfr_is(&disp[1]));
+    TEST_ASSERT(!sixlowpan_frag_is((sixlowpan_frag_t *)&disp[0]));
+}
+
+static void test_sixlowpan_sfr_ack_is(void)
+{
+    uint8_t disp = RFRAG_ACK_DISP;
+
+    TEST_ASSERT(sixlowpan_sfr_ack_is(&disp));
+    TEST_ASSERT(!sixlowpan_sfr_rfrag_is(&disp));
+    TEST_ASSERT(sixlowpan_sfr_is(&disp));
+}
+
+static void test_sixlowpan_sfr_is_not(void)
+{
+    uint8_t disp[] = { FRAG1_DISP, FRAGN_DISP, IPv6_DISP, IPHC_DISP };
+
+    for (unsigned i = 0; i < sizeof(disp); i++) {
+        TEST_ASSERT(!sixlowpan_sfr_is(&disp[i]));
+    }
+}
+
+static void test_sixlowpan_sfr_rfrag_set(void)
+{
+    static const uint8_t exp[] = { 0xe8, 0x42, 0xb4, 0x60, 0x01, 0x22 };
+    sixlowpan_sfr_rfrag_t hdr;
+
+    /* ack request, sequence 13, fragment size 96, offset 290 */
+    sixlowpan_sfr_rfrag_set(&hdr, 0x42, 13, 96, 290, true);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp, &hdr, sizeof(exp)));
+    TEST_ASSERT_EQUAL_INT(13, sixlowpan_sfr_rfrag_get_seq(&hdr));
+    TEST_ASSERT_EQUAL_INT(96, sixlowpan_sfr_rfrag_get_size(&hdr));
+    TEST_ASSERT(sixlowpan_sfr_rfrag_ack_req(&hdr));
+    sixlowpan_sfr_rfrag_set(&hdr, 0x42, SIXLOWPAN_SFR_SEQ_MAX,
+                            SIXLOWPAN_SFR_FRAG_SIZE_MAX, 0, false);
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_SFR_SEQ_MAX,
+                          sixlowpan_sfr_rfrag_get_seq(&hdr));
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_SFR_FRAG_SIZE_MAX,
+                          sixlowpan_sfr_rfrag_get_size(&hdr));
+    TEST_ASSERT(!sixlowpan_sfr_rfrag_ack_req(&hdr));
+}
+
 Test *test_sixlowpan_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -170,6 +225,11 @@ Test *test_sixlowpan_tests(void)
         new_TestFixture(test_sixlowpan_nalp_is_6lowpan_frame_10),
         new_TestFixture(test_sixlowpan_nalp_is_6lowpan_frame_11),
         new_TestFixture(test_sixlowpan_nalp_is_6lowpan_frame_12),
+
+        new_TestFixture(test_sixlowpan_sfr_rfrag_is),
+        new_TestFixture(test_sixlowpan_sfr_ack_is),
+        new_TestFixture(test_sixlowpan_sfr_is_not),
+        new_TestFixture(test_sixlowpan_sfr_rfrag_set),
     };
 
     EMB_UNIT_TESTCALLER(test_sixlowpan_tests_caller, NULL, NULL, fixtures);
@@ -42,6 +42,7 @@ static const vfs_file_ops_t null_file_ops = {
     .open  = NULL,
     .read  = NULL,
     .write = NULL,
+    .poll  = NULL,
 };
 
 static const vfs_dir_ops_t null_dir_ops = {
@@ -150,6 +151,16 @@ static void test_vfs_null_file_ops_write(void)
     TEST_ASSERT_EQUAL_INT(-EFAULT, res);
 }
 
+static void test_vfs_null_file_ops_poll(void)
+{
+    TEST_ASSERT(_test_vfs_file_op_my_fd >= 0);
+    /* a file without poll() never blocks */
+    int res = vfs_poll(_test_vfs_file_op_my_fd, 0x5, KERNEL_PID_UNDEF);
+    TEST_ASSERT_EQUAL_INT(0x5, res);
+    res = vfs_poll(-1, 0x5, KERNEL_PID_UNDEF);
+    TEST_ASSERT_EQUAL_INT(-EBADF, res);
+}
+
 Test *tests_vfs_null_file_ops_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -159,6 +170,7 @@ Test *tests_vfs_null_file_ops_tests(void)
         new_TestFixture(test_vfs_null_file_ops_fstat),
         new_TestFixture(test_vfs_null_file_ops_read),
         new_TestFixture(test_vfs_null_file_ops_write),
+        new_TestFixture(test_vfs_null_file_ops_poll),
     };
 
     EMB_UNIT_TESTCALLER(vfs_file_op_tests, setup, teardown, fixtures);
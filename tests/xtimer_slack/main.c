@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_set_slack() test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#define NUMOF       (3U)
+#define TOLERANCE   (2000U)
+
+typedef struct {
+    uint32_t offset;
+    uint32_t slack;
+} window_t;
+
+/* the windows of the second and third timer include the first timer's
+ * target, so all three are fired in one interrupt */
+static const window_t overlapping[NUMOF] = {
+    { .offset = 100000, .slack = 0 },
+    { .offset = 60000, .slack = 50000 },
+    { .offset = 80000, .slack = 50000 },
+};
+
+static const window_t disjoint[NUMOF] = {
+    { .offset = 50000, .slack = 10000 },
+    { .offset = 100000, .slack = 10000 },
+    { .offset = 150000, .slack = 10000 },
+};
+
+static xtimer_t timers[NUMOF];
+static uint32_t fired[NUMOF];
+
+static void _cb(void *arg)
+{
+    fired[(uintptr_t)arg] = xtimer_now_usec();
+}
+
+static int _run(const char *name, const window_t *windows)
+{
+    xtimer_stats_t before, after;
+
+    printf("Setting %u timers with %s windows\n", NUMOF, name);
+    xtimer_get_stats(&before);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < NUMOF; i++) {
+        timers[i].callback = _cb;
+        timers[i].arg = (void *)(uintptr_t)i;
+        xtimer_set_slack(&timers[i], windows[i].offset, windows[i].slack);
+    }
+    xtimer_usleep(200000);
+
+    xtimer_get_stats(&after);
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        uint32_t elapsed = fired[i] - start;
+        if ((elapsed < windows[i].offset) ||
+            (elapsed > windows[i].offset + windows[i].slack + TOLERANCE)) {
+            printf("ERROR: timer %u fired after %" PRIu32 " us\n", i, elapsed);
+            return -1;
+        }
+    }
+    printf("coalesced: %" PRIu32 "\n", after.coalesced - before.coalesced);
+
+    return 0;
+}
+
+int main(void)
+{
+    puts("xtimer_slack test application.");
+
+    if ((_run("overlapping", overlapping) < 0) ||
+        (_run("disjoint", disjoint) < 0)) {
+        return 1;
+    }
+
+    puts("test successful.");
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("xtimer_slack test application.")
+    child.expect_exact("Setting 3 timers with overlapping windows")
+    child.expect_exact("coalesced: 2")
+    child.expect_exact("Setting 3 timers with disjoint windows")
+    child.expect_exact("coalesced: 0")
+    child.expect_exact("test successful.")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))